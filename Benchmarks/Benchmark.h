@@ -0,0 +1,51 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+/**
+ * @brief 效能量測程式的共用工具
+ * 每個量測是一個獨立函式，由 main.cpp 依名稱呼叫，結果以純文字輸出到 stdout。
+ * 量測的是 Core / Widgets 中實際使用的類別，不另外複製一份實作。
+ */
+namespace Bench {
+
+/**
+ * @brief 重複呼叫 fn 至少 minMs 毫秒，回傳每次呼叫的平均奈秒數
+ * 先呼叫一次暖身；每輪呼叫次數逐步加倍，讓很快與很慢的函式都只讀幾次計時器
+ */
+template <typename Fn>
+double nsPerCall(Fn &&fn, qint64 minMs = 300) {
+    fn();
+
+    QElapsedTimer timer;
+    qint64 calls = 0;
+    qint64 batch = 1;
+    timer.start();
+    do {
+        for (qint64 i = 0; i < batch; ++i) fn();
+        calls += batch;
+        if (batch < 4096) batch *= 2;
+    } while (timer.elapsed() < minMs);
+    return double(timer.nsecsElapsed()) / calls;
+}
+
+/** @brief 保留計算結果，避免編譯器把被量測的迴圈整個最佳化掉 */
+inline void keep(double value) {
+    static volatile double sink = 0.0;
+    volatile double *target = &sink;
+    *target = value;
+}
+
+/** --- 各項量測 (回傳 0 代表成功，非 0 代表檢查失敗) --- **/
+
+int scheduler();
+int snapshotBuffer();
+int gorilla();
+int sparkline();
+int procReader();
+
+}
+
+#endif // BENCHMARK_H
@@ -0,0 +1,33 @@
+QT       += core gui widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = benchmarks
+
+# 效能量測程式 (不隨主程式發佈)：
+#   qmake Benchmarks/Benchmarks.pro && make && ./benchmarks all
+# 直接編譯主程式的 Core/ 與被量測的 Widgets/ 原始檔
+
+SOURCES += \
+    main.cpp \
+    GorillaBench.cpp \
+    ProcReaderBench.cpp \
+    SchedulerBench.cpp \
+    SnapshotBufferBench.cpp \
+    SparklineBench.cpp \
+    $$files(../Core/*.cpp) \
+    ../Widgets/SparklineGraph.cpp
+
+HEADERS += \
+    Benchmark.h \
+    $$files(../Core/*.h) \
+    ../Widgets/SparklineGraph.h
+
+INCLUDEPATH += .. ../Core ../Widgets
+
+# GorillaBench 使用的錄製軌跡
+RESOURCES += \
+    traces.qrc
+
+win32: LIBS += -lpdh -lPowrProf -liphlpapi
@@ -0,0 +1,241 @@
+#include "Benchmark.h"
+#include "GorillaBlock.h"
+#include <QFile>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace {
+constexpr int kTraceSeconds = 7 * 24 * 3600;   // 與冷資料層的保存期限相同
+constexpr int kRawBlockPoints = 7200;          // 2 小時的 1 秒取樣
+constexpr int kRollupBlockPoints = 120;        // 與 MetricHistory 的冷資料區塊相同 (2 小時的 1 分鐘時間桶)
+
+struct Point {
+    qint64 timestampMs;
+    float values[GorillaBlock::kMaxChannels];
+};
+
+struct Trace {
+    const char *name;
+    int channels;
+    std::vector<Point> points;
+};
+
+/**
+ * --- 錄製的軌跡 ---
+ * traces/*.csv (編入 traces.qrc)：在實際主機上每秒讀取 /proc/stat 與 /proc/net/dev 約 15 分鐘，
+ * 以與收集執行緒相同的算法換算為使用率與 B/s。每行為 "時間戳(ms),數值"，數值為 float 的精確十進位表示。
+ */
+
+bool recordedTrace(const char *name, const char *resource, Trace &trace) {
+    trace = Trace{name, 1, {}};
+    QFile file(resource);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::printf("%-28s missing %s\n", name, resource);
+        return false;
+    }
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#')) continue;
+        const int comma = line.indexOf(',');
+        bool timeOk = false, valueOk = false;
+        const qint64 timestamp = line.left(comma).toLongLong(&timeOk);
+        const float value = line.mid(comma + 1).toFloat(&valueOk);
+        if (comma < 0 || !timeOk || !valueOk) {
+            std::printf("%-28s bad line in %s\n", name, resource);
+            return false;
+        }
+        trace.points.push_back({timestamp, {value}});
+    }
+    return !trace.points.empty();
+}
+
+/**
+ * --- 合成軌跡 ---
+ * 錄製的軌跡只有十幾分鐘；以下依收集執行緒實際產生數值的方式模擬一週的資料：
+ * 時間戳有幾毫秒的計時抖動，數值是計數器差值除以經過時間，因此不是整齊的小數。
+ */
+
+qint64 nextTimestamp(std::mt19937 &random, qint64 previous) {
+    return previous + 1000 + static_cast<int>(random() % 7) - 3;
+}
+
+// 單一核心使用率：/proc/stat 的 jiffies 差值 (USER_HZ = 100)，負載緩慢漂移並偶爾滿載
+Trace cpuTrace() {
+    std::mt19937 random(1);
+    std::normal_distribution<double> drift(0.0, 0.02);
+    Trace trace{"synthetic cpu core %, 1 s", 1, {}};
+    trace.points.reserve(kTraceSeconds);
+    qint64 timestamp = 1700000000000LL;
+    double load = 0.1;
+    for (int i = 0; i < kTraceSeconds; ++i) {
+        const qint64 next = nextTimestamp(random, timestamp);
+        load = qBound(0.0, load + drift(random) + (0.1 - load) * 0.01, 1.0);
+        if (random() % 600 == 0) load = 1.0;
+        const int total = static_cast<int>((next - timestamp) / 10);
+        std::binomial_distribution<int> busy(total, load);
+        trace.points.push_back({next, {busy(random) * 100.0f / total}});
+        timestamp = next;
+    }
+    return trace;
+}
+
+// 網路接收速度：閒置時只有零星封包，偶爾有數 MB/s 的下載
+Trace networkTrace() {
+    std::mt19937 random(2);
+    Trace trace{"synthetic net recv B/s, 1 s", 1, {}};
+    trace.points.reserve(kTraceSeconds);
+    qint64 timestamp = 1700000000000LL;
+    int burstLeft = 0;
+    for (int i = 0; i < kTraceSeconds; ++i) {
+        const qint64 next = nextTimestamp(random, timestamp);
+        quint64 bytes = 0;
+        if (burstLeft > 0) {
+            --burstLeft;
+            bytes = 2000000 + random() % 8000000;
+        } else if (random() % 3600 == 0) {
+            burstLeft = 30 + random() % 300;
+        } else if (random() % 4 == 0) {
+            bytes = 66 * (1 + random() % 20);
+        }
+        trace.points.push_back({next, {static_cast<float>(bytes * 1000.0 / (next - timestamp))}});
+        timestamp = next;
+    }
+    return trace;
+}
+
+// 冷資料層實際保存的內容：每分鐘一筆 min/avg/max
+Trace rollup(const char *name, const Trace &source) {
+    Trace trace{name, 3, {}};
+    qint64 minute = -1;
+    float lo = 0.0f, hi = 0.0f;
+    double sum = 0.0;
+    int count = 0;
+    auto flush = [&]() {
+        if (count > 0) trace.points.push_back({minute * 60000, {lo, static_cast<float>(sum / count), hi}});
+    };
+    for (const Point &point : source.points) {
+        const qint64 bucket = point.timestampMs / 60000;
+        if (bucket != minute) {
+            flush();
+            minute = bucket;
+            lo = hi = point.values[0];
+            sum = 0.0;
+            count = 0;
+        }
+        lo = qMin(lo, point.values[0]);
+        hi = qMax(hi, point.values[0]);
+        sum += point.values[0];
+        ++count;
+    }
+    flush();
+    return trace;
+}
+
+/** --- 編碼與驗證 --- **/
+
+std::vector<GorillaBlock> encode(const Trace &trace, int blockPoints) {
+    std::vector<GorillaBlock> blocks;
+    for (const Point &point : trace.points) {
+        if (blocks.empty() || blocks.back().count() >= blockPoints) {
+            if (!blocks.empty()) blocks.back().seal();
+            blocks.emplace_back(trace.channels);
+        }
+        blocks.back().append(point.timestampMs, point.values);
+    }
+    if (!blocks.empty()) blocks.back().seal();
+    return blocks;
+}
+
+// 逐位元比對 (NaN 與 -0 也必須原樣還原)
+bool roundTrip(const Trace &trace, const std::vector<GorillaBlock> &blocks) {
+    size_t index = 0;
+    for (const GorillaBlock &block : blocks) {
+        GorillaBlock::Reader reader = block.reader();
+        qint64 timestamp;
+        float values[GorillaBlock::kMaxChannels];
+        while (reader.next(timestamp, values)) {
+            if (index >= trace.points.size()) return false;
+            const Point &expected = trace.points[index++];
+            if (timestamp != expected.timestampMs) return false;
+            if (std::memcmp(values, expected.values, sizeof(float) * trace.channels) != 0) return false;
+        }
+    }
+    return index == trace.points.size();
+}
+
+bool measure(const Trace &trace, int blockPoints) {
+    std::vector<GorillaBlock> blocks;
+    const double encodeNs = Bench::nsPerCall([&]() { blocks = encode(trace, blockPoints); });
+    if (!roundTrip(trace, blocks)) {
+        std::printf("%-28s round trip MISMATCH\n", trace.name);
+        return false;
+    }
+
+    size_t bytes = 0;
+    for (const GorillaBlock &block : blocks) bytes += block.sizeBytes();
+
+    double sink = 0.0;
+    const double decodeNs = Bench::nsPerCall([&]() {
+        for (const GorillaBlock &block : blocks) {
+            GorillaBlock::Reader reader = block.reader();
+            qint64 timestamp;
+            float values[GorillaBlock::kMaxChannels];
+            while (reader.next(timestamp, values)) sink += values[0];
+        }
+    });
+
+    const double samples = double(trace.points.size());
+    const int rawBytes = 8 + 4 * trace.channels;
+    Bench::keep(sink);
+    std::printf("%-28s %6.2f B/sample (raw %2d)  encode %6.1f M/s  decode %6.1f M/s  (%zu samples)\n", trace.name,
+                bytes / samples, rawBytes, samples / encodeNs * 1e3, samples / decodeNs * 1e3, trace.points.size());
+    return true;
+}
+
+// 邊界值：NaN、無限大、-0、負的時間戳與超過 32 位元的時間間隔
+bool edgeCases() {
+    Trace trace{"edge cases", 2, {}};
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    trace.points.push_back({-5, {nan, -0.0f}});
+    trace.points.push_back({3000000000LL, {1e30f, inf}});
+    trace.points.push_back({3000000001LL, {0.0f, -inf}});
+    trace.points.push_back({3000000001LL + (1LL << 40), {std::numeric_limits<float>::denorm_min(), 1.0f}});
+    const bool ok = roundTrip(trace, encode(trace, kRawBlockPoints));
+    std::printf("%-28s round trip %s\n", trace.name, ok ? "ok" : "MISMATCH");
+    return ok;
+}
+}
+
+int Bench::gorilla() {
+    bool ok = true;
+
+    // 主要結果：實際錄製的資料
+    Trace recordedCpu, recordedLoopback;
+    ok &= recordedTrace("recorded cpu %, 1 s", ":/traces/cpu.csv", recordedCpu);
+    ok &= recordedTrace("recorded lo recv B/s, 1 s", ":/traces/net_lo_recv.csv", recordedLoopback);
+    if (ok) {
+        std::printf("recorded 1 s samples, %d-point blocks:\n", kRawBlockPoints);
+        ok &= measure(recordedCpu, kRawBlockPoints);
+        ok &= measure(recordedLoopback, kRawBlockPoints);
+        std::printf("recorded, cold tier (1 min min/avg/max), %d-point blocks:\n", kRollupBlockPoints);
+        ok &= measure(rollup("recorded cpu %, 1 min", recordedCpu), kRollupBlockPoints);
+        ok &= measure(rollup("recorded lo recv B/s, 1 min", recordedLoopback), kRollupBlockPoints);
+    }
+
+    // 額外參考：合成的一週資料 (錄製的軌跡不足以填滿冷資料層)
+    const Trace cpu = cpuTrace();
+    const Trace network = networkTrace();
+    std::printf("synthetic week, 1 s samples, %d-point blocks:\n", kRawBlockPoints);
+    ok &= measure(cpu, kRawBlockPoints);
+    ok &= measure(network, kRawBlockPoints);
+    std::printf("synthetic week, cold tier (1 min min/avg/max), %d-point blocks:\n", kRollupBlockPoints);
+    ok &= measure(rollup("synthetic cpu core %, 1 min", cpu), kRollupBlockPoints);
+    ok &= measure(rollup("synthetic net B/s, 1 min", network), kRollupBlockPoints);
+    ok &= edgeCases();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+#include "Benchmark.h"
+#include <cstdio>
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <iterator>
+
+namespace {
+const ProcKeyTable::Key kMemKeys[] = {
+    {"MemTotal", 0}, {"MemAvailable", 1}, {"Buffers", 2}, {"Cached", 3},
+    {"Dirty", 4}, {"Writeback", 5}, {"Slab", 6}, {"Shmem", 7},
+    {"SwapTotal", 8}, {"SwapFree", 9},
+};
+constexpr int kMemKeyCount = static_cast<int>(std::size(kMemKeys));
+
+/**
+ * --- 對照組 ---
+ * 收集執行緒原本在 Windows 以外的寫法：每次開檔、readAll、依行與空白切成獨立的 QByteArray
+ */
+
+QList<QByteArray> readLines(const char *path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) return QList<QByteArray>();
+    return file.readAll().split('\n');
+}
+
+// 把所有整數欄位加總 (/proc/stat、/proc/net/dev、/proc/diskstats)
+quint64 sumFieldsQFile(const char *path) {
+    quint64 sum = 0;
+    for (const QByteArray &line : readLines(path)) {
+        for (const QByteArray &field : line.simplified().split(' ')) {
+            bool ok;
+            const quint64 value = field.toULongLong(&ok);
+            if (ok) sum += value;
+        }
+    }
+    return sum;
+}
+
+int memInfoQFile(quint64 *values) {
+    int found = 0;
+    for (const QByteArray &line : readLines("/proc/meminfo")) {
+        const int separator = line.indexOf(':');
+        if (separator < 0) continue;
+        const QByteArray name = line.left(separator);
+        for (const ProcKeyTable::Key &key : kMemKeys) {
+            if (name != QByteArray(key.name.data(), static_cast<int>(key.name.size()))) continue;
+            values[key.slot] = line.mid(separator + 1).simplified().split(' ').first().toULongLong();
+            ++found;
+            break;
+        }
+    }
+    return found;
+}
+
+double loadAvgQFile() {
+    const QList<QByteArray> lines = readLines("/proc/loadavg");
+    if (lines.isEmpty()) return 0.0;
+    const QList<QByteArray> fields = lines.first().split(' ');
+    double sum = 0.0;
+    for (int i = 0; i < 3 && i < fields.size(); ++i) sum += fields[i].toDouble();
+    return sum;
+}
+
+/** --- ProcFile + 就地解析 --- **/
+
+quint64 sumFields(ProcFile &file) {
+    std::string_view content = file.read();
+    std::string_view line, token;
+    quint64 sum = 0;
+    while (ProcText::nextLine(content, line)) {
+        while (ProcText::nextToken(line, token)) {
+            quint64 value;
+            if (ProcText::toU64(token, value)) sum += value;
+        }
+    }
+    return sum;
+}
+
+double loadAvg(ProcFile &file) {
+    std::string_view content = file.read();
+    std::string_view token;
+    double sum = 0.0;
+    for (int i = 0; i < 3 && ProcText::nextToken(content, token); ++i) {
+        double value;
+        if (ProcText::toDouble(token, value)) sum += value;
+    }
+    return sum;
+}
+
+/** --- 量測 --- **/
+
+bool compare(const char *path) {
+    ProcFile file(path);
+    if (!file.isOpen()) {
+        std::printf("%-16s not available\n", path);
+        return true;
+    }
+    quint64 sink = 0;
+    const double fastNs = Bench::nsPerCall([&]() { sink += sumFields(file); });
+    const double qfileNs = Bench::nsPerCall([&]() { sink += sumFieldsQFile(path); });
+    Bench::keep(double(sink));
+    std::printf("%-16s ProcFile %7.2f us   QFile::readAll + split %7.2f us   (x%.1f)\n", path, fastNs / 1000.0,
+                qfileNs / 1000.0, qfileNs / fastNs);
+    return true;
+}
+
+bool compareMemInfo() {
+    ProcFile file("/proc/meminfo");
+    ProcKeyTable table(kMemKeys, std::size(kMemKeys), ':');
+    quint64 fast[kMemKeyCount] = {};
+    quint64 slow[kMemKeyCount] = {};
+    int found = 0;
+    const double fastNs = Bench::nsPerCall([&]() { found = table.parse(file.read(), fast); });
+    const double qfileNs = Bench::nsPerCall([&]() { memInfoQFile(slow); });
+    std::printf("%-16s ProcFile %7.2f us   QFile::readAll + split %7.2f us   (x%.1f)\n", "/proc/meminfo",
+                fastNs / 1000.0, qfileNs / 1000.0, qfileNs / fastNs);
+
+    // MemTotal 不會變動，兩種解析結果必須一致
+    return found > 0 && fast[0] != 0 && fast[0] == slow[0];
+}
+
+bool compareLoadAvg() {
+    ProcFile file("/proc/loadavg");
+    double sink = 0.0;
+    const double fastNs = Bench::nsPerCall([&]() { sink += loadAvg(file); });
+    const double qfileNs = Bench::nsPerCall([&]() { sink += loadAvgQFile(); });
+    Bench::keep(sink);
+    std::printf("%-16s ProcFile %7.2f us   QFile::readAll + split %7.2f us   (x%.1f)\n", "/proc/loadavg",
+                fastNs / 1000.0, qfileNs / 1000.0, qfileNs / fastNs);
+    return true;
+}
+
+/**
+ * --- ProcKeyTable 版面檢查 ---
+ * 包含沒有分隔字元的行 (標題列、空行)，並在記錄版面後插入、移除行，
+ * 以及需要的鍵出現在原本記錄為「不需要」的行；每次解析都必須取得正確的值。
+ */
+bool keyTableLayout() {
+    const ProcKeyTable::Key keys[] = {{"MemTotal", 0}, {"Cached", 1}, {"SwapFree", 2}};
+    const struct {
+        const char *content;
+        int found;
+        quint64 expected[3];
+    } cases[] = {
+        {"header\nMemTotal: 100 kB\n\nMemFree: 50 kB\nCached: 7 kB\nSwapFree: 3 kB\n", 3, {100, 7, 3}},
+        {"header\nMemTotal: 101 kB\n\nMemFree: 51 kB\nCached: 8 kB\nSwapFree: 4 kB\n", 3, {101, 8, 4}},
+        {"header\nextra header\nMemTotal: 102 kB\n\nNew: 1 kB\nMemFree: 52 kB\nCached: 9 kB\nSwapFree: 5 kB\n", 3, {102, 9, 5}},
+        {"MemTotal: 103 kB\nCached: 10 kB\n\n\n\n\nSwapFree: 6 kB", 3, {103, 10, 6}},
+        {"MemTotal: 104 kB\nCached: 11 kB\n\n\n\n\nSwapFree: 7 kB", 3, {104, 11, 7}},
+        {"MemTotal: 105 kB\nFoo: 1 kB\nBar: 2 kB\n", 1, {105, 0, 0}},
+        {"MemTotal: 106 kB\nCached: 12 kB\nSwapFree: 8 kB\n", 3, {106, 12, 8}},
+    };
+
+    ProcKeyTable table(keys, std::size(keys), ':');
+    bool ok = true;
+    for (const auto &test : cases) {
+        quint64 values[3] = {};
+        const int found = table.parse(test.content, values);
+        ok &= found == test.found && values[0] == test.expected[0] && values[1] == test.expected[1] &&
+              values[2] == test.expected[2];
+    }
+    std::printf("%-16s %s\n", "ProcKeyTable", ok ? "layout changes ok" : "layout changes MISMATCH");
+    return ok;
+}
+}
+
+int Bench::procReader() {
+    bool ok = keyTableLayout();
+    ok &= compare("/proc/stat");
+    ok &= compareMemInfo();
+    ok &= compare("/proc/net/dev");
+    ok &= compare("/proc/diskstats");
+    ok &= compareLoadAvg();
+    return ok ? 0 : 1;
+}
+
+#else
+
+int Bench::procReader() {
+    std::printf("ProcFile is Linux only\n");
+    return 0;
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,126 @@
+#include "Benchmark.h"
+#include "SampleScheduler.h"
+#include <QAbstractEventDispatcher>
+#include <QEventLoop>
+#include <QRandomGenerator>
+#include <QTimer>
+#include <cstdio>
+#include <vector>
+
+namespace {
+// 所有小工具都開啟且啟用懸停隱藏時的週期性工作，與改用排程器前各自持有的 QTimer 一一對應
+struct Job {
+    const char *name;
+    int intervalMs;
+    int copies;
+};
+const Job kJobs[] = {
+    {"cpu", 1000, 1},
+    {"disk", 2000, 1},
+    {"network", 1000, 1},
+    {"ping", 3000, 1},
+    {"clock", 1000, 1},
+    {"latency", 1000, 1},
+    {"history", 1000, 1},
+    {"hover", 100, 9},   // BaseComponent 的懸停輪詢，每個小工具一個
+};
+constexpr int kRunMs = 10000;
+
+struct Task {
+    int intervalMs;
+    int phaseMs;
+};
+
+std::vector<Task> makeTasks() {
+    // 小工具在不同時間建立，相位彼此不對齊；固定亂數種子讓兩種模式使用相同的相位
+    QRandomGenerator random(11401);
+    std::vector<Task> tasks;
+    for (const Job &job : kJobs) {
+        for (int i = 0; i < job.copies; ++i) {
+            tasks.push_back({job.intervalMs, static_cast<int>(random.bounded(job.intervalMs))});
+        }
+    }
+    return tasks;
+}
+
+// 事件迴圈從等待中被喚醒的次數 (兩種模式以相同方式計算)
+class WakeupCounter
+{
+public:
+    WakeupCounter() {
+        m_connection = QObject::connect(QAbstractEventDispatcher::instance(), &QAbstractEventDispatcher::awake,
+                                        [this]() { ++m_count; });
+    }
+    ~WakeupCounter() { QObject::disconnect(m_connection); }
+    qint64 count() const { return m_count; }
+
+private:
+    QMetaObject::Connection m_connection;
+    qint64 m_count = 0;
+};
+
+void runEventLoop(int ms) {
+    QEventLoop loop;
+    QTimer::singleShot(ms, &loop, &QEventLoop::quit);
+    loop.exec();
+}
+
+/** --- 改用排程器前：每個工作一個 QTimer --- **/
+
+double runWithTimers(const std::vector<Task> &tasks, qint64 &runs) {
+    QObject owner;
+    for (const Task &task : tasks) {
+        QTimer *timer = new QTimer(&owner);
+        timer->setInterval(task.intervalMs);
+        QObject::connect(timer, &QTimer::timeout, &owner, [&runs]() { ++runs; });
+        QTimer::singleShot(task.phaseMs, timer, [timer, &runs]() {
+            ++runs;
+            timer->start();
+        });
+    }
+
+    WakeupCounter wakeups;
+    runEventLoop(kRunMs);
+    return wakeups.count() * 1000.0 / kRunMs;
+}
+
+/** --- SampleScheduler：同一組工作與相位 --- **/
+
+double runWithScheduler(const std::vector<Task> &tasks, qint64 &runs, double &selfReported) {
+    // 排程器在這裡第一次建立，wakeupsPerSecond() 的平均範圍與量測期間一致
+    SampleScheduler *scheduler = SampleScheduler::instance();
+    QObject owner;
+    for (const Task &task : tasks) {
+        const int id = scheduler->addTask(&owner, task.intervalMs, [&runs]() { ++runs; });
+        scheduler->rescheduleIn(id, task.phaseMs);
+    }
+
+    WakeupCounter wakeups;
+    runEventLoop(kRunMs);
+    selfReported = scheduler->wakeupsPerSecond();
+    return wakeups.count() * 1000.0 / kRunMs;
+}
+}
+
+int Bench::scheduler() {
+    const std::vector<Task> tasks = makeTasks();
+    std::printf("%zu periodic tasks, %d s per mode\n", tasks.size(), kRunMs / 1000);
+
+    qint64 timerRuns = 0;
+    const double timerWakeups = runWithTimers(tasks, timerRuns);
+    std::printf("one QTimer per task: %6.1f wakeups/s  (%lld task runs)\n", timerWakeups,
+                static_cast<long long>(timerRuns));
+
+    qint64 schedulerRuns = 0;
+    double selfReported = 0.0;
+    const double schedulerWakeups = runWithScheduler(tasks, schedulerRuns, selfReported);
+    std::printf("SampleScheduler:     %6.1f wakeups/s  (%lld task runs, wakeupsPerSecond() %.1f)\n",
+                schedulerWakeups, static_cast<long long>(schedulerRuns), selfReported);
+
+    // 合併只能移動執行時間，不能少執行：兩種模式的執行次數應相差不到 5%
+    if (schedulerRuns < timerRuns * 95 / 100) {
+        std::printf("scheduler dropped task runs\n");
+        return 1;
+    }
+    return 0;
+}
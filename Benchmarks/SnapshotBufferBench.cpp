@@ -0,0 +1,170 @@
+#include "Benchmark.h"
+#include "SnapshotBuffer.h"
+#include "SystemSnapshot.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+namespace {
+constexpr int kRunMs = 1000;
+
+// 在快照頭尾寫入相同的序號，讀端比對兩者即可發現讀到一半被覆寫的資料
+void stamp(SystemSnapshot &snap, quint64 seq) {
+    snap.sequence = seq;
+    snap.memoryTop.top[SnapshotLimits::kMaxTopProcesses - 1].pssBytes = seq;
+}
+
+bool torn(const SystemSnapshot &snap) {
+    return snap.sequence != snap.memoryTop.top[SnapshotLimits::kMaxTopProcesses - 1].pssBytes;
+}
+
+struct Contention {
+    double publishNs = 0.0;
+    double readNs = 0.0;
+    quint64 publishes = 0;
+    quint64 reads = 0;
+    quint64 tornReads = 0;
+    quint64 staleReads = 0;   // 序號比前一次讀到的小
+};
+
+/**
+ * @brief 生產者執行緒持續發布 kRunMs 毫秒，同時在本執行緒持續讀取
+ * publish(seq) 發布一份序號為 seq 的快照；read() 回傳讀到的快照 (沒有資料時為 nullptr)
+ */
+template <typename Publish, typename Read>
+Contention contend(Publish publish, Read read) {
+    Contention result;
+    std::atomic<bool> done{false};
+
+    std::thread producer([&]() {
+        QElapsedTimer timer;
+        timer.start();
+        quint64 seq = 0;
+        while (timer.elapsed() < kRunMs) publish(++seq);
+        result.publishNs = double(timer.nsecsElapsed()) / seq;
+        result.publishes = seq;
+        done.store(true, std::memory_order_release);
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    quint64 last = 0;
+    while (!done.load(std::memory_order_acquire)) {
+        const SystemSnapshot *snap = read();
+        ++result.reads;
+        if (!snap) continue;
+        if (torn(*snap)) ++result.tornReads;
+        if (snap->sequence < last) ++result.staleReads;
+        last = snap->sequence;
+    }
+    result.readNs = double(timer.nsecsElapsed()) / qMax<quint64>(1, result.reads);
+    producer.join();
+    return result;
+}
+
+bool report(const char *name, const Contention &result) {
+    std::printf("%-28s publish %8.1f ns  read %7.1f ns  (%llu publishes, %llu reads, %llu torn, %llu stale)\n", name,
+                result.publishNs, result.readNs, static_cast<unsigned long long>(result.publishes),
+                static_cast<unsigned long long>(result.reads), static_cast<unsigned long long>(result.tornReads),
+                static_cast<unsigned long long>(result.staleReads));
+    return result.tornReads == 0 && result.staleReads == 0;
+}
+
+/** --- 最新快照 --- **/
+
+bool benchLatest() {
+    std::printf("SystemSnapshot: %zu bytes\n", sizeof(SystemSnapshot));
+    bool ok = true;
+
+    {
+        // SystemCollector 的做法：取樣寫入 m_working，發布時整份複製到 back 區
+        auto buffer = std::make_unique<TripleBuffer<SystemSnapshot>>();
+        auto working = std::make_unique<SystemSnapshot>();
+        ok &= report("TripleBuffer, copy + publish", contend(
+            [&](quint64 seq) {
+                stamp(*working, seq);
+                buffer->writeBuffer() = *working;
+                buffer->publish();
+            },
+            [&]() { return buffer->read(); }));
+    }
+    {
+        // 直接寫入 back 區：只有交換本身的成本
+        auto buffer = std::make_unique<TripleBuffer<SystemSnapshot>>();
+        ok &= report("TripleBuffer, in place", contend(
+            [&](quint64 seq) {
+                stamp(buffer->writeBuffer(), seq);
+                buffer->publish();
+            },
+            [&]() { return buffer->read(); }));
+    }
+    {
+        // 對照：以互斥鎖保護共用快照，兩端各複製一份
+        QMutex mutex;
+        auto shared = std::make_unique<SystemSnapshot>();
+        auto working = std::make_unique<SystemSnapshot>();
+        auto local = std::make_unique<SystemSnapshot>();
+        ok &= report("QMutex + copy both ends", contend(
+            [&](quint64 seq) {
+                stamp(*working, seq);
+                QMutexLocker locker(&mutex);
+                *shared = *working;
+            },
+            [&]() {
+                QMutexLocker locker(&mutex);
+                *local = *shared;
+                return local.get();
+            }));
+    }
+    return ok;
+}
+
+/** --- 歷史取樣點 --- **/
+
+bool benchHistory() {
+    // 生產者在佇列滿、消費者在佇列空時讓出 CPU (不丟棄)，量測兩端同時運作時每筆的平均傳遞時間
+    constexpr quint64 kPoints = 20000000;
+    auto ring = std::make_unique<SpscRing<MetricPoint, 16384>>();
+    quint64 fullRetries = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+    std::thread producer([&]() {
+        for (quint64 i = 0; i < kPoints;) {
+            if (ring->push(MetricPoint{static_cast<qint64>(i), MetricPoint::CpuCore, 0, 0.0f})) {
+                ++i;
+            } else {
+                ++fullRetries;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    quint64 received = 0;
+    quint64 outOfOrder = 0;
+    while (received < kPoints) {
+        const size_t drained = ring->drain([&](const MetricPoint &point) {
+            if (point.timestampMs != static_cast<qint64>(received)) ++outOfOrder;
+            ++received;
+        });
+        if (drained == 0) std::this_thread::yield();
+    }
+    const double pointNs = double(timer.nsecsElapsed()) / kPoints;
+    producer.join();
+
+    // 佇列滿時 push 失敗會計入 dropped()，這裡的重試次數與它一致
+    std::printf("SpscRing<MetricPoint, 16384>  %6.1f ns/point  (%llu points, %llu full, %llu out of order)\n", pointNs,
+                static_cast<unsigned long long>(received), static_cast<unsigned long long>(fullRetries),
+                static_cast<unsigned long long>(outOfOrder));
+    return outOfOrder == 0 && ring->dropped() == fullRetries;
+}
+}
+
+int Bench::snapshotBuffer() {
+    const bool latest = benchLatest();
+    const bool history = benchHistory();
+    return latest && history ? 0 : 1;
+}
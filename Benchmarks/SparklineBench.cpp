@@ -0,0 +1,104 @@
+#include "Benchmark.h"
+#include "SparklineGraph.h"
+#include "MinMaxDecimator.h"
+#include <QApplication>
+#include <QPainter>
+#include <QPolygonF>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+constexpr int kSamples = 3600;   // 1 小時的 1 秒取樣
+constexpr int kWidth = 150;
+constexpr int kHeight = 30;
+constexpr qint64 kMeasureMs = 1000;
+
+// 對照組：每次繪製都把視窗內所有取樣畫成一條折線
+class NaivePolylineGraph : public QWidget
+{
+public:
+    explicit NaivePolylineGraph(int capacity) : m_samples(capacity, 0.0f) {}
+
+    void appendSample(float value) {
+        m_samples[m_head] = value;
+        m_head = (m_head + 1) % static_cast<int>(m_samples.size());
+        update();
+    }
+
+protected:
+    void paintEvent(QPaintEvent *event) override {
+        Q_UNUSED(event);
+        const int count = static_cast<int>(m_samples.size());
+        const qreal step = qreal(width() - 1) / (count - 1);
+        const qreal bottom = height() - 1;
+
+        QPolygonF line;
+        line.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            const float value = m_samples[(m_head + i) % count];
+            line << QPointF(i * step, bottom - qBound(0.0f, value / 100.0f, 1.0f) * bottom);
+        }
+
+        QPainter painter(this);
+        painter.setPen(QPen(QColor(120, 200, 255), 1));
+        painter.drawPolyline(line);
+    }
+
+private:
+    std::vector<float> m_samples;
+    int m_head = 0;
+};
+
+// CPU 使用率形狀的取樣：緩慢起伏加上雜訊
+float sampleAt(int i) {
+    return 40.0f + 30.0f * std::sin(i * 0.01f) + 20.0f * std::sin(i * 1.7f) * std::sin(i * 0.37f);
+}
+
+template <typename Widget>
+void prepare(Widget &widget) {
+    widget.resize(kWidth, kHeight);
+    widget.show();
+    for (int i = 0; i < kSamples; ++i) widget.appendSample(sampleAt(i));
+    QApplication::processEvents();
+    widget.repaint();
+}
+}
+
+int Bench::sparkline() {
+    std::printf("%d samples in a %dx%d px graph, one appended sample + repaint() per frame (%s kernel)\n", kSamples,
+                kWidth, kHeight, MinMaxDecimator::kernelName());
+    int next = kSamples;
+
+    NaivePolylineGraph naive(kSamples);
+    prepare(naive);
+    const double naiveNs = nsPerCall([&]() {
+        naive.appendSample(sampleAt(next++));
+        naive.repaint();
+    }, kMeasureMs);
+
+    SparklineGraph cached;
+    cached.setCapacity(kSamples);
+    cached.setRange(0.0f, 100.0f);
+    prepare(cached);
+    const double cachedNs = nsPerCall([&]() {
+        cached.appendSample(sampleAt(next++));
+        cached.repaint();
+    }, kMeasureMs);
+
+    // 同一元件但每一格都整張重畫：只有 min/max 降採樣，沒有快取
+    SparklineGraph rebuilt;
+    rebuilt.setCapacity(kSamples);
+    rebuilt.setRange(0.0f, 100.0f);
+    prepare(rebuilt);
+    const double rebuiltNs = nsPerCall([&]() {
+        rebuilt.appendSample(sampleAt(next++));
+        rebuilt.setRange(0.0f, 100.0f);
+        rebuilt.repaint();
+    }, kMeasureMs);
+
+    std::printf("naive polyline:            %8.1f us/frame\n", naiveNs / 1000.0);
+    std::printf("SparklineGraph, rebuilt:   %8.1f us/frame  (x%.1f)\n", rebuiltNs / 1000.0, naiveNs / rebuiltNs);
+    std::printf("SparklineGraph, cached:    %8.1f us/frame  (x%.1f)\n", cachedNs / 1000.0, naiveNs / cachedNs);
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "Benchmark.h"
+#include <QApplication>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+const struct {
+    const char *name;
+    const char *description;
+    int (*run)();
+} kBenchmarks[] = {
+    {"scheduler", "SampleScheduler coalesced wakeups vs one QTimer per task", Bench::scheduler},
+    {"snapshot", "TripleBuffer / SpscRing publish and read latency under contention", Bench::snapshotBuffer},
+    {"gorilla", "GorillaBlock bytes/sample, encode and decode throughput, round trip", Bench::gorilla},
+    {"sparkline", "SparklineGraph paint time per frame vs a naive polyline", Bench::sparkline},
+    {"procreader", "ProcFile + in-place parsing vs QFile::readAll + split on procfs", Bench::procReader},
+};
+
+void printUsage(const char *program) {
+    std::printf("usage: %s <name>... | all\n\n", program);
+    for (const auto &bench : kBenchmarks) {
+        std::printf("  %-12s %s\n", bench.name, bench.description);
+    }
+}
+}
+
+int main(int argc, char *argv[]) {
+    // 量測不需要實際顯示：曲線圖在 offscreen 平台上繪製 (可用 QT_QPA_PLATFORM 覆寫)
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    if (argc < 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    int failures = 0;
+    for (int i = 1; i < argc; ++i) {
+        const bool all = std::strcmp(argv[i], "all") == 0;
+        bool matched = false;
+        for (const auto &bench : kBenchmarks) {
+            if (!all && std::strcmp(argv[i], bench.name) != 0) continue;
+            matched = true;
+            std::printf("== %s ==\n", bench.name);
+            std::fflush(stdout);
+            if (bench.run() != 0) {
+                std::printf("%s: FAILED\n", bench.name);
+                ++failures;
+            }
+            std::printf("\n");
+        }
+        if (!matched) {
+            std::printf("unknown benchmark: %s\n\n", argv[i]);
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    return failures == 0 ? 0 : 2;
+}
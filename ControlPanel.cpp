@@ -1,6 +1,7 @@
 #include "ControlPanel.h"
 #include "ui_ControlPanel.h"
 #include "SettingsManager.h"
+#include "MetricHistory.h"
 
 /* ----- 引入具體的小工具類別 ----- */
 #include "Widgets/TimeWidget.h"
@@ -11,6 +12,7 @@
 #include "Widgets/ImageWidget.h"
 #include "Widgets/PomodoroWidget.h"
 #include "Widgets/ClipboardWidget.h"
+#include "Widgets/LatencyWidget.h"
 
 #include <QFile>
 #include <QJsonDocument>
@@ -46,6 +48,7 @@ ControlPanel::ControlPanel(QWidget *parent) :
     ui->autoStart_checkBox->setChecked(SettingsManager::instance()->isAutoStart());
 
     /** 3. 實例化所有工具 Widget **/
+    MetricHistory::instance(); // 程式啟動即開始累積歷史資料，不論小工具是否開啟
     initWidgets();
 
     /** 4. 嵌入右側設定表單與訊號連線 **/
@@ -158,6 +161,7 @@ void ControlPanel::initWidgets() {
         else if (widgetClass == "ImageWidget") instance = new ImageWidget();
         else if (widgetClass == "PomodoroWidget") instance = new PomodoroWidget();
         else if (widgetClass == "ClipboardWidget") instance = new ClipboardWidget();
+        else if (widgetClass == "LatencyWidget") instance = new LatencyWidget();
 
         if (instance) {
             m_widgetInstances.insert(id, instance);
@@ -322,6 +326,10 @@ QJsonObject ControlPanel::getGlobalLayoutData() {
             widgetInfo["scale"] = imgW->currentScale();
             widgetInfo["path"] = imgW->currentPath();
         }
+        // 5. LatencyWidget
+        else if (auto* latW = dynamic_cast<LatencyWidget*>(w)) {
+            widgetInfo["probePeriodUs"] = latW->probePeriodUs();
+        }
 
         widgetsArray.append(widgetInfo);
     }
@@ -372,6 +380,9 @@ void ControlPanel::on_LoadTheme_clicked() {
             imgW->setCustomSetting("scale", obj["scale"].toVariant());
             imgW->setCustomSetting("path", obj["path"].toVariant());
         }
+        else if (auto* latW = dynamic_cast<LatencyWidget*>(w)) {
+            if (obj.contains("probePeriodUs")) latW->setCustomSetting("probePeriodUs", obj["probePeriodUs"].toVariant());
+        }
 
         if (obj["visible"].toBool())
         {
@@ -11,10 +11,22 @@ BaseComponent::BaseComponent(QWidget *parent) : QWidget(parent) {
     this->setWindowFlags(Qt::FramelessWindowHint | Qt::Tool);
     this->setAttribute(Qt::WA_TranslucentBackground);
 
-    // 初始化懸停監控定時器
-    m_hoverCheckTimer = new QTimer(this);
-    m_hoverCheckTimer->setInterval(100); // 100ms 輪詢一次
-    connect(m_hoverCheckTimer, &QTimer::timeout, this, &BaseComponent::handleHoverCheck);
+    // 初始化懸停監控工作 (100ms 輪詢一次，功能開啟時才啟用)
+    m_hoverTaskId = SampleScheduler::instance()->addTask(this, 100, [this]() { handleHoverCheck(); });
+    SampleScheduler::instance()->setActive(m_hoverTaskId, false);
+}
+
+void BaseComponent::startSampling(int intervalMs, SampleScheduler::Cost cost) {
+    if (m_sampleTaskId >= 0) return;
+    m_updateInterval = intervalMs;
+    m_sampleTaskId = SampleScheduler::instance()->addTask(this, intervalMs, [this]() { updateData(); }, cost);
+}
+
+void BaseComponent::setUpdateInterval(int ms) {
+    m_updateInterval = ms;
+    if (m_sampleTaskId >= 0) {
+        SampleScheduler::instance()->setInterval(m_sampleTaskId, ms);
+    }
 }
 
 void BaseComponent::initStyle() {
@@ -62,10 +74,8 @@ void BaseComponent::setWindowLayer(int layer) {
 // --- 懸停透明度邏輯 ---
 void BaseComponent::setHoverHide(bool enable) {
     m_hoverHide = enable;
-    if (m_hoverHide) {
-        m_hoverCheckTimer->start(); // 開啟功能即啟動主動輪詢
-    } else {
-        m_hoverCheckTimer->stop();
+    SampleScheduler::instance()->setActive(m_hoverTaskId, m_hoverHide); // 開啟功能即啟動主動輪詢
+    if (!m_hoverHide) {
         this->setWindowOpacity(1.0); // 確保功能關閉時恢復顯示
     }
 }
@@ -7,6 +7,7 @@
 #include <QTimer>
 #include <QCursor>
 #include <QStyle>
+#include "SampleScheduler.h"
 
 /**
  * @brief 所有桌面小工具的基底類別
@@ -22,7 +23,7 @@ public:
     // --- 虛擬函式：由子類別實作具體內容 ---
     virtual void initStyle();
     virtual void updateData() = 0; // 用於每秒更新 (如時間、系統資訊)
-    virtual void setUpdateInterval(int ms) { m_updateInterval = ms; } // 新增：設定更新頻率
+    virtual void setUpdateInterval(int ms); // 新增：設定更新頻率 (同步到排程器)
     virtual int updateInterval() const { return m_updateInterval; }   // 新增：取得更新頻率
 
     // --- 行為設定 (Setters) ---
@@ -100,6 +101,13 @@ protected:
     bool m_hoverHide = false;
     double m_hoverOpacity = 1.0;
     int m_updateInterval = 1000; // 預設 1000ms
+    int m_sampleTaskId = -1;     // 在 SampleScheduler 中的 updateData 工作編號
+
+    /**
+     * @brief 向全域排程器登記週期性的 updateData
+     * 取代子類別自行建立 QTimer，讓所有小工具共用同一個喚醒來源
+     */
+    void startSampling(int intervalMs, SampleScheduler::Cost cost = SampleScheduler::Light);
 
     // 滑鼠進出事件：處理懸停透明度變化
     void enterEvent(QEnterEvent *event) override;
@@ -116,8 +124,8 @@ private:
     bool m_isMoving = false;
     QPoint m_dragPosition; // 紀錄滑鼠按下時的相對位置
 
-    // 監控計時器
-    QTimer *m_hoverCheckTimer;
+    // 懸停監控工作 (登記於 SampleScheduler)
+    int m_hoverTaskId = -1;
 
     // 邊緣吸附運算
     void performSnap(QPoint &newPos);
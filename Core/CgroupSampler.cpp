@@ -0,0 +1,324 @@
+#include "CgroupSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <algorithm>
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+namespace {
+const char *const kHotFileNames[] = {"cpu.stat", "memory.current", "io.stat"};
+
+// 沒有 inotify 時 (例如 watch 數量用完) 的重新走訪週期
+constexpr qint64 kRewalkIntervalNs = 30LL * 1000000000LL;
+
+std::string detectMount() {
+    // 純 v2 掛載在 /sys/fs/cgroup；混合模式下 v2 階層位於 unified
+    if (access("/sys/fs/cgroup/cgroup.controllers", F_OK) == 0) return "/sys/fs/cgroup";
+    if (access("/sys/fs/cgroup/unified/cgroup.procs", F_OK) == 0) return "/sys/fs/cgroup/unified";
+    return std::string();
+}
+
+int openFile(const std::string &path) {
+    int fd;
+    do {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    return fd;
+}
+
+// "key value" 格式 (cpu.stat、memory.stat) 中以 key 開頭的那一行
+quint64 lineValue(std::string_view text, std::string_view key) {
+    std::string_view line;
+    while (ProcText::nextLine(text, line)) {
+        if (line.size() > key.size() && ProcText::startsWith(line, key) && line[key.size()] == ' ') {
+            quint64 value = 0;
+            line.remove_prefix(key.size());
+            ProcText::nextU64(line, value);
+            return value;
+        }
+    }
+    return 0;
+}
+
+// io.stat 每個裝置一行："8:0 rbytes=123 wbytes=456 rios=1 wios=2 dbytes=0 dios=0"
+quint64 fieldValue(std::string_view line, std::string_view key) {
+    const size_t pos = line.find(key);
+    if (pos == std::string_view::npos) return 0;
+    std::string_view rest = line.substr(pos + key.size());
+    quint64 value = 0;
+    ProcText::nextU64(rest, value);
+    return value;
+}
+}
+
+CgroupSampler::CgroupSampler() {
+    m_buffer.resize(4096);
+}
+
+CgroupSampler::~CgroupSampler() {
+    for (Node &node : m_nodes) closeNode(node);
+    if (m_inotifyFd >= 0) ::close(m_inotifyFd);
+}
+
+void CgroupSampler::configure(const std::string &subtree, CgroupTopSample::SortKey sortBy) {
+    m_sortBy = sortBy;
+    if (m_configured && subtree == m_subtree) return;
+
+    // 子樹改變：舊的節點與 inotify watch 全部捨棄，下次取樣重新走訪
+    m_configured = true;
+    m_subtree = subtree;
+    for (Node &node : m_nodes) closeNode(node);
+    m_nodes.clear();
+    m_watchToNode.clear();
+    resetWatches();
+
+    const std::string mount = detectMount();
+    m_root = mount.empty() ? std::string() : (subtree.empty() ? mount : mount + "/" + subtree);
+    m_dirty = true;
+}
+
+std::string CgroupSampler::fullPath(const std::string &relative) const {
+    return relative.empty() ? m_root : m_root + "/" + relative;
+}
+
+void CgroupSampler::resetWatches() {
+    if (m_inotifyFd >= 0) ::close(m_inotifyFd);
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+}
+
+void CgroupSampler::openNode(Node &node) {
+    const std::string base = fullPath(node.path) + "/";
+    for (int i = 0; i < HotFileCount; ++i) {
+        const std::string path = base + kHotFileNames[i];
+        if (DescriptorBudget::acquire()) {
+            node.fds[i] = openFile(path);
+            if (node.fds[i] < 0) {
+                DescriptorBudget::release();
+                node.fds[i] = kAbsent; // 未啟用該控制器
+            }
+        } else {
+            node.fds[i] = (access(path.c_str(), F_OK) == 0) ? kTransient : kAbsent;
+        }
+    }
+}
+
+void CgroupSampler::closeNode(Node &node) {
+    for (int &fd : node.fds) {
+        if (fd >= 0) {
+            ::close(fd);
+            DescriptorBudget::release();
+        }
+        fd = kAbsent;
+    }
+}
+
+bool CgroupSampler::readPopulated(const std::string &relative) {
+    // 子樹根目錄若是階層根目錄則沒有 cgroup.events，視為有行程
+    if (!m_scratch.open(fullPath(relative) + "/cgroup.events")) return true;
+    const std::string_view content = m_scratch.read();
+    m_scratch.close();
+    const size_t pos = content.find("populated ");
+    return pos == std::string_view::npos || content.substr(pos + 10, 1) != "0";
+}
+
+void CgroupSampler::walk(const std::string &relative, std::vector<Node> &nodes,
+                         std::unordered_map<std::string, Node> &previous) {
+    const std::string dirPath = fullPath(relative);
+    const size_t index = nodes.size();
+
+    // 沿用既有節點 (保留描述元與上一輪的計數器)，新的 cgroup 才開檔
+    auto found = previous.find(relative);
+    if (found != previous.end()) {
+        nodes.push_back(std::move(found->second));
+        previous.erase(found);
+    } else {
+        Node node;
+        node.path = relative;
+        openNode(node);
+        nodes.push_back(std::move(node));
+    }
+    nodes[index].populated = readPopulated(relative);
+
+    if (m_inotifyFd >= 0) {
+        const int wd = inotify_add_watch(m_inotifyFd, dirPath.c_str(), IN_CREATE | IN_DELETE | IN_MODIFY | IN_ONLYDIR);
+        if (wd >= 0) m_watchToNode[wd] = index;
+    }
+
+    DIR *dir = opendir(dirPath.c_str());
+    if (!dir) return;
+    std::vector<std::string> children;
+    while (dirent *ent = readdir(dir)) {
+        if (ent->d_type != DT_DIR || ent->d_name[0] == '.') continue;
+        children.emplace_back(ent->d_name);
+    }
+    closedir(dir);
+
+    std::sort(children.begin(), children.end());
+    for (const std::string &child : children) {
+        walk(relative.empty() ? child : relative + "/" + child, nodes, previous);
+    }
+}
+
+void CgroupSampler::rescan() {
+    std::unordered_map<std::string, Node> previous;
+    previous.reserve(m_nodes.size());
+    for (Node &node : m_nodes) {
+        std::string key = node.path;
+        previous.emplace(std::move(key), std::move(node));
+    }
+
+    std::vector<Node> nodes;
+    nodes.reserve(m_nodes.size());
+    m_watchToNode.clear();
+    walk(std::string(), nodes, previous);
+
+    // 已移除的 cgroup：歸還描述元 (inotify watch 由核心在目錄刪除時自動移除)
+    for (auto &item : previous) closeNode(item.second);
+    m_nodes.swap(nodes);
+    m_dirty = false;
+    m_lastWalkNs = ProcText::monotonicNs();
+}
+
+bool CgroupSampler::processEvents() {
+    if (m_inotifyFd < 0) return ProcText::monotonicNs() - m_lastWalkNs >= kRewalkIntervalNs;
+
+    alignas(inotify_event) char buffer[4096];
+    bool structureChanged = false;
+    for (;;) {
+        const ssize_t n = ::read(m_inotifyFd, buffer, sizeof(buffer));
+        if (n <= 0) break; // EAGAIN：沒有更多事件
+
+        for (ssize_t offset = 0; offset < n;) {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                structureChanged = true; // 事件遺失，只能重新走訪
+            } else if ((event->mask & (IN_CREATE | IN_DELETE)) && (event->mask & IN_ISDIR)) {
+                structureChanged = true;
+            } else if ((event->mask & IN_MODIFY) && event->len > 0 && std::string_view(event->name) == "cgroup.events") {
+                // 只有 populated / frozen 改變，不需要重新走訪
+                auto it = m_watchToNode.find(event->wd);
+                if (it != m_watchToNode.end() && it->second < m_nodes.size()) {
+                    Node &node = m_nodes[it->second];
+                    node.populated = readPopulated(node.path);
+                    if (!node.populated) node.hasBaseline = false;
+                }
+            }
+        }
+    }
+    return structureChanged;
+}
+
+std::string_view CgroupSampler::readHot(const Node &node, HotFile file) {
+    int fd = node.fds[file];
+    if (fd == kAbsent) return std::string_view();
+
+    const bool transient = fd == kTransient;
+    if (transient) {
+        fd = openFile(fullPath(node.path) + "/" + kHotFileNames[file]);
+        if (fd < 0) return std::string_view();
+    }
+    ssize_t n;
+    do {
+        n = ::pread(fd, m_buffer.data(), m_buffer.size(), 0);
+    } while (n < 0 && errno == EINTR);
+    if (transient) ::close(fd);
+    // io.stat 在裝置很多時可能被截斷，只會少算部分裝置
+    return n > 0 ? std::string_view(m_buffer.data(), static_cast<size_t>(n)) : std::string_view();
+}
+
+void CgroupSampler::readNode(Node &node, double elapsedSec) {
+    const quint64 usage = lineValue(readHot(node, CpuStat), "usage_usec");
+    quint64 memory = 0;
+    node.memoryBytes = ProcText::toU64(ProcText::trim(readHot(node, MemoryCurrent)), memory) ? memory : 0;
+
+    quint64 ioBytes = 0;
+    std::string_view ioStat = readHot(node, IoStat);
+    std::string_view line;
+    while (ProcText::nextLine(ioStat, line)) {
+        ioBytes += fieldValue(line, " rbytes=") + fieldValue(line, " wbytes=");
+    }
+
+    if (node.hasBaseline && elapsedSec > 0.0) {
+        node.cpuPercent = usage >= node.usageUsec ? float((usage - node.usageUsec) / (elapsedSec * 1e4)) : 0.0f;
+        node.ioBytesPerSec = ioBytes >= node.ioBytes ? double(ioBytes - node.ioBytes) / elapsedSec : 0.0;
+    } else {
+        node.cpuPercent = 0.0f;
+        node.ioBytesPerSec = 0.0;
+    }
+    node.usageUsec = usage;
+    node.ioBytes = ioBytes;
+    node.hasBaseline = true;
+}
+
+void CgroupSampler::sample(CgroupTopSample &out) {
+    if (!m_configured) configure(std::string(), m_sortBy);
+    out.valid = false;
+    out.count = 0;
+    if (m_root.empty()) return;
+
+    const qint64 startNs = ProcText::monotonicNs();
+    if (processEvents()) m_dirty = true;
+    if (m_dirty) rescan();
+
+    const double elapsedSec = m_prevNs > 0 ? double(startNs - m_prevNs) / 1e9 : 0.0;
+    m_prevNs = startNs;
+
+    // 子樹本身 (索引 0) 包含所有子 cgroup 的用量，不列入排行
+    m_ranked.clear();
+    int populated = 0;
+    for (size_t i = 0; i < m_nodes.size(); ++i) {
+        Node &node = m_nodes[i];
+        if (!node.populated) continue;
+        ++populated;
+        readNode(node, elapsedSec);
+        if (i > 0) m_ranked.push_back(&node);
+    }
+
+    auto metric = [this](const Node *node) -> double {
+        switch (m_sortBy) {
+        case CgroupTopSample::ByMemory: return double(node->memoryBytes);
+        case CgroupTopSample::ByIo: return node->ioBytesPerSec;
+        default: return node->cpuPercent;
+        }
+    };
+    const size_t topCount = qMin<size_t>(m_ranked.size(), SnapshotLimits::kMaxTopCgroups);
+    std::partial_sort(m_ranked.begin(), m_ranked.begin() + static_cast<std::ptrdiff_t>(topCount), m_ranked.end(),
+                      [&metric](const Node *a, const Node *b) {
+        const double va = metric(a), vb = metric(b);
+        if (va != vb) return va > vb;
+        return a->path < b->path;
+    });
+
+    out.valid = elapsedSec > 0.0;
+    out.cgroupCount = static_cast<int>(m_nodes.size());
+    out.populatedCount = populated;
+    out.count = static_cast<int>(topCount);
+    for (int i = 0; i < out.count; ++i) {
+        const Node *node = m_ranked[i];
+        CgroupSample &cgroup = out.top[i];
+        const size_t length = qMin<size_t>(node->path.size(), SnapshotLimits::kNameLength - 1);
+        std::copy_n(node->path.data(), length, cgroup.path.text);
+        cgroup.path.text[length] = '\0';
+        cgroup.cpuPercent = node->cpuPercent;
+        cgroup.memoryBytes = node->memoryBytes;
+        cgroup.ioBytesPerSec = node->ioBytesPerSec;
+
+        // memory.stat 有數十行，只為排行中的 cgroup 讀取
+        cgroup.anonBytes = 0;
+        cgroup.fileBytes = 0;
+        if (m_scratch.open(fullPath(node->path) + "/memory.stat")) {
+            const std::string_view stat = m_scratch.read();
+            cgroup.anonBytes = lineValue(stat, "anon");
+            cgroup.fileBytes = lineValue(stat, "file");
+            m_scratch.close();
+        }
+    }
+    out.scanMicros = (ProcText::monotonicNs() - startNs) / 1000;
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,90 @@
+#ifndef CGROUPSAMPLER_H
+#define CGROUPSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Linux cgroup v2 子樹用量排行 (cpu.stat / memory.current / memory.stat / io.stat)
+ * 目錄樹只在變動時重新探索：每個 cgroup 目錄都加入 inotify，
+ * 子 cgroup 建立或移除 (IN_CREATE / IN_DELETE) 時才重新走訪，
+ * cgroup.events 改變 (IN_MODIFY) 時只更新該 cgroup 的 populated 狀態。
+ *
+ * 每次取樣只讀取有行程的 cgroup 的熱檔案 (cpu.stat、memory.current、io.stat)，
+ * 描述元常駐開啟 (受 DescriptorBudget 限制)；memory.stat 較大，只為排行中的 cgroup 讀取。
+ * 沒有行程的 cgroup 不讀取，因此只剩頁面快取的 cgroup 不會出現在記憶體排行中。
+ *
+ * 只支援 cgroup v2；混合模式 (v1 + /sys/fs/cgroup/unified) 下通常只有 cpu.stat 可用。
+ */
+class CgroupSampler
+{
+public:
+    CgroupSampler();
+    ~CgroupSampler();
+
+    CgroupSampler(const CgroupSampler &) = delete;
+    CgroupSampler &operator=(const CgroupSampler &) = delete;
+
+    /** @brief 設定要檢視的子樹 (相對於 cgroup2 掛載點，空字串代表整個階層) 與排序方式 */
+    void configure(const std::string &subtree, CgroupTopSample::SortKey sortBy);
+
+    void sample(CgroupTopSample &out);
+
+private:
+    enum HotFile {
+        CpuStat = 0,
+        MemoryCurrent,
+        IoStat,
+        HotFileCount
+    };
+
+    // 熱檔案描述元：>= 0 常駐開啟；kTransient 代表超出預算，每次臨時開啟；kAbsent 代表檔案不存在
+    static constexpr int kTransient = -1;
+    static constexpr int kAbsent = -2;
+
+    struct Node {
+        std::string path;         // 相對於子樹 (子樹本身為空字串)
+        int fds[HotFileCount] = {kAbsent, kAbsent, kAbsent};
+        bool populated = true;
+        bool hasBaseline = false;
+        quint64 usageUsec = 0;
+        quint64 ioBytes = 0;
+        quint64 memoryBytes = 0;
+        float cpuPercent = 0.0f;
+        double ioBytesPerSec = 0.0;
+    };
+
+    void rescan();
+    void walk(const std::string &relative, std::vector<Node> &nodes, std::unordered_map<std::string, Node> &previous);
+    bool processEvents();
+    void readNode(Node &node, double elapsedSec);
+    std::string_view readHot(const Node &node, HotFile file);
+    void openNode(Node &node);
+    void closeNode(Node &node);
+    void resetWatches();
+    bool readPopulated(const std::string &relative);
+    std::string fullPath(const std::string &relative) const;
+
+    std::string m_root;           // 掛載點 + 子樹 (不含結尾斜線)
+    std::string m_subtree;
+    CgroupTopSample::SortKey m_sortBy = CgroupTopSample::ByCpu;
+    bool m_configured = false;
+
+    std::vector<Node> m_nodes;
+    std::unordered_map<int, size_t> m_watchToNode;  // inotify watch -> m_nodes 索引
+    std::vector<const Node *> m_ranked;
+    int m_inotifyFd = -1;
+    bool m_dirty = true;
+    qint64 m_prevNs = 0;
+    qint64 m_lastWalkNs = 0;      // 沒有 inotify 時定期重新走訪
+    ProcFile m_scratch;           // cgroup.events / memory.stat 等臨時讀取
+    std::vector<char> m_buffer;   // 熱檔案讀取緩衝區
+};
+#endif // Q_OS_LINUX
+
+#endif // CGROUPSAMPLER_H
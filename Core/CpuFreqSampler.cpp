@@ -0,0 +1,142 @@
+#include "CpuFreqSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+// 離線核心的 cpufreq 目錄在重新上線前不存在，每隔一段時間再找一次
+constexpr qint64 kRediscoverNs = 30LL * 1000 * 1000 * 1000;
+
+// 依 CpuFreqSampler::File 的順序；cpuinfo_cur_freq 通常只有 root 可讀，只在沒有 scaling_cur_freq 時使用
+const char *const kFileNames[] = {"scaling_cur_freq", "cpuinfo_cur_freq"};
+
+void freqPath(char *path, size_t size, int core, const char *file) {
+    std::snprintf(path, size, "/sys/devices/system/cpu/cpu%d/cpufreq/%s", core, file);
+}
+
+int openPath(const char *path) {
+    int fd;
+    do {
+        fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    return fd;
+}
+}
+
+CpuFreqSampler::~CpuFreqSampler() {
+    for (int core = 0; core < int(m_cores.size()); ++core) closeCore(core);
+}
+
+void CpuFreqSampler::openCores(int coreCount) {
+    // 只為新出現的核心探索；已探索過但不存在的核心等待定期重新探索
+    const int first = int(m_cores.size());
+    m_cores.resize(size_t(coreCount));
+    for (int core = first; core < coreCount; ++core) discover(core);
+    m_lastDiscoverNs = ProcText::monotonicNs();
+}
+
+void CpuFreqSampler::discover(int core) {
+    Core &entry = m_cores[core];
+    char path[96];
+    for (int file = 0; file < FileCount; ++file) {
+        freqPath(path, sizeof(path), core, kFileNames[file]);
+        if (DescriptorBudget::acquire()) {
+            entry.fd = openPath(path);
+            if (entry.fd < 0) {
+                DescriptorBudget::release();
+                entry.fd = kAbsent;
+            }
+        } else {
+            entry.fd = ::access(path, R_OK) == 0 ? kTransient : kAbsent;
+        }
+        if (entry.fd != kAbsent) {
+            entry.file = quint8(file);
+            ++m_availableCores;
+            return;
+        }
+    }
+}
+
+void CpuFreqSampler::closeCore(int core) {
+    Core &entry = m_cores[core];
+    if (entry.fd >= 0) {
+        ::close(entry.fd);
+        DescriptorBudget::release();
+    }
+    if (entry.fd != kAbsent) --m_availableCores;
+    entry.fd = kAbsent;
+}
+
+bool CpuFreqSampler::readCore(int core, quint64 &kHz) {
+    const Core &entry = m_cores[core];
+    if (entry.fd >= 0) return ProcText::readU64(entry.fd, kHz);
+    if (entry.fd == kAbsent) return false;
+
+    char path[96];
+    freqPath(path, sizeof(path), core, kFileNames[entry.file]);
+    const int transient = openPath(path);
+    if (transient < 0) return false;
+    const bool ok = ProcText::readU64(transient, kHz);
+    ::close(transient);
+    return ok;
+}
+
+void CpuFreqSampler::sample(CpuSample &out) {
+    const int coreCount = out.coreCount;
+    if (coreCount <= 0) return;
+    if (coreCount > int(m_cores.size())) openCores(coreCount);
+
+    const qint64 now = ProcText::monotonicNs();
+    if (now - m_lastDiscoverNs > kRediscoverNs) {
+        for (int core = 0; core < int(m_cores.size()); ++core) {
+            if (m_cores[core].fd == kAbsent) discover(core);
+        }
+        m_lastDiscoverNs = now;
+    }
+
+    if (m_availableCores == 0) {
+        sampleCpuinfo(out);
+        return;
+    }
+
+    for (int core = 0; core < coreCount; ++core) {
+        quint64 kHz = 0;
+        if (readCore(core, kHz)) {
+            out.coreMhz[core] = kHz / 1000.0f;
+        } else {
+            // 離線核心或讀取失敗時為 0，顯示端會略過；關閉後等待重新探索
+            out.coreMhz[core] = 0.0f;
+            if (m_cores[core].fd != kAbsent) closeCore(core);
+        }
+    }
+}
+
+void CpuFreqSampler::sampleCpuinfo(CpuSample &out) {
+    // /proc/cpuinfo 沒有列出的核心 (離線) 為 0，不保留上一次的值
+    std::fill(out.coreMhz, out.coreMhz + out.coreCount, 0.0f);
+    if (!m_cpuinfo.isOpen() && !m_cpuinfo.open("/proc/cpuinfo")) return;
+
+    std::string_view text = m_cpuinfo.read();
+    std::string_view line;
+    quint64 processor = 0;
+    bool haveProcessor = false;
+    while (ProcText::nextLine(text, line)) {
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) continue;
+
+        const std::string_view key = ProcText::trim(line.substr(0, colon));
+        const std::string_view value = ProcText::trim(line.substr(colon + 1));
+        if (key == "processor") {
+            haveProcessor = ProcText::toU64(value, processor);
+        } else if (key == "cpu MHz" && haveProcessor && processor < quint64(out.coreCount)) {
+            double mhz = 0.0;
+            if (ProcText::toDouble(value, mhz)) out.coreMhz[processor] = static_cast<float>(mhz);
+        }
+    }
+}
+
+#endif // Q_OS_LINUX
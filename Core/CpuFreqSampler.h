@@ -0,0 +1,58 @@
+#ifndef CPUFREQSAMPLER_H
+#define CPUFREQSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <vector>
+
+/**
+ * @brief Linux 各核心目前頻率 (cpufreq sysfs，備援 /proc/cpuinfo)
+ * 每個核心的 scaling_cur_freq 在第一次看到該核心時開啟並常駐
+ * (受 DescriptorBudget 限制，超出預算者每次臨時開啟)，之後每次取樣只以 pread 讀入堆疊上的小緩衝區。
+ * 離線核心沒有 cpufreq 目錄，每隔一段時間重新探索。
+ * 沒有 cpufreq 驅動 (例如部分虛擬機) 時改讀 /proc/cpuinfo 的 "cpu MHz"。
+ */
+class CpuFreqSampler
+{
+public:
+    CpuFreqSampler() = default;
+    ~CpuFreqSampler();
+
+    CpuFreqSampler(const CpuFreqSampler &) = delete;
+    CpuFreqSampler &operator=(const CpuFreqSampler &) = delete;
+
+    /** @brief 填入 out.coreMhz[0..out.coreCount)，需在 CPU 使用率取樣後呼叫 */
+    void sample(CpuSample &out);
+
+private:
+    // 描述元：>= 0 常駐開啟；kTransient 代表超出預算，每次臨時開啟；kAbsent 代表檔案不存在
+    static constexpr int kTransient = -1;
+    static constexpr int kAbsent = -2;
+
+    enum File {
+        ScalingCurFreq = 0,
+        CpuinfoCurFreq,
+        FileCount
+    };
+
+    struct Core {
+        int fd = kAbsent;
+        quint8 file = ScalingCurFreq;   // 實際使用的檔案，臨時開啟時需要
+    };
+
+    void openCores(int coreCount);
+    void discover(int core);
+    bool readCore(int core, quint64 &kHz);
+    void closeCore(int core);
+    void sampleCpuinfo(CpuSample &out);
+
+    std::vector<Core> m_cores;          // 依核心編號
+    int m_availableCores = 0;           // fd 不是 kAbsent 的核心數，0 時改讀 /proc/cpuinfo
+    qint64 m_lastDiscoverNs = 0;
+    ProcFile m_cpuinfo;
+};
+#endif // Q_OS_LINUX
+
+#endif // CPUFREQSAMPLER_H
@@ -0,0 +1,170 @@
+#include "CpuIdleSampler.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+// 離線核心的 cpuidle 目錄在重新上線前不存在，每隔一段時間再找一次
+constexpr qint64 kRediscoverNs = 30LL * 1000 * 1000 * 1000;
+
+const char *const kFileNames[] = {"time", "usage"};
+
+void statePath(char *path, size_t size, int core, int state, const char *file) {
+    std::snprintf(path, size, "/sys/devices/system/cpu/cpu%d/cpuidle/state%d/%s", core, state, file);
+}
+
+int openPath(const char *path) {
+    int fd;
+    do {
+        fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    return fd;
+}
+}
+
+CpuIdleSampler::CpuIdleSampler() {
+    m_coreCount = qBound(0, int(sysconf(_SC_NPROCESSORS_CONF)), SnapshotLimits::kMaxCores);
+    m_states.resize(size_t(m_coreCount) * SnapshotLimits::kMaxIdleStates);
+    m_coreStates.assign(size_t(m_coreCount), 0);
+    for (int core = 0; core < m_coreCount; ++core) discover(core);
+    m_lastDiscoverNs = ProcText::monotonicNs();
+}
+
+CpuIdleSampler::~CpuIdleSampler() {
+    closeAll();
+}
+
+void CpuIdleSampler::closeAll() {
+    for (int core = 0; core < m_coreCount; ++core) closeCore(core);
+}
+
+void CpuIdleSampler::closeCore(int core) {
+    for (int i = 0; i < SnapshotLimits::kMaxIdleStates; ++i) {
+        State &entry = state(core, i);
+        for (int &fd : entry.fds) {
+            if (fd >= 0) {
+                ::close(fd);
+                DescriptorBudget::release();
+            }
+            fd = kAbsent;
+        }
+        entry.hasBaseline = false;
+    }
+    m_coreStates[core] = 0;
+}
+
+void CpuIdleSampler::discover(int core) {
+    char path[96];
+    int count = 0;
+    for (; count < SnapshotLimits::kMaxIdleStates; ++count) {
+        State &entry = state(core, count);
+        for (int file = 0; file < FileCount; ++file) {
+            statePath(path, sizeof(path), core, count, kFileNames[file]);
+            if (DescriptorBudget::acquire()) {
+                entry.fds[file] = openPath(path);
+                if (entry.fds[file] < 0) {
+                    DescriptorBudget::release();
+                    entry.fds[file] = kAbsent;
+                }
+            } else {
+                entry.fds[file] = ::access(path, R_OK) == 0 ? kTransient : kAbsent;
+            }
+        }
+        if (entry.fds[Time] == kAbsent) break; // 狀態編號連續，第一個不存在的就是結尾
+        entry.hasBaseline = false;
+
+        // 名稱以第一個找到該狀態的核心為準 (同一主機的各核心使用同一個 cpuidle 驅動)
+        if (m_names[count].text[0] == '\0') {
+            statePath(path, sizeof(path), core, count, "name");
+            ProcFile nameFile(path);
+            const std::string_view name = ProcText::trim(nameFile.read());
+            m_names[count].set(QString::fromUtf8(name.data(), int(name.size())));
+        }
+    }
+    m_coreStates[core] = quint8(count);
+    m_stateCount = qMax(m_stateCount, count);
+}
+
+bool CpuIdleSampler::readValue(int core, int index, File file, quint64 &value) {
+    const int fd = state(core, index).fds[file];
+    if (fd >= 0) return ProcText::readU64(fd, value);
+    if (fd == kAbsent) return false;
+
+    char path[96];
+    statePath(path, sizeof(path), core, index, kFileNames[file]);
+    const int transient = openPath(path);
+    if (transient < 0) return false;
+    const bool ok = ProcText::readU64(transient, value);
+    ::close(transient);
+    return ok;
+}
+
+void CpuIdleSampler::sample(CpuIdleSample &out) {
+    const qint64 startNs = ProcText::monotonicNs();
+    if (startNs - m_lastDiscoverNs > kRediscoverNs) {
+        for (int core = 0; core < m_coreCount; ++core) {
+            if (m_coreStates[core] == 0) discover(core);
+        }
+        m_lastDiscoverNs = startNs;
+    }
+
+    const qint64 elapsedNs = startNs - m_prevNs;
+    const bool hasInterval = m_prevNs > 0 && elapsedNs > 0;
+    const double elapsedUs = double(elapsedNs) / 1000.0;
+    m_prevNs = startNs;
+
+    double sums[SnapshotLimits::kMaxIdleStates] = {};
+    int counted = 0;
+    for (int core = 0; core < m_coreCount; ++core) {
+        const int states = m_coreStates[core];
+        quint64 wakeups = 0;
+        bool coreValid = states > 0;
+        for (int i = 0; i < states; ++i) {
+            State &entry = state(core, i);
+            quint64 time = 0, usage = 0;
+            // 核心離線時 cpuidle 目錄被移除，舊描述元不再有效：關閉後等待重新探索
+            if (!readValue(core, i, Time, time)) {
+                closeCore(core);
+                coreValid = false;
+                break;
+            }
+            readValue(core, i, Usage, usage);
+
+            const bool comparable = entry.hasBaseline && time >= entry.values[Time];
+            if (comparable && hasInterval) {
+                // 微秒 / 微秒；兩次讀取之間的時間差可能讓比例略超過 100%
+                out.residency[core][i] = float(qMin(100.0, double(time - entry.values[Time]) * 100.0 / elapsedUs));
+                if (usage >= entry.values[Usage]) wakeups += usage - entry.values[Usage];
+            } else {
+                coreValid = false;
+            }
+            entry.values[Time] = time;
+            entry.values[Usage] = usage;
+            entry.hasBaseline = true;
+        }
+        if (!coreValid) {
+            for (int i = 0; i < m_stateCount; ++i) out.residency[core][i] = 0.0f;
+        }
+        out.wakeupsPerSec[core] = (hasInterval && coreValid) ? float(double(wakeups) * 1e9 / double(elapsedNs)) : 0.0f;
+
+        if (coreValid) {
+            for (int i = 0; i < states; ++i) sums[i] += out.residency[core][i];
+            ++counted;
+        }
+    }
+
+    out.coreCount = m_coreCount;
+    out.stateCount = m_stateCount;
+    for (int i = 0; i < m_stateCount; ++i) {
+        out.stateNames[i] = m_names[i];
+        out.avgResidency[i] = counted > 0 ? float(sums[i] / counted) : 0.0f;
+    }
+    out.valid = hasInterval && m_stateCount > 0;
+    out.scanMicros = (ProcText::monotonicNs() - startNs) / 1000;
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,63 @@
+#ifndef CPUIDLESAMPLER_H
+#define CPUIDLESAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include <vector>
+
+/**
+ * @brief Linux 各核心 C-state 停留比例 (/sys/devices/system/cpu/cpuN/cpuidle/stateM/{time,usage})
+ * time 為累計停留時間 (微秒)，usage 為累計進入次數；與上一次取樣的差值除以間隔即為停留比例與喚醒頻率。
+ *
+ * 核心數 x 狀態數 x 2 個檔案在大型主機上可達數千個，因此：
+ * - 所有描述元在探索時開啟一次並常駐 (受 DescriptorBudget 限制，超出預算者每次臨時開啟)；
+ * - 每次取樣依核心、狀態順序連續 pread，讀入堆疊上的小緩衝區，不配置記憶體；
+ * - 整批讀取共用同一個時間戳。
+ * 狀態名稱 (POLL、C1、C6 ...) 只在探索時讀取一次；沒有 idle state 的核心 (離線) 定期重新探索。
+ */
+class CpuIdleSampler
+{
+public:
+    CpuIdleSampler();
+    ~CpuIdleSampler();
+
+    CpuIdleSampler(const CpuIdleSampler &) = delete;
+    CpuIdleSampler &operator=(const CpuIdleSampler &) = delete;
+
+    void sample(CpuIdleSample &out);
+
+private:
+    // 描述元：>= 0 常駐開啟；kTransient 代表超出預算，每次臨時開啟；kAbsent 代表檔案不存在
+    static constexpr int kTransient = -1;
+    static constexpr int kAbsent = -2;
+
+    enum File {
+        Time = 0,
+        Usage,
+        FileCount
+    };
+
+    struct State {
+        int fds[FileCount] = {kAbsent, kAbsent};
+        quint64 values[FileCount] = {0, 0};
+        bool hasBaseline = false;
+    };
+
+    void discover(int core);
+    bool readValue(int core, int state, File file, quint64 &value);
+    void closeCore(int core);
+    void closeAll();
+    State &state(int core, int index) { return m_states[size_t(core) * SnapshotLimits::kMaxIdleStates + size_t(index)]; }
+
+    int m_coreCount = 0;
+    int m_stateCount = 0;                   // 所有核心中最多的狀態數
+    std::vector<State> m_states;            // core * kMaxIdleStates + state
+    std::vector<quint8> m_coreStates;       // 各核心的狀態數，0 代表尚未找到 cpuidle
+    SampleName m_names[SnapshotLimits::kMaxIdleStates];
+    qint64 m_prevNs = 0;
+    qint64 m_lastDiscoverNs = 0;
+};
+#endif // Q_OS_LINUX
+
+#endif // CPUIDLESAMPLER_H
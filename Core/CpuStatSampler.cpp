@@ -0,0 +1,139 @@
+#include "CpuStatSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+
+namespace {
+// 計數器倒退 (核心重新上線等) 時視為 0，下一輪再以新的數值為基準
+inline quint64 delta(quint64 prev, quint64 cur) {
+    return cur >= prev ? cur - prev : 0;
+}
+}
+
+CpuStatSampler::CpuStatSampler() : m_stat("/proc/stat") {
+    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    m_minIntervalNs = 2 * 1000000000LL / (ticksPerSecond > 0 ? ticksPerSecond : 100);
+}
+
+bool CpuStatSampler::parseTimes(std::string_view fields, Times &out) {
+    quint64 *targets[] = {&out.user, &out.nice, &out.system, &out.idle,
+                          &out.iowait, &out.irq, &out.softirq, &out.steal};
+    int parsed = 0;
+    for (quint64 *target : targets) {
+        // 舊核心沒有 iowait 以後的欄位，缺少的部分維持 0
+        if (!ProcText::nextU64(fields, *target)) break;
+        ++parsed;
+    }
+    out.valid = parsed >= 4;
+    return out.valid;
+}
+
+double CpuStatSampler::busyPercent(const Times &prev, const Times &cur) {
+    const quint64 total = delta(prev.total(), cur.total());
+    if (total == 0) return 0.0;
+    // iowait 期間 CPU 實際上是閒置的，與 top 的算法一致
+    const quint64 idle = delta(prev.idle, cur.idle) + delta(prev.iowait, cur.iowait);
+    return qBound(0.0, 100.0 * (double(total) - double(qMin(idle, total))) / double(total), 100.0);
+}
+
+bool CpuStatSampler::sample(CpuSample &out) {
+    const std::string_view content = m_stat.read();
+    if (content.empty()) return false;
+
+    const qint64 readNs = m_stat.readTimeNs();
+    const bool hasBaseline = m_prevTotal.valid;
+    if (hasBaseline && readNs - m_prevReadNs < m_minIntervalNs) {
+        return true; // 間隔太短，沿用上一次的結果
+    }
+
+    Times total;
+    std::vector<Times> &cores = m_cores;
+    cores.assign(m_prevCores.size(), Times()); // 重複使用容量，不在每次取樣時配置
+    int coreCount = 0;
+
+    quint64 contextSwitches = 0;
+    quint64 forks = 0;
+    quint64 running = 0;
+    quint64 blocked = 0;
+    bool hasActivity = false;
+
+    std::string_view text = content;
+    std::string_view line;
+    while (ProcText::nextLine(text, line)) {
+        if (!ProcText::startsWith(line, "cpu")) {
+            // cpu 行之後：intr、ctxt、btime、processes ...；intr 行很長但只需要找換行
+            std::string_view value = line;
+            std::string_view key;
+            ProcText::nextToken(value, key);
+            if (key == "ctxt") {
+                hasActivity = ProcText::nextU64(value, contextSwitches);
+            } else if (key == "processes") {
+                hasActivity = ProcText::nextU64(value, forks) && hasActivity;
+            } else if (key == "procs_running") {
+                ProcText::nextU64(value, running);
+            } else if (key == "procs_blocked") {
+                ProcText::nextU64(value, blocked);
+                break; // 之後的欄位 (softirq) 不需要
+            }
+            continue;
+        }
+
+        std::string_view label;
+        ProcText::nextToken(line, label);
+        if (label == "cpu") {
+            parseTimes(line, total);
+            continue;
+        }
+
+        // cpuN：離線的核心不會出現，因此以編號定位
+        quint64 index;
+        if (!ProcText::toU64(label.substr(3), index) || index >= quint64(SnapshotLimits::kMaxCores)) continue;
+        if (index >= cores.size()) cores.resize(index + 1);
+        parseTimes(line, cores[index]);
+        coreCount = qMax(coreCount, int(index) + 1);
+    }
+    if (!total.valid) return false;
+
+    if (hasBaseline) {
+        const quint64 span = delta(m_prevTotal.total(), total.total());
+        if (span > 0) {
+            auto percent = [&](quint64 prev, quint64 cur) {
+                return float(100.0 * double(delta(prev, cur)) / double(span));
+            };
+            out.totalUsage = busyPercent(m_prevTotal, total);
+            out.userPercent = percent(m_prevTotal.user + m_prevTotal.nice, total.user + total.nice);
+            out.systemPercent = percent(m_prevTotal.system, total.system);
+            out.iowaitPercent = percent(m_prevTotal.iowait, total.iowait);
+            out.irqPercent = percent(m_prevTotal.irq + m_prevTotal.softirq, total.irq + total.softirq);
+            out.stealPercent = percent(m_prevTotal.steal, total.steal);
+            out.hasBreakdown = true;
+        }
+
+        out.coreCount = coreCount;
+        for (int i = 0; i < coreCount; ++i) {
+            const bool comparable = i < int(m_prevCores.size()) && m_prevCores[i].valid && cores[i].valid;
+            out.coreUsage[i] = comparable ? float(busyPercent(m_prevCores[i], cores[i])) : 0.0f;
+        }
+        out.valid = true;
+
+        // 全系統的 context switch 與 fork (processes 為開機後建立的行程數) 速率
+        const double elapsedSec = double(readNs - m_prevReadNs) / 1e9;
+        out.hasActivity = hasActivity && m_prevHasActivity && elapsedSec > 0.0;
+        if (out.hasActivity) {
+            out.contextSwitchesPerSec = double(delta(m_prevContextSwitches, contextSwitches)) / elapsedSec;
+            out.forksPerSec = double(delta(m_prevForks, forks)) / elapsedSec;
+        }
+        out.procsRunning = int(running);
+        out.procsBlocked = int(blocked);
+    }
+
+    m_prevContextSwitches = contextSwitches;
+    m_prevForks = forks;
+    m_prevHasActivity = hasActivity;
+    m_prevTotal = total;
+    m_prevCores.swap(cores);
+    m_prevReadNs = readNs;
+    return hasBaseline;
+}
+
+#endif // Q_OS_LINUX
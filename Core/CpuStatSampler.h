@@ -0,0 +1,58 @@
+#ifndef CPUSTATSAMPLER_H
+#define CPUSTATSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <vector>
+
+/**
+ * @brief Linux CPU 使用率取樣 (/proc/stat)
+ * 每次取樣只讀一次 /proc/stat，同時算出整體與各核心的使用率，
+ * 以及 user / system / iowait / irq / steal 的時間分類，和 context switch / fork 速率與可執行 / 阻塞中的工作數。
+ *
+ * 使用率以兩次讀取之間各欄位 jiffies 的差值計算，分母為同一段期間的總 jiffies，
+ * 與取樣間隔無關；兩次讀取的單調時鐘間隔太短 (不到 2 個 jiffy) 時沿用上一次結果，
+ * 避免計時抖動造成的雜訊。
+ */
+class CpuStatSampler
+{
+public:
+    CpuStatSampler();
+
+    /** @brief 取樣並寫入 out；第一次呼叫只建立基準，回傳 false */
+    bool sample(CpuSample &out);
+
+private:
+    struct Times {
+        quint64 user = 0;
+        quint64 nice = 0;
+        quint64 system = 0;
+        quint64 idle = 0;
+        quint64 iowait = 0;
+        quint64 irq = 0;
+        quint64 softirq = 0;
+        quint64 steal = 0;
+        bool valid = false;
+
+        // guest / guest_nice 已包含在 user / nice 中，不重複計入
+        quint64 total() const { return user + nice + system + idle + iowait + irq + softirq + steal; }
+    };
+
+    static bool parseTimes(std::string_view fields, Times &out);
+    static double busyPercent(const Times &prev, const Times &cur);
+
+    ProcFile m_stat;
+    Times m_prevTotal;
+    std::vector<Times> m_prevCores;
+    std::vector<Times> m_cores;     // 本次解析結果，與 m_prevCores 交換使用
+    qint64 m_prevReadNs = 0;
+    quint64 m_prevContextSwitches = 0;
+    quint64 m_prevForks = 0;
+    bool m_prevHasActivity = false;
+    qint64 m_minIntervalNs;
+};
+#endif // Q_OS_LINUX
+
+#endif // CPUSTATSAMPLER_H
@@ -0,0 +1,279 @@
+#include "CpuTopology.h"
+#include <QDebug>
+#include <algorithm>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#endif
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <string>
+#endif
+
+namespace {
+#ifdef Q_OS_LINUX
+bool readValue(const std::string &path, qint64 &out) {
+    ProcFile file(path);
+    return file.isOpen() && ProcText::readI64(file, out);
+}
+
+// sysfs 的 CPU 清單格式："0-3,8,10-11"
+std::vector<bool> readCpuList(const std::string &path) {
+    std::vector<bool> cpus;
+    ProcFile file(path);
+    if (!file.isOpen()) return cpus;
+
+    std::string_view text = ProcText::trim(file.read());
+    while (!text.empty()) {
+        const size_t comma = text.find(',');
+        std::string_view range = text.substr(0, comma);
+        text = comma == std::string_view::npos ? std::string_view() : text.substr(comma + 1);
+
+        const size_t dash = range.find('-');
+        quint64 first, last;
+        if (!ProcText::toU64(range.substr(0, dash), first)) continue;
+        last = first;
+        if (dash != std::string_view::npos && !ProcText::toU64(range.substr(dash + 1), last)) continue;
+        if (last >= quint64(SnapshotLimits::kMaxCores)) last = SnapshotLimits::kMaxCores - 1;
+        if (first > last) continue;
+        if (cpus.size() <= last) cpus.resize(last + 1, false);
+        for (quint64 cpu = first; cpu <= last; ++cpu) cpus[cpu] = true;
+    }
+    return cpus;
+}
+#endif
+}
+
+CpuTopology::CpuTopology() {
+    load();
+    if (isValid()) {
+        qDebug() << "CpuTopology:" << m_packageCount << "package(s)," << m_cores.size() << "core(s),"
+                 << m_threads.size() << "thread(s)" << (m_hybrid ? "(hybrid)" : "");
+    }
+}
+
+void CpuTopology::build(std::vector<RawThread> &raw) {
+    if (raw.empty()) return;
+
+    // 依 (插槽、類型、核心鍵值) 排序後編號，同一實體核心的 SMT 執行緒相鄰
+    std::sort(raw.begin(), raw.end(), [](const RawThread &a, const RawThread &b) {
+        if (a.package != b.package) return a.package < b.package;
+        if (a.type != b.type) return a.type < b.type;
+        if (a.coreKey != b.coreKey) return a.coreKey < b.coreKey;
+        return a.cpu < b.cpu;
+    });
+
+    // 插槽編號可能不連續 (例如 0 與 2)，重新編為 0..n-1
+    std::vector<int> packageIds;
+    int maxCpu = 0;
+    for (const RawThread &thread : raw) {
+        if (packageIds.empty() || packageIds.back() != thread.package) packageIds.push_back(thread.package);
+        maxCpu = qMax(maxCpu, thread.cpu);
+    }
+    m_packageCount = qMin<int>(int(packageIds.size()), SnapshotLimits::kMaxPackages);
+
+    m_threads.assign(maxCpu + 1, Thread());
+    m_cores.clear();
+    const RawThread *previous = nullptr;
+    bool types[CpuTopologySample::TypeCount] = {};
+    for (const RawThread &thread : raw) {
+        const bool sameCore = previous && previous->package == thread.package &&
+                              previous->type == thread.type && previous->coreKey == thread.coreKey;
+        if (!sameCore) {
+            if (int(m_cores.size()) >= SnapshotLimits::kMaxCores) break;
+            const int package = int(std::find(packageIds.begin(), packageIds.end(), thread.package) - packageIds.begin());
+            Core core;
+            core.package = static_cast<quint8>(qMin(package, SnapshotLimits::kMaxPackages - 1));
+            core.type = static_cast<quint8>(thread.type);
+            m_cores.push_back(core);
+            types[thread.type] = true;
+        }
+        m_threads[thread.cpu].core = static_cast<qint16>(m_cores.size() - 1);
+        previous = &thread;
+    }
+    m_hybrid = types[CpuTopologySample::Performance] && types[CpuTopologySample::Efficiency];
+}
+
+#ifdef Q_OS_LINUX
+void CpuTopology::load() {
+    const std::string base = "/sys/devices/system/cpu/cpu";
+
+    // 混合架構：Intel 以 cpu_atom PMU 列出 E-core；其他平台 (ARM big.LITTLE 等) 以 cpu_capacity 區分
+    const std::vector<bool> atom = readCpuList("/sys/devices/cpu_atom/cpus");
+    std::vector<RawThread> raw;
+    std::vector<qint64> capacity;
+    qint64 maxCapacity = 0;
+    for (int cpu = 0; cpu < SnapshotLimits::kMaxCores; ++cpu) {
+        const std::string dir = base + std::to_string(cpu);
+        qint64 package, core, die = 0;
+        // 離線的處理器沒有 topology 目錄
+        if (!readValue(dir + "/topology/physical_package_id", package) ||
+            !readValue(dir + "/topology/core_id", core)) {
+            continue;
+        }
+        readValue(dir + "/topology/die_id", die);
+
+        qint64 cap = 0;
+        readValue(dir + "/cpu_capacity", cap);
+        maxCapacity = qMax(maxCapacity, cap);
+        capacity.push_back(cap);
+
+        raw.push_back(RawThread{cpu, int(qMax<qint64>(0, package)), CpuTopologySample::Performance,
+                                (qMax<qint64>(0, die) << 32) | (core & 0xffffffff)});
+    }
+
+    for (size_t i = 0; i < raw.size(); ++i) {
+        const int cpu = raw[i].cpu;
+        const bool efficiency = !atom.empty()
+            ? (cpu < int(atom.size()) && atom[cpu])
+            : (capacity[i] > 0 && capacity[i] < maxCapacity);
+        if (efficiency) raw[i].type = CpuTopologySample::Efficiency;
+    }
+    build(raw);
+}
+
+void CpuTopology::groupIndex(int index, int &group, int &number) {
+    group = 0;
+    number = index;
+}
+#elif defined(Q_OS_WIN)
+void CpuTopology::load() {
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    if (GetLastError() != ERROR_INSUFFICIENT_BUFFER || length == 0) return;
+
+    std::vector<char> buffer(length);
+    auto *info = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(buffer.data());
+    if (!GetLogicalProcessorInformationEx(RelationAll, info, &length)) return;
+
+    // 邏輯處理器編號：依處理器群組依序排列 (與 PDH 的 \Processor(i) 一致)
+    const WORD groupCount = GetActiveProcessorGroupCount();
+    std::vector<int> groupOffset(groupCount + 1, 0);
+    for (WORD g = 0; g < groupCount; ++g) groupOffset[g + 1] = groupOffset[g] + int(GetActiveProcessorCount(g));
+    const int threadCount = qMin(groupOffset[groupCount], SnapshotLimits::kMaxCores);
+
+    std::vector<int> package(threadCount, 0);
+    std::vector<int> coreOf(threadCount, -1);
+    std::vector<BYTE> efficiencyOf;
+    BYTE maxEfficiency = 0;
+
+    auto forEachThread = [&](const GROUP_AFFINITY *masks, WORD count, auto &&fn) {
+        for (WORD m = 0; m < count; ++m) {
+            if (masks[m].Group >= groupCount) continue;
+            for (int bit = 0; bit < int(sizeof(KAFFINITY) * 8); ++bit) {
+                if (!(masks[m].Mask & (KAFFINITY(1) << bit))) continue;
+                const int index = groupOffset[masks[m].Group] + bit;
+                if (index < threadCount) fn(index);
+            }
+        }
+    };
+
+    int packageIndex = 0;
+    for (DWORD offset = 0; offset < length;) {
+        auto *entry = reinterpret_cast<SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(buffer.data() + offset);
+        if (entry->Relationship == RelationProcessorPackage) {
+            forEachThread(entry->Processor.GroupMask, entry->Processor.GroupCount, [&](int index) { package[index] = packageIndex; });
+            ++packageIndex;
+        } else if (entry->Relationship == RelationProcessorCore) {
+            // EfficiencyClass 越大代表效能越高；非混合架構全部為 0
+            const int core = int(efficiencyOf.size());
+            efficiencyOf.push_back(entry->Processor.EfficiencyClass);
+            maxEfficiency = qMax(maxEfficiency, entry->Processor.EfficiencyClass);
+            forEachThread(entry->Processor.GroupMask, entry->Processor.GroupCount, [&](int index) { coreOf[index] = core; });
+        }
+        offset += entry->Size;
+    }
+
+    std::vector<RawThread> raw;
+    for (int i = 0; i < threadCount; ++i) {
+        if (coreOf[i] < 0) continue;
+        const bool efficiency = efficiencyOf[coreOf[i]] < maxEfficiency;
+        raw.push_back(RawThread{i, package[i], efficiency ? CpuTopologySample::Efficiency : CpuTopologySample::Performance, coreOf[i]});
+    }
+    build(raw);
+}
+
+void CpuTopology::groupIndex(int index, int &group, int &number) {
+    group = 0;
+    number = index;
+    const WORD groupCount = GetActiveProcessorGroupCount();
+    for (WORD g = 0; g < groupCount; ++g) {
+        const int count = int(GetActiveProcessorCount(g));
+        if (number < count) {
+            group = g;
+            return;
+        }
+        number -= count;
+    }
+}
+#else
+void CpuTopology::load() {}
+
+void CpuTopology::groupIndex(int index, int &group, int &number) {
+    group = 0;
+    number = index;
+}
+#endif
+
+void CpuTopology::aggregate(const CpuSample &cpu, CpuTopologySample &out) const {
+    out.valid = isValid() && cpu.coreCount > 0;
+    if (!out.valid) return;
+
+    const int coreCount = int(m_cores.size());
+    out.hybrid = m_hybrid;
+    out.packageCount = m_packageCount;
+    out.coreCount = coreCount;
+
+    // 頻率只平均有數值的執行緒，另外計數
+    quint16 coreFreq[SnapshotLimits::kMaxCores] = {};
+    quint16 packageFreq[SnapshotLimits::kMaxPackages] = {};
+    quint16 typeFreq[CpuTopologySample::TypeCount] = {};
+
+    for (int i = 0; i < coreCount; ++i) {
+        out.cores[i] = CpuGroupSample();
+        out.cores[i].cores = 1;
+        out.corePackage[i] = m_cores[i].package;
+        out.coreType[i] = m_cores[i].type;
+    }
+    for (int i = 0; i < m_packageCount; ++i) out.packages[i] = CpuGroupSample();
+    for (CpuGroupSample &type : out.types) type = CpuGroupSample();
+
+    // 唯一一次走訪：每個邏輯處理器同時累加到所屬的實體核心、插槽與核心類型
+    const int threadCount = qMin<int>(cpu.coreCount, int(m_threads.size()));
+    for (int i = 0; i < threadCount; ++i) {
+        const int core = m_threads[i].core;
+        out.threadCore[i] = static_cast<qint16>(core);
+        if (core < 0) continue;
+
+        const float usage = cpu.coreUsage[i];
+        const float mhz = cpu.coreMhz[i];
+        const int package = m_cores[core].package;
+        const int type = m_cores[core].type;
+        CpuGroupSample *groups[] = {&out.cores[core], &out.packages[package], &out.types[type]};
+        quint16 *freq[] = {&coreFreq[core], &packageFreq[package], &typeFreq[type]};
+        for (int level = 0; level < 3; ++level) {
+            groups[level]->usage += usage;
+            groups[level]->threads += 1;
+            if (mhz > 0) {
+                groups[level]->mhz += mhz;
+                *freq[level] += 1;
+            }
+        }
+    }
+    for (int i = threadCount; i < cpu.coreCount; ++i) out.threadCore[i] = -1;
+
+    auto finish = [](CpuGroupSample &group, quint16 freqCount) {
+        if (group.threads > 0) group.usage /= group.threads;
+        group.mhz = freqCount > 0 ? group.mhz / freqCount : 0.0f;
+    };
+    for (int i = 0; i < coreCount; ++i) {
+        finish(out.cores[i], coreFreq[i]);
+        // 實體核心數只需依核心所屬層級計數一次
+        if (out.cores[i].threads == 0) continue;
+        out.packages[m_cores[i].package].cores += 1;
+        out.types[m_cores[i].type].cores += 1;
+    }
+    for (int i = 0; i < m_packageCount; ++i) finish(out.packages[i], packageFreq[i]);
+    for (int i = 0; i < CpuTopologySample::TypeCount; ++i) finish(out.types[i], typeFreq[i]);
+}
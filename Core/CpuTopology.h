@@ -0,0 +1,58 @@
+#ifndef CPUTOPOLOGY_H
+#define CPUTOPOLOGY_H
+
+#include "SystemSnapshot.h"
+#include <vector>
+
+/**
+ * @brief CPU 拓撲 (插槽、實體核心、SMT 執行緒、混合架構的 P/E 核心)
+ * 建立時讀取一次 (Linux: /sys/devices/system/cpu/cpuN/topology 與 cpu_capacity，
+ * Intel 混合架構另讀 /sys/devices/cpu_atom/cpus；Windows: GetLogicalProcessorInformationEx)，
+ * 之後不再變動：CPU 熱插拔後新上線的處理器不會被歸類。
+ *
+ * 每次取樣以 aggregate() 對「邏輯處理器 -> 拓撲位置」陣列做一次走訪，
+ * 同時累加到實體核心、插槽與核心類型三個層級。
+ */
+class CpuTopology
+{
+public:
+    CpuTopology();
+
+    /** @brief 是否取得了拓撲資訊 */
+    bool isValid() const { return !m_threads.empty(); }
+
+    /**
+     * @brief Windows 的 PDH 以 "(處理器群組,群組內編號)" 命名處理器實例
+     * 回傳邏輯處理器 index 對應的群組與群組內編號 (其他平台為 (0, index))
+     */
+    static void groupIndex(int index, int &group, int &number);
+
+    /** @brief 依 cpu.coreUsage / cpu.coreMhz 彙總，寫入 out */
+    void aggregate(const CpuSample &cpu, CpuTopologySample &out) const;
+
+private:
+    struct Thread {
+        qint16 core = -1;         // 實體核心索引 (排序後)，-1 代表離線或未知
+    };
+    struct Core {
+        quint8 package = 0;
+        quint8 type = CpuTopologySample::Performance;
+    };
+
+    /** @brief 由各邏輯處理器的 (插槽、類型、核心鍵值) 建立排序後的核心表 */
+    struct RawThread {
+        int cpu;
+        int package;
+        int type;
+        qint64 coreKey;           // 同一插槽內識別實體核心 (Linux 為 die_id 與 core_id 的組合)
+    };
+    void build(std::vector<RawThread> &raw);
+    void load();
+
+    std::vector<Thread> m_threads; // 依邏輯處理器編號
+    std::vector<Core> m_cores;
+    int m_packageCount = 0;
+    bool m_hybrid = false;
+};
+
+#endif // CPUTOPOLOGY_H
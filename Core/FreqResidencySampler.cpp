@@ -0,0 +1,186 @@
+#include "FreqResidencySampler.h"
+
+#ifdef Q_OS_LINUX
+#include <QStringList>
+#include <algorithm>
+#include <dirent.h>
+
+namespace {
+// 時間窗內最多保留的畫格數；時間窗起點的誤差最多為 時間窗 / kFrameCount
+constexpr int kFrameCount = 60;
+
+const char kCpufreqRoot[] = "/sys/devices/system/cpu/cpufreq/";
+
+// "0 1 2 3 6" -> "0-3,6"
+QString formatCpuList(const std::vector<int> &cpus) {
+    QStringList parts;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t end = i;
+        while (end + 1 < cpus.size() && cpus[end + 1] == cpus[end] + 1) ++end;
+        parts << (end == i ? QString::number(cpus[i]) : QString("%1-%2").arg(cpus[i]).arg(cpus[end]));
+        i = end + 1;
+    }
+    return parts.join(',');
+}
+}
+
+FreqResidencySampler::FreqResidencySampler() {
+    m_frames.resize(kFrameCount);
+    discover();
+}
+
+void FreqResidencySampler::discover() {
+    std::vector<int> ids;
+    if (DIR *dir = opendir(kCpufreqRoot)) {
+        while (dirent *ent = readdir(dir)) {
+            const std::string_view name(ent->d_name);
+            quint64 id;
+            if (ProcText::startsWith(name, "policy") && ProcText::toU64(name.substr(6), id)) ids.push_back(int(id));
+        }
+        closedir(dir);
+    }
+    std::sort(ids.begin(), ids.end());
+
+    m_corePolicy.clear();
+    for (int id : ids) {
+        if (int(m_policies.size()) >= SnapshotLimits::kMaxFreqPolicies) break;
+        const std::string base = kCpufreqRoot + std::string("policy") + std::to_string(id) + "/";
+        Policy policy;
+        // 沒有頻率表的驅動不提供 stats
+        if (!policy.timeInState.open(base + "stats/time_in_state")) continue;
+
+        std::vector<int> cpus;
+        ProcFile related(base + "related_cpus");
+        std::string_view text = related.read();
+        std::string_view token;
+        quint64 cpu;
+        while (ProcText::nextToken(text, token)) {
+            if (ProcText::toU64(token, cpu) && cpu < quint64(SnapshotLimits::kMaxCores)) cpus.push_back(int(cpu));
+        }
+        if (cpus.empty()) cpus.push_back(id); // policy 編號即為其第一個 CPU
+        policy.cpus.set(formatCpuList(cpus));
+
+        const qint16 index = qint16(m_policies.size());
+        for (int c : cpus) {
+            if (c >= int(m_corePolicy.size())) m_corePolicy.resize(c + 1, -1);
+            m_corePolicy[c] = index;
+        }
+        m_policies.push_back(std::move(policy));
+    }
+}
+
+bool FreqResidencySampler::readPolicy(Policy &policy) {
+    std::string_view text = policy.timeInState.read();
+    if (text.empty()) return true; // 讀取失敗 (例如 policy 內的 CPU 全部離線)：沿用上一次的累計值
+
+    bool same = true;
+    size_t line = 0;
+    std::string_view row;
+    while (ProcText::nextLine(text, row) && line < size_t(SnapshotLimits::kMaxFreqSteps)) {
+        quint64 kHz, time;
+        if (!ProcText::nextU64(row, kHz) || !ProcText::nextU64(row, time)) continue;
+        if (line >= policy.kHz.size()) {
+            policy.kHz.push_back(kHz);
+            policy.times.push_back(time);
+            same = false;
+        } else {
+            if (policy.kHz[line] != kHz) {
+                policy.kHz[line] = kHz;
+                same = false;
+            }
+            policy.times[line] = time;
+        }
+        ++line;
+    }
+    if (line != policy.kHz.size()) {
+        policy.kHz.resize(line);
+        policy.times.resize(line);
+        same = false;
+    }
+    return same;
+}
+
+void FreqResidencySampler::relayout() {
+    int offset = 0;
+    for (Policy &policy : m_policies) {
+        policy.offset = offset;
+        offset += int(policy.kHz.size());
+
+        policy.ascending.resize(policy.kHz.size());
+        for (size_t i = 0; i < policy.ascending.size(); ++i) policy.ascending[i] = quint8(i);
+        std::sort(policy.ascending.begin(), policy.ascending.end(), [&policy](quint8 a, quint8 b) {
+            return policy.kHz[a] < policy.kHz[b];
+        });
+    }
+    m_current.times.assign(size_t(offset), 0);
+    m_frameCount = 0; // 舊畫格的排列已不適用
+}
+
+const FreqResidencySampler::Frame *FreqResidencySampler::baseFrame(qint64 nowNs, qint64 windowNs) const {
+    // 由舊到新找第一個落在時間窗內的畫格；都太舊時退而使用最新的一個
+    const Frame *newestOlder = nullptr;
+    for (int i = m_frameCount - 1; i >= 0; --i) {
+        const Frame &frame = m_frames[(m_head - i + kFrameCount) % kFrameCount];
+        if (frame.ns >= nowNs) break;
+        if (nowNs - frame.ns <= windowNs) return &frame;
+        newestOlder = &frame;
+    }
+    return newestOlder;
+}
+
+void FreqResidencySampler::sample(FreqResidencySample &out, int windowSec) {
+    const qint64 nowNs = ProcText::monotonicNs();
+    const qint64 windowNs = qint64(qMax(1, windowSec)) * 1000000000LL;
+
+    bool same = true;
+    for (Policy &policy : m_policies) same = readPolicy(policy) && same;
+    if (!same) relayout();
+    for (const Policy &policy : m_policies) {
+        std::copy(policy.times.begin(), policy.times.end(), m_current.times.begin() + policy.offset);
+    }
+    m_current.ns = nowNs;
+
+    const Frame *base = baseFrame(nowNs, windowNs);
+    out.windowSec = windowSec;
+    out.coveredSec = base ? float(double(nowNs - base->ns) / 1e9) : 0.0f;
+    out.policyCount = int(m_policies.size());
+    for (int p = 0; p < out.policyCount; ++p) {
+        const Policy &policy = m_policies[p];
+        FreqPolicySample &target = out.policies[p];
+        target.cpus = policy.cpus;
+        target.stepCount = int(policy.kHz.size());
+
+        quint64 total = 0;
+        for (int i = 0; i < target.stepCount; ++i) {
+            const int line = policy.ascending[i];
+            const quint64 cur = policy.times[line];
+            const quint64 prev = base ? base->times[size_t(policy.offset + line)] : cur;
+            total += cur >= prev ? cur - prev : 0;
+        }
+
+        double weighted = 0.0;
+        for (int i = 0; i < target.stepCount; ++i) {
+            const int line = policy.ascending[i];
+            const quint64 cur = policy.times[line];
+            const quint64 prev = base ? base->times[size_t(policy.offset + line)] : cur;
+            const double share = total > 0 && cur >= prev ? double(cur - prev) / double(total) : 0.0;
+            target.stepMhz[i] = float(policy.kHz[line] / 1000.0);
+            target.residency[i] = float(share * 100.0);
+            weighted += share * target.stepMhz[i];
+        }
+        target.avgMhz = float(weighted);
+    }
+    out.coreCount = qMin<int>(int(m_corePolicy.size()), SnapshotLimits::kMaxCores);
+    std::copy(m_corePolicy.begin(), m_corePolicy.begin() + out.coreCount, out.corePolicy);
+    out.valid = base != nullptr && out.policyCount > 0;
+
+    // 畫格間隔 = 時間窗 / kFrameCount；最新畫格未滿間隔時不新增
+    if (m_frameCount == 0 || nowNs - m_frames[m_head].ns >= windowNs / kFrameCount) {
+        m_head = (m_head + 1) % kFrameCount;
+        m_frames[m_head].ns = nowNs;
+        m_frames[m_head].times = m_current.times; // 容量重複使用
+        m_frameCount = qMin(m_frameCount + 1, kFrameCount);
+    }
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,56 @@
+#ifndef FREQRESIDENCYSAMPLER_H
+#define FREQRESIDENCYSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Linux 各 cpufreq policy 的頻率停留分佈 (/sys/devices/system/cpu/cpufreq/policyN/stats/time_in_state)
+ * time_in_state 每行為「頻率 (kHz) 累計時間 (10 ms)」；同一 policy 的 CPU 共用一份。
+ *
+ * 每次取樣把所有 policy 的累計值存成一個畫格，時間窗內的分佈 = 最新畫格 - 時間窗起點的畫格。
+ * 畫格數量固定 (kFrameCount)，時間窗越長畫格間隔越大，記憶體用量與時間窗長度無關。
+ * 檔位數改變 (例如切換 boost) 時捨棄舊畫格重新累計。
+ */
+class FreqResidencySampler
+{
+public:
+    FreqResidencySampler();
+
+    /** @param windowSec 時間窗長度 (秒) */
+    void sample(FreqResidencySample &out, int windowSec);
+
+private:
+    struct Policy {
+        ProcFile timeInState;
+        SampleName cpus;
+        int offset = 0;                // 在畫格中的起始位置
+        std::vector<quint64> kHz;      // 依檔案順序 (驅動的頻率表順序，不一定遞增)
+        std::vector<quint64> times;    // 最近一次讀到的累計時間，讀取失敗時沿用
+        std::vector<quint8> ascending; // 依頻率遞增排列的行索引
+    };
+
+    struct Frame {
+        qint64 ns = 0;
+        std::vector<quint64> times;    // 所有 policy 的累計時間，依 Policy::offset 排列
+    };
+
+    void discover();
+    bool readPolicy(Policy &policy);   // 回傳 false 代表檔位改變
+    void relayout();
+    const Frame *baseFrame(qint64 nowNs, qint64 windowNs) const;
+
+    std::vector<Policy> m_policies;
+    std::vector<qint16> m_corePolicy;
+    std::vector<Frame> m_frames;       // 環狀緩衝區 (kFrameCount 個)
+    int m_head = -1;                   // 最新畫格
+    int m_frameCount = 0;              // 有效畫格數
+    Frame m_current;
+};
+#endif // Q_OS_LINUX
+
+#endif // FREQRESIDENCYSAMPLER_H
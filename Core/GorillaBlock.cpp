@@ -0,0 +1,228 @@
+#include "GorillaBlock.h"
+#include <cstring>
+
+namespace {
+inline quint32 floatBits(float value) {
+    quint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float bitsFloat(quint32 bits) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+inline quint64 lowMask(int bits) {
+    return bits >= 64 ? ~quint64(0) : (quint64(1) << bits) - 1;
+}
+
+// 將 bits 位元的二補數還原為有號整數
+inline qint64 signExtend(quint64 value, int bits) {
+    const quint64 sign = quint64(1) << (bits - 1);
+    return static_cast<qint64>((value ^ sign) - sign);
+}
+
+inline int leadingZeros32(quint32 value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clz(value);
+#else
+    int n = 0;
+    while (!(value & 0x80000000u)) { value <<= 1; ++n; }
+    return n;
+#endif
+}
+
+inline int trailingZeros32(quint32 value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(value);
+#else
+    int n = 0;
+    while (!(value & 1u)) { value >>= 1; ++n; }
+    return n;
+#endif
+}
+
+// delta-of-delta 的分級：前綴 '0' / '10' / '110' / '1110' / '1111'
+struct DodBucket {
+    int prefixBits;
+    quint64 prefix;
+    int valueBits;
+};
+constexpr DodBucket kDodBuckets[] = {
+    {2, 0b10, 7},       // [-64, 63]
+    {3, 0b110, 9},      // [-256, 255]
+    {4, 0b1110, 12},    // [-2048, 2047]
+    {4, 0b1111, 64},    // 其他 (例如休眠後的長時間中斷)
+};
+}
+
+GorillaBlock::GorillaBlock(int channels)
+    : m_channels(qBound(1, channels, kMaxChannels)) {
+    for (int i = 0; i < kMaxChannels; ++i) m_prevLeading[i] = -1;
+}
+
+/** --- 編碼 --- **/
+
+void GorillaBlock::writeBits(quint64 value, int bits) {
+    if (bits <= 0) return;
+    value &= lowMask(bits);
+
+    const int offset = static_cast<int>(m_bitCount & 63);
+    if (offset == 0) m_words.push_back(0);
+
+    const int space = 64 - offset;
+    if (bits <= space) {
+        m_words.back() |= value << (space - bits);
+    } else {
+        const int rest = bits - space;
+        m_words.back() |= value >> rest;
+        m_words.push_back(value << (64 - rest));
+    }
+    m_bitCount += bits;
+}
+
+void GorillaBlock::writeTimestamp(qint64 timestampMs) {
+    const qint64 delta = timestampMs - m_prevTimestamp;
+    const qint64 dod = delta - m_prevDelta;
+    m_prevTimestamp = timestampMs;
+    m_prevDelta = delta;
+
+    if (dod == 0) {
+        writeBits(0, 1);
+        return;
+    }
+    for (const DodBucket &bucket : kDodBuckets) {
+        const bool fits = bucket.valueBits == 64
+            || (dod >= -(qint64(1) << (bucket.valueBits - 1)) && dod < (qint64(1) << (bucket.valueBits - 1)));
+        if (fits) {
+            writeBits(bucket.prefix, bucket.prefixBits);
+            writeBits(static_cast<quint64>(dod), bucket.valueBits);
+            return;
+        }
+    }
+}
+
+void GorillaBlock::writeValue(int channel, quint32 bits) {
+    const quint32 xored = bits ^ m_prevValue[channel];
+    m_prevValue[channel] = bits;
+
+    if (xored == 0) {
+        writeBits(0, 1);   // 數值未變化
+        return;
+    }
+    writeBits(1, 1);
+
+    const int leading = qMin(leadingZeros32(xored), 31);   // 5 位元可表示的上限
+    const int trailing = trailingZeros32(xored);
+    int &prevLeading = m_prevLeading[channel];
+    int &prevTrailing = m_prevTrailing[channel];
+
+    if (prevLeading >= 0 && leading >= prevLeading && trailing >= prevTrailing) {
+        // 有效位元落在上一個視窗內，沿用視窗
+        writeBits(0, 1);
+        writeBits(xored >> prevTrailing, 32 - prevLeading - prevTrailing);
+    } else {
+        const int meaningful = 32 - leading - trailing;
+        writeBits(1, 1);
+        writeBits(leading, 5);
+        writeBits(meaningful - 1, 5);   // 1..32 存成 0..31
+        writeBits(xored >> trailing, meaningful);
+        prevLeading = leading;
+        prevTrailing = trailing;
+    }
+}
+
+bool GorillaBlock::append(qint64 timestampMs, const float *values) {
+    if (m_count == 0) {
+        // 區塊標頭：完整的第一個時間戳與數值
+        m_firstTimestamp = m_prevTimestamp = timestampMs;
+        m_prevDelta = 0;
+        writeBits(static_cast<quint64>(timestampMs), 64);
+        for (int c = 0; c < m_channels; ++c) {
+            m_prevValue[c] = floatBits(values[c]);
+            writeBits(m_prevValue[c], 32);
+        }
+        ++m_count;
+        return true;
+    }
+
+    if (timestampMs <= m_prevTimestamp) return false;
+
+    writeTimestamp(timestampMs);
+    for (int c = 0; c < m_channels; ++c) {
+        writeValue(c, floatBits(values[c]));
+    }
+    ++m_count;
+    return true;
+}
+
+void GorillaBlock::seal() {
+    m_words.shrink_to_fit();
+}
+
+/** --- 解碼 --- **/
+
+GorillaBlock::Reader::Reader(const GorillaBlock &block) : m_block(block) {
+    for (int i = 0; i < kMaxChannels; ++i) m_prevLeading[i] = -1;
+}
+
+quint64 GorillaBlock::Reader::readBits(int bits) {
+    if (bits <= 0) return 0;
+
+    const std::vector<quint64> &words = m_block.m_words;
+    const size_t word = static_cast<size_t>(m_pos >> 6);
+    const int offset = static_cast<int>(m_pos & 63);
+    const int available = 64 - offset;
+    m_pos += bits;
+
+    if (bits <= available) {
+        return (words[word] << offset) >> (64 - bits);
+    }
+    const int rest = bits - available;
+    const quint64 high = (words[word] << offset) >> offset;
+    return (high << rest) | (words[word + 1] >> (64 - rest));
+}
+
+bool GorillaBlock::Reader::next(qint64 &timestampMs, float *values) {
+    if (m_index >= m_block.m_count) return false;
+
+    if (m_index == 0) {
+        m_prevTimestamp = static_cast<qint64>(readBits(64));
+        m_prevDelta = 0;
+        for (int c = 0; c < m_block.m_channels; ++c) {
+            m_prevValue[c] = static_cast<quint32>(readBits(32));
+        }
+    } else {
+        // 時間戳：依前綴判斷 delta-of-delta 的位元數
+        qint64 dod = 0;
+        if (readBit()) {
+            int bucket = 0;
+            while (bucket < 3 && readBit()) ++bucket;
+            const int valueBits = kDodBuckets[bucket].valueBits;
+            dod = signExtend(readBits(valueBits), valueBits);
+        }
+        m_prevDelta += dod;
+        m_prevTimestamp += m_prevDelta;
+
+        for (int c = 0; c < m_block.m_channels; ++c) {
+            if (!readBit()) continue;   // 數值未變化
+
+            if (readBit()) {
+                m_prevLeading[c] = static_cast<int>(readBits(5));
+                const int meaningful = static_cast<int>(readBits(5)) + 1;
+                m_prevTrailing[c] = 32 - m_prevLeading[c] - meaningful;
+            }
+            const int meaningful = 32 - m_prevLeading[c] - m_prevTrailing[c];
+            m_prevValue[c] ^= static_cast<quint32>(readBits(meaningful)) << m_prevTrailing[c];
+        }
+    }
+
+    timestampMs = m_prevTimestamp;
+    for (int c = 0; c < m_block.m_channels; ++c) {
+        values[c] = bitsFloat(m_prevValue[c]);
+    }
+    ++m_index;
+    return true;
+}
@@ -0,0 +1,81 @@
+#ifndef GORILLABLOCK_H
+#define GORILLABLOCK_H
+
+#include <QtGlobal>
+#include <vector>
+
+/**
+ * @brief Gorilla 壓縮時間序列區塊 (Facebook Gorilla, VLDB 2015)
+ * 時間戳使用 delta-of-delta 編碼，數值以與前一筆 XOR 後只保存有效位元。
+ * 規律取樣的時間戳每筆只需 1 bit，未變化的數值也只需 1 bit。
+ *
+ * 每一筆資料可包含多個通道 (例如 min/avg/max)，共用同一個時間戳，
+ * 各通道各自維護 XOR 狀態。數值為 32 位元 float，與 MetricPoint 一致。
+ *
+ * 只能依時間順序附加；讀取時使用 Reader 逐筆串流解碼，不需展開整個區塊。
+ */
+class GorillaBlock
+{
+public:
+    static constexpr int kMaxChannels = 4;
+
+    explicit GorillaBlock(int channels = 1);
+
+    /** @brief 附加一筆資料，timestampMs 必須大於上一筆，否則回傳 false */
+    bool append(qint64 timestampMs, const float *values);
+    bool append(qint64 timestampMs, float value) { return append(timestampMs, &value); }
+
+    /** @brief 不再附加資料時呼叫，釋放多餘的緩衝容量 */
+    void seal();
+
+    int channels() const { return m_channels; }
+    int count() const { return m_count; }
+    bool isEmpty() const { return m_count == 0; }
+    qint64 firstTimestamp() const { return m_firstTimestamp; }
+    qint64 lastTimestamp() const { return m_prevTimestamp; }
+    size_t sizeBytes() const { return (m_bitCount + 7) / 8; }
+
+    /** @brief 串流解碼器，區塊在讀取期間不可修改 */
+    class Reader
+    {
+    public:
+        explicit Reader(const GorillaBlock &block);
+
+        /** @brief 解碼下一筆，values 需至少有 channels() 個元素；沒有資料時回傳 false */
+        bool next(qint64 &timestampMs, float *values);
+
+    private:
+        quint64 readBits(int bits);
+        bool readBit() { return readBits(1) != 0; }
+
+        const GorillaBlock &m_block;
+        quint64 m_pos = 0;
+        int m_index = 0;
+        qint64 m_prevTimestamp = 0;
+        qint64 m_prevDelta = 0;
+        quint32 m_prevValue[kMaxChannels] = {};
+        int m_prevLeading[kMaxChannels] = {};
+        int m_prevTrailing[kMaxChannels] = {};
+    };
+
+    Reader reader() const { return Reader(*this); }
+
+private:
+    void writeBits(quint64 value, int bits);
+    void writeTimestamp(qint64 timestampMs);
+    void writeValue(int channel, quint32 bits);
+
+    std::vector<quint64> m_words;   // 位元串流，每個 word 由高位元往低位元填
+    quint64 m_bitCount = 0;
+
+    int m_channels;
+    int m_count = 0;
+    qint64 m_firstTimestamp = 0;
+    qint64 m_prevTimestamp = 0;
+    qint64 m_prevDelta = 0;
+    quint32 m_prevValue[kMaxChannels] = {};
+    int m_prevLeading[kMaxChannels] = {};   // -1 代表尚未建立有效位元視窗
+    int m_prevTrailing[kMaxChannels] = {};
+};
+
+#endif // GORILLABLOCK_H
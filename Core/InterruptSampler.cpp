@@ -0,0 +1,158 @@
+#include "InterruptSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <algorithm>
+#include <cstring>
+
+namespace {
+void setName(SampleName &name, std::string_view first, std::string_view second) {
+    // 只在列第一次出現時呼叫，直接寫入固定長度欄位
+    size_t length = qMin(first.size(), size_t(SnapshotLimits::kNameLength - 1));
+    std::memcpy(name.text, first.data(), length);
+    if (!second.empty() && length + 1 < size_t(SnapshotLimits::kNameLength - 1)) {
+        name.text[length++] = ' ';
+        const size_t extra = qMin(second.size(), size_t(SnapshotLimits::kNameLength - 1) - length);
+        std::memcpy(name.text + length, second.data(), extra);
+        length += extra;
+    }
+    name.text[length] = '\0';
+}
+}
+
+void InterruptSampler::describe(Row &row, std::string_view label, std::string_view rest, bool hasDevice) {
+    row.label.assign(label.data(), label.size());
+    row.hasBaseline = false;
+
+    std::string_view device;
+    if (hasDevice) {
+        // 數字編號的列：「晶片  hwirq-觸發方式  裝置1, 裝置2」，裝置名稱在最後一段連續空白之後；
+        // LOC、RES 等具名的列則整段都是說明
+        device = ProcText::trim(rest);
+        const bool numbered = !label.empty() && label.front() >= '0' && label.front() <= '9';
+        const size_t gap = device.rfind("  ");
+        if (numbered && gap != std::string_view::npos) device = ProcText::trim(device.substr(gap));
+    }
+    setName(row.name, label, device);
+}
+
+double InterruptSampler::parse(Table &table, float *perCpu, int &cpuCount) {
+    std::string_view text = table.file.read();
+    std::string_view line;
+    if (!ProcText::nextLine(text, line)) return 0.0;
+
+    // 標題列：CPU0 CPU1 ... (CPU 上線或離線時欄位改變，全部重新建立)
+    std::vector<int> &columns = table.columnCpu;
+    size_t columnCount = 0;
+    bool columnsChanged = false;
+    std::string_view token;
+    while (ProcText::nextToken(line, token)) {
+        quint64 cpu;
+        if (!ProcText::startsWith(token, "CPU") || !ProcText::toU64(token.substr(3), cpu)) continue;
+        if (columnCount >= columns.size()) {
+            columns.push_back(int(cpu));
+            columnsChanged = true;
+        } else if (columns[columnCount] != int(cpu)) {
+            columns[columnCount] = int(cpu);
+            columnsChanged = true;
+        }
+        ++columnCount;
+    }
+    if (columnCount != columns.size()) {
+        columns.resize(columnCount);
+        columnsChanged = true;
+    }
+    if (columnsChanged) table.rows.clear();
+
+    for (int cpu : columns) {
+        if (cpu < SnapshotLimits::kMaxCores) cpuCount = qMax(cpuCount, cpu + 1);
+    }
+
+    const qint64 readNs = table.file.readTimeNs();
+    const double elapsedSec = table.prevReadNs > 0 ? double(readNs - table.prevReadNs) / 1e9 : 0.0;
+    table.prevReadNs = readNs;
+
+    size_t rowIndex = 0;
+    while (ProcText::nextLine(text, line)) {
+        const size_t colon = line.find(':');
+        if (colon == std::string_view::npos) continue;
+        const std::string_view label = ProcText::trim(line.substr(0, colon));
+        std::string_view rest = line.substr(colon + 1);
+
+        if (rowIndex >= table.rows.size()) {
+            table.rows.emplace_back();
+            table.counts.resize(table.rows.size() * columnCount);
+        }
+        Row &row = table.rows[rowIndex];
+        const bool relearn = row.label != label;
+
+        // 逐欄讀入並就地計算差值；ERR、MIS 等只有一個數值的列，其餘欄位視為 0
+        quint64 *counts = table.counts.data() + rowIndex * columnCount;
+        const bool comparable = row.hasBaseline && !relearn && elapsedSec > 0.0;
+        row.delta = 0;
+        for (size_t c = 0; c < columnCount; ++c) {
+            std::string_view probe = rest;
+            quint64 value = 0;
+            if (ProcText::nextToken(probe, token) && ProcText::toU64(token, value)) rest = probe;
+            if (comparable && value >= counts[c]) {
+                const quint64 delta = value - counts[c];
+                row.delta += delta;
+                if (columns[c] < SnapshotLimits::kMaxCores) perCpu[columns[c]] += float(double(delta) / elapsedSec);
+            }
+            counts[c] = value;
+        }
+
+        if (relearn) describe(row, label, rest, table.describe);
+        row.hasBaseline = true;
+        ++rowIndex;
+    }
+    table.rows.resize(rowIndex);
+    table.counts.resize(rowIndex * columnCount);
+    return elapsedSec;
+}
+
+void InterruptSampler::sample(InterruptSample &out) {
+    const qint64 startNs = ProcText::monotonicNs();
+    std::fill(std::begin(out.irqPerSec), std::end(out.irqPerSec), 0.0f);
+    std::fill(std::begin(out.softirqPerSec), std::end(out.softirqPerSec), 0.0f);
+    out.cpuCount = 0;
+
+    const double irqElapsed = parse(m_interrupts, out.irqPerSec, out.cpuCount);
+    const double softirqElapsed = parse(m_softirqs, out.softirqPerSec, out.cpuCount);
+    out.valid = irqElapsed > 0.0 || softirqElapsed > 0.0;
+
+    // 中斷來源依本輪速率排序，只取前幾名
+    out.totalIrqPerSec = 0.0;
+    m_ranked.clear();
+    const std::vector<Row> &irqs = m_interrupts.rows;
+    for (size_t i = 0; i < irqs.size(); ++i) {
+        if (irqs[i].delta == 0) continue;
+        m_ranked.push_back(int(i));
+        out.totalIrqPerSec += double(irqs[i].delta);
+    }
+    const size_t topCount = qMin<size_t>(m_ranked.size(), SnapshotLimits::kMaxTopIrqs);
+    std::partial_sort(m_ranked.begin(), m_ranked.begin() + static_cast<std::ptrdiff_t>(topCount), m_ranked.end(),
+                      [&irqs](int a, int b) { return irqs[a].delta > irqs[b].delta; });
+
+    out.irqSourceCount = int(irqs.size());
+    out.topCount = irqElapsed > 0.0 ? int(topCount) : 0;
+    for (int i = 0; i < out.topCount; ++i) {
+        const Row &row = irqs[m_ranked[i]];
+        out.top[i].name = row.name;
+        out.top[i].perSec = double(row.delta) / irqElapsed;
+    }
+    out.totalIrqPerSec = irqElapsed > 0.0 ? out.totalIrqPerSec / irqElapsed : 0.0;
+
+    // softirq 種類固定 (約 10 種)，全部列出
+    const std::vector<Row> &softirqs = m_softirqs.rows;
+    out.softirqTypeCount = qMin<int>(int(softirqs.size()), SnapshotLimits::kMaxSoftirqTypes);
+    out.totalSoftirqPerSec = 0.0;
+    for (int i = 0; i < out.softirqTypeCount; ++i) {
+        out.softirqNames[i] = softirqs[i].name;
+        out.softirqTypePerSec[i] = softirqElapsed > 0.0 ? double(softirqs[i].delta) / softirqElapsed : 0.0;
+        out.totalSoftirqPerSec += out.softirqTypePerSec[i];
+    }
+
+    out.scanMicros = (ProcText::monotonicNs() - startNs) / 1000;
+}
+
+#endif // Q_OS_LINUX
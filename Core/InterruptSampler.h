@@ -0,0 +1,55 @@
+#ifndef INTERRUPTSAMPLER_H
+#define INTERRUPTSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <vector>
+
+/**
+ * @brief Linux 中斷與 softirq 速率 (/proc/interrupts、/proc/softirqs)
+ * 兩個檔案都是「列 (中斷來源) × 欄 (CPU)」的矩陣，格式相同，以同一個 Table 解析：
+ * 欄位對應的 CPU 編號取自標題列 (離線的 CPU 不會出現)，
+ * 計數存放在預先配置的 列 × 欄 陣列中，每個數值讀入時就地與上一輪相減，
+ * 差值同時累加到該 CPU 與該列的合計，不另外建立暫存矩陣。
+ *
+ * 每一列的標籤與顯示名稱只在第一次看到 (或該位置的標籤改變) 時建立；
+ * 中斷來源增減造成後面的列位移時，位移的列重新建立基準，該輪不計入速率。
+ */
+class InterruptSampler
+{
+public:
+    void sample(InterruptSample &out);
+
+private:
+    struct Row {
+        std::string label;        // ':' 之前的部分 (例如 "24"、"LOC"、"NET_RX")
+        SampleName name;          // 顯示名稱
+        quint64 delta = 0;        // 本輪所有 CPU 的差值合計
+        bool hasBaseline = false;
+    };
+
+    struct Table {
+        ProcFile file;
+        std::vector<int> columnCpu;   // 欄 -> CPU 編號
+        std::vector<Row> rows;
+        std::vector<quint64> counts;  // rows.size() × columnCpu.size()
+        qint64 prevReadNs = 0;
+        bool describe = false;        // /proc/interrupts 的列尾有裝置說明
+    };
+
+    /**
+     * @brief 解析一個矩陣並把各 CPU 的差值累加到 perCpu
+     * @return 與上一次解析的間隔 (秒)，沒有基準時為 0
+     */
+    static double parse(Table &table, float *perCpu, int &cpuCount);
+    static void describe(Row &row, std::string_view label, std::string_view rest, bool hasDevice);
+
+    Table m_interrupts{ProcFile("/proc/interrupts"), {}, {}, {}, 0, true};
+    Table m_softirqs{ProcFile("/proc/softirqs"), {}, {}, {}, 0, false};
+    std::vector<int> m_ranked;
+};
+#endif // Q_OS_LINUX
+
+#endif // INTERRUPTSAMPLER_H
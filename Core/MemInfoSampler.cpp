@@ -0,0 +1,105 @@
+#include "MemInfoSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <algorithm>
+#include <cstring>
+#include <dirent.h>
+#include <iterator>
+
+namespace {
+// 槽位依 MemInfoSampler::MemField / VmField 的順序
+const ProcKeyTable::Key kMemKeys[] = {
+    {"MemTotal", 0}, {"MemAvailable", 1}, {"Buffers", 2}, {"Cached", 3},
+    {"Dirty", 4}, {"Writeback", 5}, {"Slab", 6}, {"Shmem", 7},
+    {"SwapTotal", 8}, {"SwapFree", 9}, {"Zswap", 10}, {"Zswapped", 11},
+};
+const ProcKeyTable::Key kVmKeys[] = {
+    {"pgfault", 0}, {"pgmajfault", 1}, {"pswpin", 2}, {"pswpout", 3},
+};
+constexpr quint64 kKiB = 1024;
+}
+
+MemInfoSampler::MemInfoSampler()
+    : m_meminfo("/proc/meminfo"), m_vmstat("/proc/vmstat"),
+      m_memKeys(kMemKeys, std::size(kMemKeys), ':'), m_vmKeys(kVmKeys, std::size(kVmKeys), ' ') {
+    static_assert(std::size(kMemKeys) == MemFieldCount, "kMemKeys must cover MemField");
+    static_assert(std::size(kVmKeys) == VmFieldCount, "kVmKeys must cover VmField");
+
+    // zram 裝置通常在開機時由 zram-generator 建立，之後不再變動
+    if (DIR *dir = opendir("/sys/block")) {
+        while (dirent *ent = readdir(dir)) {
+            if (std::strncmp(ent->d_name, "zram", 4) != 0) continue;
+            ProcFile file(std::string("/sys/block/") + ent->d_name + "/mm_stat");
+            if (file.isOpen()) m_zram.push_back(std::move(file));
+        }
+        closedir(dir);
+    }
+}
+
+void MemInfoSampler::sample(MemorySample &out) {
+    // 缺少的欄位 (舊核心沒有 MemAvailable，未啟用 zswap 時沒有 Zswap) 視為 0
+    std::fill(std::begin(m_mem), std::end(m_mem), 0);
+    if (m_memKeys.parse(m_meminfo.read(), m_mem) == 0 || m_mem[MemTotal] == 0) {
+        out.valid = false;
+        out.hasBreakdown = false;
+        return;
+    }
+
+    const quint64 total = m_mem[MemTotal] * kKiB;
+    const quint64 available = qMin(m_mem[MemAvailable] * kKiB, total);
+    out.valid = true;
+    out.totalBytes = total;
+    out.availableBytes = available;
+    out.loadPercent = static_cast<int>((total - available) * 100 / total);
+
+    out.hasBreakdown = true;
+    out.cachedBytes = m_mem[Cached] * kKiB;
+    out.buffersBytes = m_mem[Buffers] * kKiB;
+    out.dirtyBytes = m_mem[Dirty] * kKiB;
+    out.writebackBytes = m_mem[Writeback] * kKiB;
+    out.slabBytes = m_mem[Slab] * kKiB;
+    out.shmemBytes = m_mem[Shmem] * kKiB;
+    out.swapTotalBytes = m_mem[SwapTotal] * kKiB;
+    out.swapUsedBytes = m_mem[SwapTotal] > m_mem[SwapFree] ? (m_mem[SwapTotal] - m_mem[SwapFree]) * kKiB : 0;
+    out.zswapBytes = m_mem[Zswap] * kKiB;
+    out.zswappedBytes = m_mem[Zswapped] * kKiB;
+    sampleZram(out);
+
+    // vmstat 為開機後的累計值：第一次只建立基準
+    if (m_vmKeys.parse(m_vmstat.read(), m_vm) == 0) {
+        out.hasVmstat = false;
+        return;
+    }
+    const qint64 nowNs = m_vmstat.readTimeNs();
+    const double elapsedSec = m_prevVmNs > 0 ? double(nowNs - m_prevVmNs) / 1e9 : 0.0;
+    out.hasVmstat = elapsedSec > 0.0;
+    if (out.hasVmstat) {
+        auto rate = [&](VmField field) {
+            return m_vm[field] >= m_prevVm[field] ? double(m_vm[field] - m_prevVm[field]) / elapsedSec : 0.0;
+        };
+        out.pageFaultsPerSec = rate(PgFault);
+        out.majorFaultsPerSec = rate(PgMajFault);
+        out.swapInPerSec = rate(PswpIn);
+        out.swapOutPerSec = rate(PswpOut);
+    }
+    std::copy(std::begin(m_vm), std::end(m_vm), std::begin(m_prevVm));
+    m_prevVmNs = nowNs;
+}
+
+void MemInfoSampler::sampleZram(MemorySample &out) {
+    // mm_stat: orig_data_size compr_data_size mem_used_total mem_limit ...
+    out.zramBytes = 0;
+    out.zramDataBytes = 0;
+    for (ProcFile &file : m_zram) {
+        std::string_view fields = file.read();
+        quint64 original = 0, compressed = 0, used = 0;
+        if (!ProcText::nextU64(fields, original) || !ProcText::nextU64(fields, compressed) ||
+            !ProcText::nextU64(fields, used)) {
+            continue;
+        }
+        out.zramDataBytes += original;
+        out.zramBytes += used;
+    }
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,61 @@
+#ifndef MEMINFOSAMPLER_H
+#define MEMINFOSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <vector>
+
+/**
+ * @brief Linux 記憶體取樣 (/proc/meminfo、/proc/vmstat、zram mm_stat)
+ * 兩個 procfs 檔案都常駐開啟，每次取樣以 ProcKeyTable 做一次線性掃描，
+ * 只取出需要的欄位；vmstat 的累計計數以兩次讀取的差值換算為每秒速率。
+ * zram 裝置只在建立時探索一次。
+ */
+class MemInfoSampler
+{
+public:
+    MemInfoSampler();
+
+    void sample(MemorySample &out);
+
+private:
+    enum MemField {
+        MemTotal = 0,
+        MemAvailable,
+        Buffers,
+        Cached,
+        Dirty,
+        Writeback,
+        Slab,
+        Shmem,
+        SwapTotal,
+        SwapFree,
+        Zswap,
+        Zswapped,
+        MemFieldCount
+    };
+    enum VmField {
+        PgFault = 0,
+        PgMajFault,
+        PswpIn,
+        PswpOut,
+        VmFieldCount
+    };
+
+    void sampleZram(MemorySample &out);
+
+    ProcFile m_meminfo;
+    ProcFile m_vmstat;
+    ProcKeyTable m_memKeys;
+    ProcKeyTable m_vmKeys;
+    quint64 m_mem[MemFieldCount] = {};
+    quint64 m_vm[VmFieldCount] = {};
+    quint64 m_prevVm[VmFieldCount] = {};
+    qint64 m_prevVmNs = 0;
+    std::vector<ProcFile> m_zram;   // /sys/block/zram*/mm_stat
+};
+#endif // Q_OS_LINUX
+
+#endif // MEMINFOSAMPLER_H
@@ -0,0 +1,213 @@
+#include "MetricHistory.h"
+#include "SystemCollector.h"
+#include "SampleScheduler.h"
+#include <limits>
+
+namespace {
+struct TierSpec {
+    qint64 resolutionMs;
+    int capacity;
+};
+
+// 1 秒 -> 10 秒 -> 1 分鐘 -> 10 分鐘，每一層涵蓋的時間為 resolution * capacity
+constexpr TierSpec kTiers[] = {
+    {1000, 600},        // 10 分鐘
+    {10000, 360},       // 1 小時
+    {60000, 1440},      // 24 小時
+    {600000, 1008},     // 7 天
+};
+constexpr int kTierCount = sizeof(kTiers) / sizeof(kTiers[0]);
+
+// 冷資料層：來源為 1 分鐘層級
+constexpr int kMinuteTier = 2;
+constexpr int kColdBlockPoints = 120;                      // 每區塊 2 小時
+constexpr qint64 kColdRetentionMs = 7LL * 24 * 60 * 60 * 1000;
+}
+
+MetricHistory* MetricHistory::m_instance = nullptr;
+QMutex MetricHistory::m_mutex;
+
+MetricHistory::MetricHistory(QObject *parent) : QObject(parent) {
+    // 定期取出收集執行緒的取樣點，避免 SPSC 佇列滿溢；與小工具的更新合併在同一輪喚醒
+    SampleScheduler::instance()->addTask(this, 1000, [this]() { ingest(); });
+}
+
+MetricHistory* MetricHistory::instance() {
+    if (!m_instance) {
+        QMutexLocker locker(&m_mutex);
+        if (!m_instance) {
+            m_instance = new MetricHistory();
+        }
+    }
+    return m_instance;
+}
+
+/** --- 寫入 --- **/
+
+MetricHistory::Series &MetricHistory::seriesFor(quint32 key) {
+    auto it = m_series.find(key);
+    if (it == m_series.end()) {
+        // 第一次出現時一次配置所有層級，之後不再配置記憶體
+        Series series;
+        series.tiers.reserve(kTierCount);
+        for (const TierSpec &spec : kTiers) {
+            series.tiers.append(Tier{spec.resolutionMs, QVector<Bucket>(spec.capacity)});
+        }
+        it = m_series.insert(key, series);
+    }
+    return it.value();
+}
+
+void MetricHistory::append(quint32 key, qint64 timestampMs, float value) {
+    if (timestampMs < 0) return;
+
+    Series &series = seriesFor(key);
+    for (Tier &tier : series.tiers) {
+        const quint32 index = static_cast<quint32>(timestampMs / tier.resolutionMs);
+        Bucket &bucket = tier.buckets[index % tier.buckets.size()];
+
+        if (bucket.index != index) {
+            // 環狀緩衝轉了一圈 (或第一次寫入)：覆蓋舊的時間桶
+            bucket.index = index;
+            bucket.count = 1;
+            bucket.min = bucket.max = bucket.avg = value;
+        } else {
+            ++bucket.count;
+            bucket.min = qMin(bucket.min, value);
+            bucket.max = qMax(bucket.max, value);
+            bucket.avg += (value - bucket.avg) / bucket.count;
+        }
+    }
+    series.lastTimestamp = qMax(series.lastTimestamp, timestampMs);
+
+    // 進入新的一分鐘時，上一分鐘的時間桶已完整，寫入冷資料層
+    const quint32 minute = static_cast<quint32>(timestampMs / kTiers[kMinuteTier].resolutionMs);
+    if (minute != series.openMinute) {
+        flushMinute(series);
+        series.openMinute = minute;
+    }
+}
+
+void MetricHistory::flushMinute(Series &series) {
+    if (series.openMinute == 0xFFFFFFFFu) return;
+
+    const Tier &tier = series.tiers[kMinuteTier];
+    const Bucket &bucket = tier.buckets[series.openMinute % tier.buckets.size()];
+    if (bucket.index != series.openMinute || bucket.count == 0) return;
+
+    const qint64 timestampMs = qint64(series.openMinute) * tier.resolutionMs;
+    if (series.cold.isEmpty() || series.cold.last().count() >= kColdBlockPoints) {
+        if (!series.cold.isEmpty()) series.cold.last().seal();
+        series.cold.append(GorillaBlock(3));
+    }
+    const float values[3] = {bucket.min, bucket.avg, bucket.max};
+    series.cold.last().append(timestampMs, values);
+
+    // 移除整個區塊都已超過保存期限的資料
+    while (series.cold.size() > 1 && series.cold.first().lastTimestamp() < timestampMs - kColdRetentionMs) {
+        series.cold.removeFirst();
+    }
+}
+
+void MetricHistory::ingest() {
+    SystemCollector::instance()->drainHistory([this](const MetricPoint &point) {
+        append(seriesKey(point.kind, point.slot), point.timestampMs, point.value);
+    });
+}
+
+/** --- 查詢 --- **/
+
+int MetricHistory::pickTier(const Series &series, qint64 fromMs, qint64 toMs, int maxPoints) const {
+    for (int i = 0; i < series.tiers.size(); ++i) {
+        const Tier &tier = series.tiers[i];
+        const qint64 coverage = tier.resolutionMs * tier.buckets.size();
+        if (fromMs < series.lastTimestamp - coverage) {
+            // 起點超出 1 分鐘層級的範圍時，若點數允許則改用冷資料層 (仍為 1 分鐘解析度)
+            if (i == kMinuteTier && !series.cold.isEmpty()
+                && (maxPoints <= 0 || (toMs - fromMs) / tier.resolutionMs < maxPoints)) {
+                return -1;
+            }
+            continue;
+        }
+        if (maxPoints > 0 && (toMs - fromMs) / tier.resolutionMs >= maxPoints) continue;
+        return i;
+    }
+    return series.tiers.size() - 1;
+}
+
+void MetricHistory::appendBuckets(const Tier &tier, qint64 fromMs, qint64 toMs, QVector<HistoryPoint> &out) {
+    if (toMs < fromMs) return;
+
+    const quint32 first = static_cast<quint32>(qMax<qint64>(0, fromMs) / tier.resolutionMs);
+    const quint32 last = static_cast<quint32>(qMax<qint64>(0, toMs) / tier.resolutionMs);
+    const quint32 capacity = static_cast<quint32>(tier.buckets.size());
+
+    // 只走訪視窗內的時間桶，且最多走一圈
+    const quint32 begin = (last - first >= capacity) ? last - capacity + 1 : first;
+    out.reserve(out.size() + static_cast<int>(last - begin + 1));
+    for (quint32 index = begin; index <= last; ++index) {
+        const Bucket &bucket = tier.buckets[index % capacity];
+        if (bucket.index != index || bucket.count == 0) continue;   // 沒有取樣或已被覆蓋
+        out.append(HistoryPoint{qint64(index) * tier.resolutionMs, bucket.min, bucket.max, bucket.avg});
+    }
+}
+
+qint64 MetricHistory::appendCold(const Series &series, qint64 fromMs, qint64 toMs, QVector<HistoryPoint> &out) {
+    qint64 next = fromMs;
+    for (const GorillaBlock &block : series.cold) {
+        if (block.lastTimestamp() < fromMs) continue;   // 不解碼視窗外的區塊
+        if (block.firstTimestamp() > toMs) break;
+
+        GorillaBlock::Reader reader = block.reader();
+        qint64 timestampMs;
+        float values[3];
+        while (reader.next(timestampMs, values)) {
+            if (timestampMs < fromMs) continue;
+            if (timestampMs > toMs) return next;
+            out.append(HistoryPoint{timestampMs, values[0], values[2], values[1]});
+            next = timestampMs + kTiers[kMinuteTier].resolutionMs;
+        }
+    }
+    return next;
+}
+
+QVector<HistoryPoint> MetricHistory::query(quint32 key, qint64 fromMs, qint64 toMs, int maxPoints) {
+    ingest();
+
+    QVector<HistoryPoint> result;
+    auto it = m_series.constFind(key);
+    if (it == m_series.constEnd() || toMs < fromMs) return result;
+
+    const Series &series = it.value();
+    const int tier = pickTier(series, fromMs, toMs, maxPoints);
+    if (tier < 0) {
+        // 冷資料層只含已結束的分鐘，其後的部分 (目前這一分鐘) 由 1 分鐘層級補上
+        const qint64 hotFrom = appendCold(series, fromMs, toMs, result);
+        appendBuckets(series.tiers[kMinuteTier], hotFrom, toMs, result);
+    } else {
+        appendBuckets(series.tiers[tier], fromMs, toMs, result);
+    }
+    return result;
+}
+
+bool MetricHistory::summarize(quint32 key, qint64 fromMs, qint64 toMs, HistoryPoint &out) {
+    const QVector<HistoryPoint> points = query(key, fromMs, toMs);
+    if (points.isEmpty()) return false;
+
+    out.timestampMs = points.first().timestampMs;
+    out.min = std::numeric_limits<float>::max();
+    out.max = std::numeric_limits<float>::lowest();
+    double sum = 0.0;
+    for (const HistoryPoint &point : points) {
+        out.min = qMin(out.min, point.min);
+        out.max = qMax(out.max, point.max);
+        sum += point.avg;
+    }
+    out.avg = static_cast<float>(sum / points.size());
+    return true;
+}
+
+qint64 MetricHistory::lastTimestamp(quint32 key) const {
+    auto it = m_series.constFind(key);
+    return it == m_series.constEnd() ? -1 : it.value().lastTimestamp;
+}
@@ -0,0 +1,90 @@
+#ifndef METRICHISTORY_H
+#define METRICHISTORY_H
+
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include "SystemSnapshot.h"
+#include "GorillaBlock.h"
+
+/** @brief 查詢結果：一個時間桶內的統計值 */
+struct HistoryPoint {
+    qint64 timestampMs = 0;   // 時間桶起點 (單調時鐘)
+    float min = 0.0f;
+    float max = 0.0f;
+    float avg = 0.0f;
+};
+
+/**
+ * @brief 指標歷史資料庫 (單例模式，僅限 GUI 執行緒)
+ * 每個序列 (MetricPoint 的 kind + slot) 擁有固定大小的多層環狀緩衝：
+ *   1 秒 x 600 (10 分鐘)、10 秒 x 360 (1 小時)、1 分鐘 x 1440 (24 小時)、10 分鐘 x 1008 (7 天)
+ * 每筆取樣同時滾入所有層級的 min/max/avg，記憶體用量固定 (每序列約 68 KB)，
+ * 查詢只走訪視窗內的時間桶，成本為 O(視窗長度 / 解析度)。
+ *
+ * 冷資料層：每個結束的 1 分鐘時間桶 (min/avg/max) 另外以 Gorilla 格式壓縮，
+ * 每 2 小時封存成一個區塊並保留 7 天，讓超過 24 小時的查詢仍有 1 分鐘解析度。
+ */
+class MetricHistory : public QObject
+{
+    Q_OBJECT
+public:
+    static MetricHistory* instance();
+
+    static quint32 seriesKey(quint16 kind, quint16 slot = 0) { return (quint32(kind) << 16) | slot; }
+
+    /** @brief 寫入一筆取樣 (收集執行緒的資料由 ingest 自動寫入) */
+    void append(quint32 key, qint64 timestampMs, float value);
+
+    /** @brief 從 SystemCollector 取出尚未處理的取樣點 */
+    void ingest();
+
+    /**
+     * @brief 查詢時間範圍內的資料
+     * 自動選擇能涵蓋 fromMs 的最細層級；maxPoints > 0 時改用較粗的層級以限制點數
+     */
+    QVector<HistoryPoint> query(quint32 key, qint64 fromMs, qint64 toMs, int maxPoints = 0);
+
+    /** @brief 將時間範圍內的資料彙總成單一 min/max/avg，無資料時回傳 false */
+    bool summarize(quint32 key, qint64 fromMs, qint64 toMs, HistoryPoint &out);
+
+    /** @brief 序列最後一筆取樣的時間，無資料時回傳 -1 */
+    qint64 lastTimestamp(quint32 key) const;
+
+private:
+    explicit MetricHistory(QObject *parent = nullptr);
+    static MetricHistory* m_instance;
+    static QMutex m_mutex;
+
+    struct Bucket {
+        quint32 index = 0xFFFFFFFFu;   // 時間桶編號 (timestamp / resolution)，用於辨識過期資料
+        quint32 count = 0;
+        float min = 0.0f;
+        float max = 0.0f;
+        float avg = 0.0f;
+    };
+
+    struct Tier {
+        qint64 resolutionMs;
+        QVector<Bucket> buckets;     // 以 index % capacity 定位
+    };
+
+    struct Series {
+        QVector<Tier> tiers;
+        qint64 lastTimestamp = -1;
+        quint32 openMinute = 0xFFFFFFFFu;   // 尚未寫入冷資料層的 1 分鐘時間桶
+        QVector<GorillaBlock> cold;         // 依時間排序，最後一個區塊仍在寫入中
+    };
+
+    Series &seriesFor(quint32 key);
+    int pickTier(const Series &series, qint64 fromMs, qint64 toMs, int maxPoints) const;
+    void flushMinute(Series &series);
+    static void appendBuckets(const Tier &tier, qint64 fromMs, qint64 toMs, QVector<HistoryPoint> &out);
+    static qint64 appendCold(const Series &series, qint64 fromMs, qint64 toMs, QVector<HistoryPoint> &out);
+
+    QHash<quint32, Series> m_series;
+};
+
+#endif // METRICHISTORY_H
@@ -0,0 +1,156 @@
+#include "MinMaxDecimator.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define MINMAX_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需要以 target 屬性個別啟用 AVX2，其餘程式碼仍維持基本指令集；
+// MSVC 不需要額外旗標即可使用 AVX 內建函式
+#if defined(MINMAX_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MINMAX_TARGET_AVX2 __attribute__((target("avx2")))
+#define MINMAX_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define MINMAX_TARGET_AVX2
+#define MINMAX_TARGET_SSE2
+#endif
+
+namespace {
+using MinMaxKernel = void (*)(const float *, int, float &, float &);
+
+void minMaxScalar(const float *values, int count, float &outMin, float &outMax) {
+    float lo = values[0];
+    float hi = values[0];
+    for (int i = 1; i < count; ++i) {
+        lo = std::min(lo, values[i]);
+        hi = std::max(hi, values[i]);
+    }
+    outMin = lo;
+    outMax = hi;
+}
+
+#ifdef MINMAX_X86
+MINMAX_TARGET_SSE2
+void minMaxSse2(const float *values, int count, float &outMin, float &outMax) {
+    if (count < 8) {
+        minMaxScalar(values, count, outMin, outMax);
+        return;
+    }
+
+    __m128 lo = _mm_loadu_ps(values);
+    __m128 hi = lo;
+    int i = 4;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 v = _mm_loadu_ps(values + i);
+        lo = _mm_min_ps(lo, v);
+        hi = _mm_max_ps(hi, v);
+    }
+    // 尾端不足 4 筆：重讀最後 4 筆 (與前面重疊不影響 min/max)
+    if (i < count) {
+        const __m128 v = _mm_loadu_ps(values + count - 4);
+        lo = _mm_min_ps(lo, v);
+        hi = _mm_max_ps(hi, v);
+    }
+
+    alignas(16) float loLanes[4];
+    alignas(16) float hiLanes[4];
+    _mm_store_ps(loLanes, lo);
+    _mm_store_ps(hiLanes, hi);
+    outMin = std::min(std::min(loLanes[0], loLanes[1]), std::min(loLanes[2], loLanes[3]));
+    outMax = std::max(std::max(hiLanes[0], hiLanes[1]), std::max(hiLanes[2], hiLanes[3]));
+}
+
+MINMAX_TARGET_AVX2
+void minMaxAvx2(const float *values, int count, float &outMin, float &outMax) {
+    if (count < 16) {
+        minMaxSse2(values, count, outMin, outMax);
+        return;
+    }
+
+    // 兩組累加器，隱藏 min/max 指令的延遲
+    __m256 lo0 = _mm256_loadu_ps(values);
+    __m256 hi0 = lo0;
+    __m256 lo1 = _mm256_loadu_ps(values + 8);
+    __m256 hi1 = lo1;
+    int i = 16;
+    for (; i + 16 <= count; i += 16) {
+        const __m256 a = _mm256_loadu_ps(values + i);
+        const __m256 b = _mm256_loadu_ps(values + i + 8);
+        lo0 = _mm256_min_ps(lo0, a);
+        hi0 = _mm256_max_ps(hi0, a);
+        lo1 = _mm256_min_ps(lo1, b);
+        hi1 = _mm256_max_ps(hi1, b);
+    }
+    for (; i + 8 <= count; i += 8) {
+        const __m256 a = _mm256_loadu_ps(values + i);
+        lo0 = _mm256_min_ps(lo0, a);
+        hi0 = _mm256_max_ps(hi0, a);
+    }
+    if (i < count) {
+        const __m256 a = _mm256_loadu_ps(values + count - 8);
+        lo1 = _mm256_min_ps(lo1, a);
+        hi1 = _mm256_max_ps(hi1, a);
+    }
+
+    const __m256 lo = _mm256_min_ps(lo0, lo1);
+    const __m256 hi = _mm256_max_ps(hi0, hi1);
+    __m128 lo4 = _mm_min_ps(_mm256_castps256_ps128(lo), _mm256_extractf128_ps(lo, 1));
+    __m128 hi4 = _mm_max_ps(_mm256_castps256_ps128(hi), _mm256_extractf128_ps(hi, 1));
+    lo4 = _mm_min_ps(lo4, _mm_movehl_ps(lo4, lo4));
+    hi4 = _mm_max_ps(hi4, _mm_movehl_ps(hi4, hi4));
+    lo4 = _mm_min_ss(lo4, _mm_shuffle_ps(lo4, lo4, 1));
+    hi4 = _mm_max_ss(hi4, _mm_shuffle_ps(hi4, hi4, 1));
+    outMin = _mm_cvtss_f32(lo4);
+    outMax = _mm_cvtss_f32(hi4);
+}
+
+bool cpuHasAvx2() {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx) return false;
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;   // 作業系統需保存 YMM 暫存器
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+#endif // MINMAX_X86
+
+struct KernelChoice {
+    MinMaxKernel kernel;
+    const char *name;
+};
+
+const KernelChoice &selectedKernel() {
+    static const KernelChoice choice = []() -> KernelChoice {
+#ifdef MINMAX_X86
+        if (cpuHasAvx2()) return {minMaxAvx2, "avx2"};
+        return {minMaxSse2, "sse2"};   // x86-64 必定支援 SSE2
+#else
+        return {minMaxScalar, "scalar"};
+#endif
+    }();
+    return choice;
+}
+}
+
+void MinMaxDecimator::minMax(const float *values, int count, float &outMin, float &outMax) {
+    selectedKernel().kernel(values, count, outMin, outMax);
+}
+
+const char *MinMaxDecimator::kernelName() {
+    return selectedKernel().name;
+}
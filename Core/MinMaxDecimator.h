@@ -0,0 +1,19 @@
+#ifndef MINMAXDECIMATOR_H
+#define MINMAXDECIMATOR_H
+
+/**
+ * @brief 曲線圖用的 min/max 降採樣
+ * 將數千筆取樣縮減為每個像素欄一組 min/max，繪製時只需畫欄數條線段。
+ * 核心迴圈依 CPU 能力在執行期選用 AVX2 / SSE2 / 純量版本 (只判斷一次)。
+ */
+class MinMaxDecimator
+{
+public:
+    /** @brief 求 values[0..count) 的最小值與最大值，count 必須大於 0 */
+    static void minMax(const float *values, int count, float &outMin, float &outMax);
+
+    /** @brief 目前使用的核心版本名稱 ("avx2" / "sse2" / "scalar")，供除錯輸出 */
+    static const char *kernelName();
+};
+
+#endif // MINMAXDECIMATOR_H
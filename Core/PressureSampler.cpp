@@ -0,0 +1,143 @@
+#include "PressureSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+namespace {
+const char *const kPaths[PressureSample::ResourceCount] = {
+    "/proc/pressure/cpu",
+    "/proc/pressure/memory",
+    "/proc/pressure/io"
+};
+
+// 2 秒視窗內停滯超過 200 ms (10%) 即觸發；非特權使用者的視窗必須是 2 秒的倍數
+const char kTrigger[] = "some 200000 2000000";
+}
+
+PressureSampler::PressureSampler() {
+    for (int i = 0; i < PressureSample::ResourceCount; ++i) {
+        m_files[i].open(kPaths[i]);
+    }
+    openTriggers();
+}
+
+PressureSampler::~PressureSampler() {
+    for (int fd : m_triggerFds) {
+        if (fd >= 0) ::close(fd);
+    }
+    if (m_epollFd >= 0) ::close(m_epollFd);
+}
+
+void PressureSampler::openTriggers() {
+    for (int i = 0; i < PressureSample::ResourceCount; ++i) {
+        if (!m_files[i].isOpen()) continue;
+
+        // 每個 trigger 需要獨立的描述元，寫入設定後保持開啟；關閉即取消 trigger
+        const int fd = ::open(kPaths[i], O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) continue;
+        if (::write(fd, kTrigger, sizeof(kTrigger)) < 0) {
+            ::close(fd); // EACCES / EINVAL：核心不允許此使用者建立 trigger
+            continue;
+        }
+
+        if (m_epollFd < 0) {
+            m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+            if (m_epollFd < 0) {
+                ::close(fd);
+                return;
+            }
+        }
+        epoll_event event;
+        std::memset(&event, 0, sizeof(event));
+        event.events = EPOLLPRI;
+        event.data.u32 = static_cast<quint32>(i);
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            ::close(fd);
+            continue;
+        }
+        m_triggerFds[i] = fd;
+    }
+}
+
+void PressureSampler::drainTriggers() {
+    if (m_epollFd < 0) return;
+
+    epoll_event events[PressureSample::ResourceCount];
+    int n;
+    do {
+        n = epoll_wait(m_epollFd, events, PressureSample::ResourceCount, 0);
+    } while (n < 0 && errno == EINTR);
+
+    for (int i = 0; i < n; ++i) {
+        // EPOLLERR 代表 trigger 已失效 (例如 cgroup 被移除)，不再監看以免持續喚醒
+        if (events[i].events & EPOLLERR) {
+            const quint32 index = events[i].data.u32;
+            epoll_ctl(m_epollFd, EPOLL_CTL_DEL, m_triggerFds[index], nullptr);
+            ::close(m_triggerFds[index]);
+            m_triggerFds[index] = -1;
+        }
+    }
+}
+
+bool PressureSampler::parse(std::string_view content, PressureSample &out, Totals &totals) {
+    // 格式：some avg10=0.12 avg60=0.05 avg300=0.01 total=123456
+    //       full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+    bool hasSome = false;
+    std::string_view line;
+    while (ProcText::nextLine(content, line)) {
+        std::string_view kind;
+        if (!ProcText::nextToken(line, kind)) continue;
+        const bool some = kind == "some";
+        if (!some && kind != "full") continue;
+
+        float avg10 = 0.0f, avg60 = 0.0f;
+        quint64 total = 0;
+        std::string_view field;
+        while (ProcText::nextToken(line, field)) {
+            const size_t eq = field.find('=');
+            if (eq == std::string_view::npos) continue;
+            const std::string_view key = field.substr(0, eq);
+            const std::string_view value = field.substr(eq + 1);
+            double number = 0.0;
+            if (key == "avg10" && ProcText::toDouble(value, number)) avg10 = static_cast<float>(number);
+            else if (key == "avg60" && ProcText::toDouble(value, number)) avg60 = static_cast<float>(number);
+            else if (key == "total") ProcText::toU64(value, total);
+        }
+
+        if (some) {
+            out.someAvg10 = avg10;
+            out.someAvg60 = avg60;
+            totals.some = total;
+            hasSome = true;
+        } else {
+            out.fullAvg10 = avg10;
+            out.fullAvg60 = avg60;
+            totals.full = total;
+            out.hasFull = true;
+        }
+    }
+    totals.valid = hasSome;
+    return hasSome;
+}
+
+void PressureSampler::sample(PressureSample (&out)[PressureSample::ResourceCount]) {
+    for (int i = 0; i < PressureSample::ResourceCount; ++i) {
+        PressureSample &sample = out[i];
+        Totals totals;
+        sample.hasFull = false;
+        sample.valid = m_files[i].isOpen() && parse(m_files[i].read(), sample, totals);
+        if (!sample.valid) continue;
+
+        // 第一次取樣沒有基準，差值為 0
+        const Totals &prev = m_prev[i];
+        sample.someDeltaUs = (prev.valid && totals.some >= prev.some) ? totals.some - prev.some : 0;
+        sample.fullDeltaUs = (prev.valid && totals.full >= prev.full) ? totals.full - prev.full : 0;
+        m_prev[i] = totals;
+    }
+}
+
+#endif // Q_OS_LINUX
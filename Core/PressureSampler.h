@@ -0,0 +1,57 @@
+#ifndef PRESSURESAMPLER_H
+#define PRESSURESAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+
+/**
+ * @brief Linux PSI 取樣 (/proc/pressure/{cpu,memory,io})
+ * 每次取樣以常駐開啟的檔案讀取 some/full 的 avg10、avg60 與 total，
+ * total 與上一次取樣的差值即為這段期間新增的停滯時間。
+ *
+ * 另外為每個資源註冊 PSI trigger (2 秒內停滯超過 200 ms)，並把 trigger 的描述元
+ * 加入同一個 epoll；收集執行緒監看 triggerFd()，停滯發生時立即取樣，
+ * 不必等到下一個計時週期。核心不支援或沒有寫入權限時 (5.2 以前、
+ * 6.5 以前的非特權使用者) 只做週期取樣。
+ */
+class PressureSampler
+{
+public:
+    PressureSampler();
+    ~PressureSampler();
+
+    PressureSampler(const PressureSampler &) = delete;
+    PressureSampler &operator=(const PressureSampler &) = delete;
+
+    void sample(PressureSample (&out)[PressureSample::ResourceCount]);
+
+    /** @brief 所有 trigger 共用的 epoll 描述元，沒有可用的 trigger 時為 -1 */
+    int triggerFd() const { return m_epollFd; }
+
+    /**
+     * @brief 取出已觸發的事件 (不阻塞)，並移除已失效的 trigger
+     * 外層以 poll 監看 epoll 描述元時，核心在檢查就緒狀態時就已消耗 PSI 事件，
+     * 這裡常常取不到任何事件；因此 triggerFd() 變為可讀本身就代表發生停滯。
+     */
+    void drainTriggers();
+
+private:
+    struct Totals {
+        quint64 some = 0;
+        quint64 full = 0;
+        bool valid = false;
+    };
+
+    static bool parse(std::string_view content, PressureSample &out, Totals &totals);
+    void openTriggers();
+
+    ProcFile m_files[PressureSample::ResourceCount];
+    Totals m_prev[PressureSample::ResourceCount];
+    int m_triggerFds[PressureSample::ResourceCount] = {-1, -1, -1};
+    int m_epollFd = -1;
+};
+#endif // Q_OS_LINUX
+
+#endif // PRESSURESAMPLER_H
@@ -0,0 +1,153 @@
+#include "ProcReader.h"
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <ctime>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+constexpr size_t kInitialBufferSize = 4096;
+// 保留給程式其他部分 (Qt、網路、感測器 ...) 的描述元數量
+constexpr int kReservedDescriptors = 1024;
+}
+
+std::atomic<int> DescriptorBudget::s_used{0};
+
+int DescriptorBudget::limit() {
+    static const int budget = [] {
+        rlimit limit;
+        if (getrlimit(RLIMIT_NOFILE, &limit) != 0) return 0;
+        // 刻意提高整個行程的軟限制 (見 ProcReader.h 的說明)：預設的 1024 不足以常駐數千個行程與 cgroup 檔案
+        if (limit.rlim_cur < limit.rlim_max) {
+            rlimit raised = limit;
+            raised.rlim_cur = qMin<rlim_t>(limit.rlim_max, 65536);
+            if (setrlimit(RLIMIT_NOFILE, &raised) == 0) limit = raised;
+        }
+        const int soft = static_cast<int>(qMin<rlim_t>(limit.rlim_cur, 65536));
+        return soft > 2 * kReservedDescriptors ? soft - kReservedDescriptors : soft / 2;
+    }();
+    return budget;
+}
+
+bool DescriptorBudget::acquire() {
+    const int budget = limit();
+    int used = s_used.load(std::memory_order_relaxed);
+    do {
+        if (used >= budget) return false;
+    } while (!s_used.compare_exchange_weak(used, used + 1, std::memory_order_relaxed));
+    return true;
+}
+
+void DescriptorBudget::release() {
+    s_used.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int ProcKeyTable::lookup(std::string_view name) const {
+    for (size_t i = 0; i < m_count; ++i) {
+        if (m_keys[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+int ProcKeyTable::parse(std::string_view content, quint64 *values) {
+    int found = 0;
+    size_t index = 0;
+    std::string_view line;
+    for (; ProcText::nextLine(content, line); ++index) {
+        // 沒有分隔字元的行 (標題列、空行) 以空名稱佔一個位置，讓 m_lines 與行號對齊
+        const size_t separator = line.find(m_separator);
+        const std::string_view name =
+            separator == std::string_view::npos ? std::string_view() : line.substr(0, separator);
+
+        // 第一次看到這一行，或該行的鍵與記錄不同 (行被插入、移除)：重新查找，只在版面改變時發生
+        if (index >= m_lines.size()) m_lines.push_back({std::string(name), lookup(name)});
+        Line &slot = m_lines[index];
+        if (slot.name != name) {
+            slot.name.assign(name.data(), name.size());
+            slot.key = lookup(name);
+        }
+        if (slot.key < 0) continue;
+
+        std::string_view rest = line.substr(separator + 1);
+        if (ProcText::nextU64(rest, values[m_keys[slot.key].slot])) ++found;
+    }
+    return found;
+}
+
+qint64 ProcText::monotonicNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<qint64>(ts.tv_sec) * 1000000000LL + ts.tv_nsec;
+}
+
+bool ProcText::readU64(int fd, quint64 &out) {
+    // 單一數值不超過 20 位數
+    char buffer[32];
+    ssize_t n;
+    do {
+        n = ::pread(fd, buffer, sizeof(buffer), 0);
+    } while (n < 0 && errno == EINTR);
+    return n > 0 && toU64(trim(std::string_view(buffer, static_cast<size_t>(n))), out);
+}
+
+ProcFile::~ProcFile() {
+    close();
+}
+
+ProcFile::ProcFile(ProcFile &&other) noexcept
+    : m_fd(other.m_fd), m_path(std::move(other.m_path)),
+      m_buffer(std::move(other.m_buffer)), m_readTimeNs(other.m_readTimeNs) {
+    other.m_fd = -1;
+}
+
+ProcFile &ProcFile::operator=(ProcFile &&other) noexcept {
+    if (this != &other) {
+        close();
+        m_fd = other.m_fd;
+        m_path = std::move(other.m_path);
+        m_buffer = std::move(other.m_buffer);
+        m_readTimeNs = other.m_readTimeNs;
+        other.m_fd = -1;
+    }
+    return *this;
+}
+
+bool ProcFile::open(const std::string &path) {
+    close();
+    m_path = path;
+    do {
+        m_fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    } while (m_fd < 0 && errno == EINTR);
+    return m_fd >= 0;
+}
+
+void ProcFile::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+std::string_view ProcFile::read() {
+    if (m_fd < 0) return std::string_view();
+    if (m_buffer.empty()) m_buffer.resize(kInitialBufferSize);
+
+    // procfs 的內容在每次從 offset 0 讀取時重新產生，因此不需要重新開檔或 lseek
+    m_readTimeNs = ProcText::monotonicNs();
+    size_t total = 0;
+    for (;;) {
+        const ssize_t n = ::pread(m_fd, m_buffer.data() + total, m_buffer.size() - total, static_cast<off_t>(total));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return std::string_view();   // 裝置移除等錯誤，由呼叫端決定是否重新開啟
+        }
+        if (n == 0) break;
+        total += static_cast<size_t>(n);
+        if (total == m_buffer.size()) m_buffer.resize(m_buffer.size() * 2);
+    }
+    return std::string_view(m_buffer.data(), total);
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,237 @@
+#ifndef PROCREADER_H
+#define PROCREADER_H
+
+#include <QtGlobal>
+
+#ifdef Q_OS_LINUX
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief 常駐開啟的 procfs / sysfs 檔案 (僅限 Linux)
+ * 檔案只開啟一次，每次讀取以 pread 從頭讀入可重複使用的緩衝區，
+ * 回傳的 string_view 直接指向緩衝區，不產生 QString / QFile 等暫存物件。
+ * 適用於每秒都要讀取的小檔案 (/proc/stat、/proc/meminfo、cpufreq 等)。
+ *
+ * 不具執行緒安全性：每個 ProcFile 只應在單一執行緒 (收集執行緒) 中使用。
+ */
+class ProcFile
+{
+public:
+    ProcFile() = default;
+    explicit ProcFile(const std::string &path) { open(path); }
+    ~ProcFile();
+
+    ProcFile(ProcFile &&other) noexcept;
+    ProcFile &operator=(ProcFile &&other) noexcept;
+    ProcFile(const ProcFile &) = delete;
+    ProcFile &operator=(const ProcFile &) = delete;
+
+    bool open(const std::string &path);
+    void close();
+    bool isOpen() const { return m_fd >= 0; }
+    const std::string &path() const { return m_path; }
+
+    /**
+     * @brief 重新讀取整個檔案
+     * 回傳的內容在下一次 read() 或物件銷毀前有效；讀取失敗時回傳空字串。
+     * 緩衝區不足時自動加倍，之後的讀取不再配置記憶體。
+     */
+    std::string_view read();
+
+    /** @brief 最近一次 read() 的單調時鐘時間 (奈秒)，用於計算速率 */
+    qint64 readTimeNs() const { return m_readTimeNs; }
+
+private:
+    int m_fd = -1;
+    std::string m_path;
+    std::vector<char> m_buffer;
+    qint64 m_readTimeNs = 0;
+};
+
+/**
+ * @brief 常駐描述元的全域預算 (僅限 Linux)
+ * 行程與 cgroup 掃描會為數千個檔案保留描述元，兩者共用同一份預算，
+ * 避免合計超過 RLIMIT_NOFILE 而讓程式其他部分 (Qt、網路 ...) 開檔失敗。
+ * 超出預算時呼叫端應退回「開檔、讀取、關檔」。
+ *
+ * 副作用：第一次 acquire() 時會以 setrlimit 把整個行程的 RLIMIT_NOFILE 軟限制
+ * 提高到硬限制 (最多 65536，不需要特殊權限)，並保留 1024 個 (限制較小時保留一半) 給其他用途。
+ * 這個變更對所有執行緒生效、之後不會還原，也會由 QProcess 等啟動的子行程繼承；
+ * 若程式中有使用 select() 的程式碼，需注意描述元編號可能超過 FD_SETSIZE (1024)。
+ */
+class DescriptorBudget
+{
+public:
+    /** @brief 預約一個常駐描述元，預算用完時回傳 false */
+    static bool acquire();
+    static void release();
+
+private:
+    static int limit();
+    static std::atomic<int> s_used;
+};
+
+/**
+ * @brief 「鍵 值」格式檔案的欄位對應 (/proc/meminfo、/proc/vmstat 等)
+ * 建立時給定要取出的鍵與對應的槽位 (呼叫端數值陣列的索引)；
+ * 第一次解析時記錄每一行的鍵與對應的槽位，之後每次解析都是一次線性掃描：
+ * 每行只與記錄的鍵比對 (長度不同即可排除)，不做查表、不配置字串。
+ * 核心增減欄位造成版面改變時，只重新查找鍵與記錄不同的行。
+ */
+class ProcKeyTable
+{
+public:
+    struct Key {
+        std::string_view name;
+        int slot;
+    };
+
+    /**
+     * @param keys 鍵表 (需在物件存活期間有效，通常為靜態陣列)
+     * @param separator 鍵與值之間的分隔字元 (meminfo 為 ':'，vmstat 為 ' ')
+     */
+    ProcKeyTable(const Key *keys, size_t count, char separator)
+        : m_keys(keys), m_count(count), m_separator(separator) {}
+
+    /**
+     * @brief 解析 content，把找到的值寫入 values[slot]
+     * 找不到的鍵維持原值；回傳找到的鍵數量
+     */
+    int parse(std::string_view content, quint64 *values);
+
+private:
+    int lookup(std::string_view name) const; // 回傳 m_keys 索引，沒有時為 -1
+
+    const Key *m_keys;
+    size_t m_count;
+    char m_separator;
+    struct Line {
+        std::string name; // 該行的鍵，沒有分隔字元的行為空字串
+        int key;          // 對應的 m_keys 索引，-1 代表不需要的行
+    };
+    std::vector<Line> m_lines;   // 依行號
+};
+
+/**
+ * @brief procfs 文字格式的就地解析工具
+ * 所有函式都只移動 string_view，不複製字串。
+ */
+namespace ProcText {
+
+/** @brief 單調時鐘 (奈秒) */
+qint64 monotonicNs();
+
+inline bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+inline std::string_view trim(std::string_view text) {
+    while (!text.empty() && isSpace(text.front())) text.remove_prefix(1);
+    while (!text.empty() && isSpace(text.back())) text.remove_suffix(1);
+    return text;
+}
+
+inline bool startsWith(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+/** @brief 取出下一行 (不含換行)，沒有剩餘內容時回傳 false */
+inline bool nextLine(std::string_view &text, std::string_view &line) {
+    if (text.empty()) return false;
+    const size_t end = text.find('\n');
+    if (end == std::string_view::npos) {
+        line = text;
+        text = std::string_view();
+    } else {
+        line = text.substr(0, end);
+        text.remove_prefix(end + 1);
+    }
+    return true;
+}
+
+/** @brief 取出下一個以空白分隔的欄位 */
+inline bool nextToken(std::string_view &text, std::string_view &token) {
+    size_t begin = 0;
+    while (begin < text.size() && isSpace(text[begin])) ++begin;
+    if (begin == text.size()) {
+        text = std::string_view();
+        return false;
+    }
+    size_t end = begin;
+    while (end < text.size() && !isSpace(text[end])) ++end;
+    token = text.substr(begin, end - begin);
+    text.remove_prefix(end);
+    return true;
+}
+
+inline bool toU64(std::string_view token, quint64 &out) {
+    if (token.empty()) return false;
+    quint64 value = 0;
+    for (char c : token) {
+        if (c < '0' || c > '9') return false;
+        value = value * 10 + static_cast<quint64>(c - '0');
+    }
+    out = value;
+    return true;
+}
+
+inline bool toI64(std::string_view token, qint64 &out) {
+    const bool negative = !token.empty() && token.front() == '-';
+    if (negative) token.remove_prefix(1);
+    quint64 magnitude;
+    if (!toU64(token, magnitude)) return false;
+    out = negative ? -static_cast<qint64>(magnitude) : static_cast<qint64>(magnitude);
+    return true;
+}
+
+/** @brief 解析 procfs 中常見的簡單小數 (例如 "0.52"、"-12.5")，不支援指數 */
+inline bool toDouble(std::string_view token, double &out) {
+    const bool negative = !token.empty() && token.front() == '-';
+    if (negative) token.remove_prefix(1);
+    if (token.empty()) return false;
+
+    double value = 0.0;
+    size_t i = 0;
+    for (; i < token.size() && token[i] != '.'; ++i) {
+        if (token[i] < '0' || token[i] > '9') return false;
+        value = value * 10.0 + (token[i] - '0');
+    }
+    if (i < token.size()) {
+        double scale = 0.1;
+        for (++i; i < token.size(); ++i, scale *= 0.1) {
+            if (token[i] < '0' || token[i] > '9') return false;
+            value += (token[i] - '0') * scale;
+        }
+    }
+    out = negative ? -value : value;
+    return true;
+}
+
+/** @brief 讀取下一個欄位並轉為整數，常用於連續數值欄位 */
+inline bool nextU64(std::string_view &text, quint64 &out) {
+    std::string_view token;
+    return nextToken(text, token) && toU64(token, out);
+}
+
+/** @brief 讀取 sysfs 單一數值檔案 (例如 scaling_cur_freq) */
+inline bool readU64(ProcFile &file, quint64 &out) {
+    return toU64(trim(file.read()), out);
+}
+
+/** @brief 讀取可能為負值的 sysfs 數值檔案 (例如 temp*_input) */
+inline bool readI64(ProcFile &file, qint64 &out) {
+    return toI64(trim(file.read()), out);
+}
+
+/**
+ * @brief 以 pread 讀取描述元上的 sysfs 單一數值
+ * 不經過 ProcFile 的緩衝區，適合每個核心各有數個計數器檔案的情況 (cpuidle、thermal_throttle)
+ */
+bool readU64(int fd, quint64 &out);
+
+}
+
+#endif // Q_OS_LINUX
+
+#endif // PROCREADER_H
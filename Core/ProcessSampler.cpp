@@ -0,0 +1,217 @@
+#include "ProcessSampler.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <QThread>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+// 行程數量超過此值才平行處理，少量行程時執行緒切換的成本反而更高
+constexpr size_t kParallelThreshold = 512;
+constexpr size_t kMinChunkSize = 256;
+
+int openStat(int pid) {
+    char path[32];
+    std::snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    int fd;
+    do {
+        fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    return fd;
+}
+
+// /proc/<pid>/stat 通常不到 400 位元組；只需要前 24 個欄位，截斷也不影響
+std::string_view readStat(int fd, char *buffer, size_t size) {
+    ssize_t n;
+    do {
+        n = ::pread(fd, buffer, size, 0);
+    } while (n < 0 && errno == EINTR);
+    return n > 0 ? std::string_view(buffer, static_cast<size_t>(n)) : std::string_view();
+}
+}
+
+ProcessSampler::ProcessSampler() {
+    m_ticksPerSecond = qMax(1L, sysconf(_SC_CLK_TCK));
+    m_pageSize = qMax(1L, sysconf(_SC_PAGESIZE));
+
+    // 收集執行緒本身也處理一個區塊
+    m_pool.setMaxThreadCount(qBound(1, QThread::idealThreadCount() - 1, 3));
+    m_pool.setExpiryTimeout(-1); // 每秒都會用到，不讓執行緒閒置後被回收
+}
+
+ProcessSampler::~ProcessSampler() {
+    m_pool.waitForDone();
+    for (auto &item : m_entries) release(item.second);
+    if (m_procDir) closedir(m_procDir);
+}
+
+void ProcessSampler::release(Entry &entry) {
+    if (entry.fd >= 0) {
+        ::close(entry.fd);
+        entry.fd = -1;
+        DescriptorBudget::release();
+    }
+}
+
+void ProcessSampler::listPids() {
+    m_work.clear();
+    if (!m_procDir) {
+        m_procDir = opendir("/proc");
+        if (!m_procDir) return;
+    } else {
+        rewinddir(m_procDir); // 重新讀取目錄內容，不必重新開啟
+    }
+
+    while (dirent *ent = readdir(m_procDir)) {
+        quint64 pid;
+        if (ent->d_name[0] < '1' || ent->d_name[0] > '9') continue;
+        if (!ProcText::toU64(ent->d_name, pid) || pid > 0x7fffffff) continue;
+
+        auto result = m_entries.try_emplace(static_cast<int>(pid));
+        Entry &entry = result.first->second;
+        if (result.second && DescriptorBudget::acquire()) {
+            entry.fd = openStat(static_cast<int>(pid));
+            if (entry.fd < 0) DescriptorBudget::release();
+        }
+        entry.seenRound = m_round;
+        m_work.push_back(&*result.first);
+    }
+}
+
+bool ProcessSampler::parseStat(std::string_view content, Entry &entry, quint64 &startTime) {
+    // 格式：pid (comm) state ppid ...；comm 可能含空白或括號，以最後一個 ')' 為界
+    const size_t open = content.find('(');
+    const size_t close = content.rfind(')');
+    if (open == std::string_view::npos || close == std::string_view::npos || close < open) return false;
+
+    const std::string_view comm = content.substr(open + 1, close - open - 1);
+    const size_t nameLength = qMin(comm.size(), sizeof(entry.name) - 1);
+    std::memcpy(entry.name, comm.data(), nameLength);
+    entry.name[nameLength] = '\0';
+
+    // 從 state (第 3 欄) 開始；utime/stime 為第 14/15 欄，starttime 為第 22 欄，rss 為第 24 欄
+    std::string_view fields = content.substr(close + 1);
+    std::string_view token;
+    quint64 utime = 0, stime = 0, rss = 0;
+    for (int field = 3; field <= 24; ++field) {
+        if (!ProcText::nextToken(fields, token)) return false;
+        switch (field) {
+        case 14: if (!ProcText::toU64(token, utime)) return false; break;
+        case 15: if (!ProcText::toU64(token, stime)) return false; break;
+        case 22: if (!ProcText::toU64(token, startTime)) return false; break;
+        case 24: ProcText::toU64(token, rss); break;
+        default: break;
+        }
+    }
+    entry.ticks = utime + stime;
+    entry.rssPages = rss;
+    return true;
+}
+
+void ProcessSampler::readEntry(int pid, Entry &entry) {
+    char buffer[1024];
+    std::string_view content;
+    if (entry.fd >= 0) {
+        content = readStat(entry.fd, buffer, sizeof(buffer));
+        if (content.empty()) {
+            // 原行程已結束 (ESRCH)，同一個 PID 可能已分配給新行程：重新開啟一次
+            // 只替換描述元，常駐數量不變
+            const int fd = openStat(pid);
+            if (fd >= 0) {
+                ::close(entry.fd);
+                entry.fd = fd;
+                content = readStat(fd, buffer, sizeof(buffer));
+            }
+        }
+    } else {
+        const int fd = openStat(pid);
+        if (fd >= 0) {
+            content = readStat(fd, buffer, sizeof(buffer));
+            ::close(fd);
+        }
+    }
+
+    const quint64 prevTicks = entry.ticks;
+    quint64 startTime = 0;
+    entry.alive = !content.empty() && parseStat(content, entry, startTime);
+    if (!entry.alive) return;
+
+    // starttime 不同代表 PID 被重複使用，舊的 ticks 不可比較
+    const bool sameProcess = entry.hasBaseline && entry.startTime == startTime;
+    entry.ranked = sameProcess;
+    entry.delta = (sameProcess && entry.ticks >= prevTicks) ? entry.ticks - prevTicks : 0;
+    entry.startTime = startTime;
+    entry.hasBaseline = true;
+}
+
+void ProcessSampler::readChunk(size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        readEntry(m_work[i]->first, m_work[i]->second);
+    }
+}
+
+void ProcessSampler::sample(ProcessTopSample &out) {
+    const qint64 startNs = ProcText::monotonicNs();
+    ++m_round;
+    listPids();
+
+    // 各區塊只寫入自己的 Entry，不共用任何可變狀態
+    const size_t total = m_work.size();
+    if (total < kParallelThreshold) {
+        readChunk(0, total);
+    } else {
+        const size_t chunks = qMin<size_t>(static_cast<size_t>(m_pool.maxThreadCount()) + 1, total / kMinChunkSize);
+        const size_t chunkSize = (total + chunks - 1) / chunks;
+        for (size_t begin = chunkSize; begin < total; begin += chunkSize) {
+            const size_t end = qMin(begin + chunkSize, total);
+            m_pool.start([this, begin, end]() { readChunk(begin, end); });
+        }
+        readChunk(0, qMin(chunkSize, total));
+        m_pool.waitForDone();
+    }
+
+    // 移除已結束的行程，同時收集可排名的項目
+    m_ranked.clear();
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        Entry &entry = it->second;
+        if (entry.seenRound != m_round || !entry.alive) {
+            release(entry);
+            it = m_entries.erase(it);
+            continue;
+        }
+        if (entry.ranked) m_ranked.push_back(&*it);
+        ++it;
+    }
+
+    const size_t topCount = qMin<size_t>(m_ranked.size(), SnapshotLimits::kMaxTopProcesses);
+    std::partial_sort(m_ranked.begin(), m_ranked.begin() + static_cast<std::ptrdiff_t>(topCount), m_ranked.end(),
+                      [](const Item *a, const Item *b) {
+        if (a->second.delta != b->second.delta) return a->second.delta > b->second.delta;
+        return a->first < b->first;
+    });
+
+    const qint64 elapsedNs = startNs - m_prevScanNs;
+    const bool hasInterval = m_prevScanNs > 0 && elapsedNs > 0;
+    m_prevScanNs = startNs;
+
+    out.valid = hasInterval;
+    out.processCount = static_cast<int>(m_entries.size());
+    out.count = hasInterval ? static_cast<int>(topCount) : 0;
+    const double ticksToPercent = hasInterval ? 100.0 * 1e9 / (double(m_ticksPerSecond) * double(elapsedNs)) : 0.0;
+    for (int i = 0; i < out.count; ++i) {
+        const Item *item = m_ranked[i];
+        ProcessSample &process = out.top[i];
+        process.pid = item->first;
+        std::memcpy(process.name.text, item->second.name, sizeof(item->second.name));
+        process.cpuPercent = static_cast<float>(double(item->second.delta) * ticksToPercent);
+        process.rssBytes = item->second.rssPages * static_cast<quint64>(m_pageSize);
+    }
+    out.scanMicros = (ProcText::monotonicNs() - startNs) / 1000;
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,72 @@
+#ifndef PROCESSSAMPLER_H
+#define PROCESSSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include <QThreadPool>
+#include <dirent.h>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Linux 行程 CPU 使用率排行 (增量掃描 /proc)
+ * 每個行程以 (pid, starttime) 識別並保留上一輪的 CPU ticks：
+ * /proc/<pid>/stat 在第一次看到該行程時開啟一次，之後每輪只做 pread；
+ * PID 被重複使用時 starttime 會不同，視為新行程重新建立基準。
+ *
+ * 每輪的流程：
+ * 1. 讀取常駐開啟的 /proc 目錄 (只取得 PID 清單)，新行程才開啟 stat。
+ * 2. 行程數量較多時把 stat 的讀取與差值計算切成數個區塊平行處理。
+ * 3. 以 partial sort 只排出前幾名。
+ *
+ * 常駐的描述元數量受 DescriptorBudget 限制，超出預算的行程退回每輪開檔、讀取、關檔。
+ * 這裡不使用 ProcFile：它的 4 KB 緩衝區乘上數千個行程太浪費，stat 只需要堆疊上的小緩衝區。
+ */
+class ProcessSampler
+{
+public:
+    ProcessSampler();
+    ~ProcessSampler();
+
+    ProcessSampler(const ProcessSampler &) = delete;
+    ProcessSampler &operator=(const ProcessSampler &) = delete;
+
+    /** @brief 掃描一輪並填入 out；第一輪只建立基準 */
+    void sample(ProcessTopSample &out);
+
+private:
+    struct Entry {
+        int fd = -1;              // 超出描述元預算時為 -1，每輪臨時開啟
+        quint64 startTime = 0;    // 開機後的 jiffies，與 pid 一起識別行程
+        quint64 ticks = 0;        // utime + stime
+        quint64 delta = 0;        // 本輪與上一輪的 ticks 差值
+        quint64 rssPages = 0;
+        char name[16] = {0};      // comm (核心限制 15 字元)
+        bool hasBaseline = false;
+        bool ranked = false;      // 本輪有差值可排名
+        bool alive = false;       // 本輪讀取成功
+        quint64 seenRound = 0;
+    };
+    using Item = std::pair<const int, Entry>;
+
+    void listPids();
+    void readChunk(size_t begin, size_t end);
+    void readEntry(int pid, Entry &entry);
+    void release(Entry &entry);
+    static bool parseStat(std::string_view content, Entry &entry, quint64 &startTime);
+
+    DIR *m_procDir = nullptr;
+    std::unordered_map<int, Entry> m_entries;
+    std::vector<Item *> m_work;       // 本輪要讀取的行程 (重複使用容量)
+    std::vector<const Item *> m_ranked;
+    QThreadPool m_pool;
+    quint64 m_round = 0;
+    qint64 m_prevScanNs = 0;
+    long m_ticksPerSecond = 100;
+    long m_pageSize = 4096;
+};
+#endif // Q_OS_LINUX
+
+#endif // PROCESSSAMPLER_H
@@ -0,0 +1,141 @@
+#include "RaplSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <QString>
+#include <algorithm>
+#include <dirent.h>
+#include <unistd.h>
+
+namespace {
+constexpr std::string_view kZonePrefix = "intel-rapl:";
+
+quint8 kindFor(std::string_view name) {
+    if (ProcText::startsWith(name, "package")) return PowerZoneSample::Package;
+    if (name == "core") return PowerZoneSample::Core;
+    if (name == "uncore") return PowerZoneSample::Uncore;
+    if (name == "dram") return PowerZoneSample::Dram;
+    if (name == "psys") return PowerZoneSample::Psys;
+    return PowerZoneSample::Other;
+}
+
+// "intel-rapl:0:1" -> {0, 1}；第一層為 package (或 psys)，第二層為其子區域
+std::vector<quint64> zonePath(std::string_view id) {
+    std::vector<quint64> parts;
+    id.remove_prefix(kZonePrefix.size());
+    while (!id.empty()) {
+        const size_t colon = id.find(':');
+        quint64 value;
+        if (!ProcText::toU64(id.substr(0, colon), value)) return {};
+        parts.push_back(value);
+        if (colon == std::string_view::npos) break;
+        id.remove_prefix(colon + 1);
+    }
+    return parts;
+}
+}
+
+void RaplSampler::configure(const std::string &root) {
+    if (m_configured && root == m_root) return;
+    m_root = root;
+    m_configured = true;
+    discover();
+}
+
+void RaplSampler::discover() {
+    m_zones.clear();
+    m_permissionDenied = false;
+
+    std::vector<std::pair<std::vector<quint64>, std::string>> ids;
+    if (DIR *dir = opendir(m_root.c_str())) {
+        while (dirent *ent = readdir(dir)) {
+            const std::string_view name(ent->d_name);
+            if (!ProcText::startsWith(name, kZonePrefix)) continue;
+            std::vector<quint64> path = zonePath(name);
+            if (!path.empty()) ids.emplace_back(std::move(path), std::string(name));
+        }
+        closedir(dir);
+    }
+    // 依編號排序：package 之後緊接著它的子區域，歷史資料的槽位在同一根目錄下保持固定
+    std::sort(ids.begin(), ids.end());
+
+    std::vector<std::string> topNames; // 第一層編號 -> 名稱，子區域以 "package-0/dram" 顯示
+    for (const auto &id : ids) {
+        if (int(m_zones.size()) >= SnapshotLimits::kMaxPowerZones) break;
+        const std::string base = m_root + "/" + id.second + "/";
+
+        ProcFile nameFile(base + "name");
+        const std::string name(ProcText::trim(nameFile.read()));
+        const std::vector<quint64> &path = id.first;
+        if (path.size() == 1) {
+            if (topNames.size() <= path[0]) topNames.resize(path[0] + 1);
+            topNames[path[0]] = name;
+        }
+
+        Zone zone;
+        const std::string energyPath = base + "energy_uj";
+        if (!zone.energy.open(energyPath)) {
+            if (::access(energyPath.c_str(), F_OK) == 0) m_permissionDenied = true;
+            continue;
+        }
+        ProcFile maxFile(base + "max_energy_range_uj");
+        ProcText::readU64(maxFile, zone.maxRange);
+
+        zone.kind = kindFor(name);
+        const std::string label = (path.size() > 1 && path[0] < topNames.size() && !topNames[path[0]].empty())
+                                      ? topNames[path[0]] + "/" + name : name;
+        zone.name.set(QString::fromStdString(label.empty() ? id.second : label));
+
+        // package-N 的 N 為插槽編號；子區域屬於上一層的 package
+        const std::string_view top = path[0] < topNames.size() ? std::string_view(topNames[path[0]]) : std::string_view();
+        quint64 socket;
+        if (ProcText::startsWith(top, "package-") && ProcText::toU64(top.substr(8), socket) && socket < 128) {
+            zone.package = qint8(socket);
+        }
+        m_zones.push_back(std::move(zone));
+    }
+}
+
+void RaplSampler::sample(PowerSample &out) {
+    out.permissionDenied = m_permissionDenied;
+    out.zoneCount = int(m_zones.size());
+    out.packageWatts = 0.0f;
+    bool anyValid = false;
+
+    for (int i = 0; i < out.zoneCount; ++i) {
+        Zone &zone = m_zones[i];
+        PowerZoneSample &target = out.zones[i];
+        target.name = zone.name;
+        target.kind = zone.kind;
+        target.package = zone.package;
+
+        quint64 energy;
+        if (!ProcText::readU64(zone.energy, energy)) {
+            zone.prevNs = 0;
+            target.watts = 0.0f;
+            continue;
+        }
+        const qint64 nowNs = zone.energy.readTimeNs();
+
+        if (zone.prevNs > 0 && nowNs > zone.prevNs) {
+            quint64 delta;
+            if (energy >= zone.prevEnergy) {
+                delta = energy - zone.prevEnergy;
+            } else if (zone.maxRange > zone.prevEnergy) {
+                delta = zone.maxRange - zone.prevEnergy + energy; // 計數器歸零
+            } else {
+                delta = 0;  // 範圍未知：略過這一輪
+            }
+            // 微焦耳 / 微秒 = 瓦
+            target.watts = float(double(delta) * 1000.0 / double(nowNs - zone.prevNs));
+            if (zone.kind == PowerZoneSample::Package) out.packageWatts += target.watts;
+            anyValid = true;
+        } else {
+            target.watts = 0.0f;
+        }
+        zone.prevEnergy = energy;
+        zone.prevNs = nowNs;
+    }
+    out.valid = anyValid;
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,47 @@
+#ifndef RAPLSAMPLER_H
+#define RAPLSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Linux RAPL 功耗 (powercap：<root>/intel-rapl:N[:M]/energy_uj)
+ * 每個區域的 energy_uj 常駐開啟，兩次讀取的差值 (微焦耳) 除以間隔 (微秒) 即為瓦數；
+ * 計數器超過 max_energy_range_uj 後歸零，差值為負時補上一個範圍。
+ *
+ * 根目錄可設定 (預設 /sys/class/powercap)，方便在沒有 RAPL 的機器上以測試用目錄樹驗證。
+ * intel-rapl-mmio 與 MSR 介面回報的是同一個 package，不重複列入。
+ */
+class RaplSampler
+{
+public:
+    /** @brief 設定 powercap 根目錄；與目前不同時重新探索 */
+    void configure(const std::string &root);
+
+    void sample(PowerSample &out);
+
+private:
+    struct Zone {
+        ProcFile energy;
+        SampleName name;
+        quint8 kind = PowerZoneSample::Other;
+        qint8 package = -1;
+        quint64 maxRange = 0;      // max_energy_range_uj，0 代表未知 (不處理歸零)
+        quint64 prevEnergy = 0;
+        qint64 prevNs = 0;         // 0 代表尚無基準
+    };
+
+    void discover();
+
+    std::string m_root;
+    bool m_configured = false;
+    bool m_permissionDenied = false;
+    std::vector<Zone> m_zones;
+};
+#endif // Q_OS_LINUX
+
+#endif // RAPLSAMPLER_H
@@ -0,0 +1,177 @@
+#include "SampleScheduler.h"
+#include <QDebug>
+
+namespace {
+// 容許誤差上限：1 秒週期的工作最多可被延後或提前 100ms 以便與其他工作合併
+constexpr int kMaxSlackMs = 100;
+// Heavy 工作彼此錯開的相位間隔
+constexpr int kHeavyStaggerMs = 150;
+}
+
+SampleScheduler* SampleScheduler::m_instance = nullptr;
+QMutex SampleScheduler::m_mutex;
+
+SampleScheduler::SampleScheduler(QObject *parent) : QObject(parent) {
+    m_clock.start();
+
+    // 單次觸發，每輪結束後依最近的截止時間重新設定
+    m_timer = new QTimer(this);
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer); // 合併誤差由排程器自行處理
+    connect(m_timer, &QTimer::timeout, this, &SampleScheduler::onTimeout);
+}
+
+SampleScheduler* SampleScheduler::instance() {
+    if (!m_instance) {
+        QMutexLocker locker(&m_mutex);
+        if (!m_instance) {
+            m_instance = new SampleScheduler();
+        }
+    }
+    return m_instance;
+}
+
+/** --- 工作登記與調整 --- **/
+
+int SampleScheduler::addTask(QObject *owner, int intervalMs, std::function<void()> callback, Cost cost) {
+    Task task;
+    task.id = m_nextId++;
+    task.owner = owner;
+    task.callback = std::move(callback);
+    task.interval = qMax(1, intervalMs);
+    task.slack = qBound(1, task.interval / 8, kMaxSlackMs);
+    task.cost = cost;
+    task.due = m_clock.elapsed() + task.interval + phaseFor(task);
+    m_tasks.append(task);
+
+    // 擁有者銷毀時自動移除，避免呼叫到已刪除的物件
+    if (owner) {
+        const int id = task.id;
+        connect(owner, &QObject::destroyed, this, [this, id]() { removeTask(id); });
+    }
+
+    armTimer();
+    return task.id;
+}
+
+void SampleScheduler::removeTask(int id) {
+    Task *task = findTask(id);
+    if (!task) return;
+    task->removed = true;
+    if (!m_dispatching) {
+        compact();
+        armTimer();
+    }
+}
+
+void SampleScheduler::setInterval(int id, int intervalMs) {
+    Task *task = findTask(id);
+    if (!task) return;
+    task->interval = qMax(1, intervalMs);
+    task->slack = qBound(1, task->interval / 8, kMaxSlackMs);
+    // 與 QTimer::setInterval 相同：從現在起重新計時
+    task->due = m_clock.elapsed() + task->interval + phaseFor(*task);
+    armTimer();
+}
+
+void SampleScheduler::setActive(int id, bool active) {
+    Task *task = findTask(id);
+    if (!task || task->active == active) return;
+    task->active = active;
+    if (active) {
+        task->due = m_clock.elapsed() + task->interval + phaseFor(*task);
+    }
+    armTimer();
+}
+
+void SampleScheduler::rescheduleIn(int id, int delayMs) {
+    Task *task = findTask(id);
+    if (!task) return;
+    task->due = m_clock.elapsed() + qMax(0, delayMs);
+    armTimer();
+}
+
+double SampleScheduler::wakeupsPerSecond() const {
+    const qint64 elapsed = m_clock.elapsed();
+    return elapsed > 0 ? m_round * 1000.0 / elapsed : 0.0;
+}
+
+/** --- 內部輔助 --- **/
+
+SampleScheduler::Task* SampleScheduler::findTask(int id) {
+    for (Task &task : m_tasks) {
+        if (task.id == id && !task.removed) return &task;
+    }
+    return nullptr;
+}
+
+qint64 SampleScheduler::phaseFor(const Task &task) const {
+    if (task.cost != Heavy) return 0;
+
+    // 依 Heavy 工作的登記順序給予不同相位，讓它們不會落在同一輪
+    int ordinal = 0;
+    for (const Task &other : m_tasks) {
+        if (other.id == task.id) break;
+        if (other.cost == Heavy && !other.removed) ordinal++;
+    }
+    return (static_cast<qint64>(ordinal) * kHeavyStaggerMs) % task.interval;
+}
+
+void SampleScheduler::compact() {
+    for (int i = m_tasks.size() - 1; i >= 0; --i) {
+        if (m_tasks[i].removed) m_tasks.removeAt(i);
+    }
+}
+
+void SampleScheduler::armTimer() {
+    if (m_dispatching) return; // 本輪結束後統一設定
+
+    // 以所有工作中最早的「到期 + 容許誤差」作為下一次喚醒時間，
+    // 讓到期時間接近的工作得以被同一次喚醒帶走
+    qint64 next = -1;
+    for (const Task &task : m_tasks) {
+        if (!task.active || task.removed) continue;
+        const qint64 deadline = task.due + task.slack;
+        if (next < 0 || deadline < next) next = deadline;
+    }
+
+    if (next < 0) {
+        m_timer->stop();
+        return;
+    }
+    m_timer->start(static_cast<int>(qMax<qint64>(0, next - m_clock.elapsed())));
+}
+
+/** --- 排程核心 --- **/
+
+void SampleScheduler::onTimeout() {
+    m_dispatching = true;
+    ++m_round;
+    const qint64 now = m_clock.elapsed();
+    bool heavyRan = false;
+
+    // 以索引走訪：callback 內可能登記新工作導致容器重新配置
+    for (int i = 0; i < m_tasks.size(); ++i) {
+        Task &task = m_tasks[i];
+        if (!task.active || task.removed) continue;
+        if (task.due > now + task.slack) continue; // 尚未進入可合併的範圍
+
+        if (task.cost == Heavy) {
+            // 一輪只提前帶走一個 Heavy 工作，其餘等到各自的截止時間
+            const bool overdue = task.due <= now;
+            if (heavyRan && !overdue) continue;
+            heavyRan = true;
+        }
+
+        // 先排定下一次 (維持原相位)，callback 內若呼叫 rescheduleIn 會再覆寫
+        task.due += task.interval;
+        if (task.due <= now) task.due = now + task.interval;
+
+        std::function<void()> callback = task.callback;
+        callback();
+    }
+
+    m_dispatching = false;
+    compact();
+    armTimer();
+}
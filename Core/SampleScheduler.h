@@ -0,0 +1,88 @@
+#ifndef SAMPLESCHEDULER_H
+#define SAMPLESCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include <functional>
+
+/**
+ * @brief 全域取樣排程器 (單例模式)
+ * 取代各小工具自行持有的 QTimer：所有週期性工作都登記在這裡，
+ * 由單一計時器喚醒，並把到期時間相近的工作合併到同一次喚醒中執行。
+ * 僅供 GUI 執行緒使用。
+ */
+class SampleScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief 工作成本提示
+     * Heavy 工作會被錯開相位，且不會被提前拉進另一個 Heavy 工作的喚醒輪次
+     */
+    enum Cost {
+        Light = 0,
+        Heavy = 1
+    };
+
+    static SampleScheduler* instance();
+
+    /**
+     * @brief 登記週期性工作
+     * @param owner 擁有者，被銷毀時工作會自動移除
+     * @param intervalMs 執行週期 (毫秒)
+     * @param callback 到期時呼叫的函式
+     * @return 工作編號，供之後調整週期或啟停使用
+     */
+    int addTask(QObject *owner, int intervalMs, std::function<void()> callback, Cost cost = Light);
+    void removeTask(int id);
+
+    void setInterval(int id, int intervalMs);
+    void setActive(int id, bool active);
+
+    /** @brief 指定下一次執行的時間點 (例如時鐘需要對齊整分) */
+    void rescheduleIn(int id, int delayMs);
+
+    /** @brief 目前的喚醒輪次，同一輪內執行的工作會看到相同的數值 */
+    quint64 round() const { return m_round; }
+
+    /** @brief 自啟動以來的平均每秒喚醒次數，用於觀察合併效果 */
+    double wakeupsPerSecond() const;
+
+private slots:
+    void onTimeout();
+
+private:
+    explicit SampleScheduler(QObject *parent = nullptr);
+    static SampleScheduler* m_instance;
+    static QMutex m_mutex;
+
+    struct Task {
+        int id = 0;
+        QObject *owner = nullptr;
+        std::function<void()> callback;
+        int interval = 1000;
+        int slack = 0;       // 可延後或提前執行的容許誤差
+        qint64 due = 0;      // 下次到期時間 (相對 m_clock)
+        Cost cost = Light;
+        bool active = true;
+        bool removed = false;
+    };
+
+    Task* findTask(int id);
+    qint64 phaseFor(const Task &task) const;
+    void armTimer();
+    void compact();
+
+    QTimer *m_timer;
+    QElapsedTimer m_clock;
+    QVector<Task> m_tasks;
+    int m_nextId = 1;
+    quint64 m_round = 0;
+    bool m_dispatching = false;
+};
+
+#endif // SAMPLESCHEDULER_H
@@ -0,0 +1,98 @@
+#include "SchedStatSampler.h"
+
+#ifdef Q_OS_LINUX
+
+SchedStatSampler::SchedStatSampler()
+    : m_loadavg("/proc/loadavg"), m_schedstat("/proc/schedstat") {
+}
+
+void SchedStatSampler::sample(SchedSample &out) {
+    sampleLoad(out);
+    sampleRunDelay(out);
+}
+
+void SchedStatSampler::sampleLoad(SchedSample &out) {
+    // 格式："0.52 0.58 0.59 2/345 12345" (1/5/15 分鐘負載、可執行/全部工作、最後的 PID)
+    std::string_view text = m_loadavg.read();
+    std::string_view token;
+    double load[3];
+    out.valid = true;
+    for (double &value : load) {
+        if (!ProcText::nextToken(text, token) || !ProcText::toDouble(token, value)) {
+            out.valid = false;
+            return;
+        }
+    }
+    out.load1 = float(load[0]);
+    out.load5 = float(load[1]);
+    out.load15 = float(load[2]);
+
+    quint64 runnable = 0, threads = 0;
+    if (ProcText::nextToken(text, token)) {
+        const size_t slash = token.find('/');
+        if (slash != std::string_view::npos) {
+            ProcText::toU64(token.substr(0, slash), runnable);
+            ProcText::toU64(token.substr(slash + 1), threads);
+        }
+    }
+    out.runnable = int(runnable);
+    out.threads = int(threads);
+}
+
+void SchedStatSampler::sampleRunDelay(SchedSample &out) {
+    out.hasRunDelay = false;
+    if (!m_schedstat.isOpen()) return;
+
+    std::string_view text = m_schedstat.read();
+    if (text.empty()) return;
+    const qint64 readNs = m_schedstat.readTimeNs();
+
+    m_delay.assign(m_prevDelay.size(), 0); // 重複使用容量
+    int cpuCount = 0;
+    std::string_view line;
+    while (ProcText::nextLine(text, line)) {
+        // 只需要 cpuN 行；version、timestamp 與 domainN 行略過
+        if (!ProcText::startsWith(line, "cpu")) continue;
+        std::string_view label;
+        ProcText::nextToken(line, label);
+        quint64 cpu;
+        if (!ProcText::toU64(label.substr(3), cpu) || cpu >= quint64(SnapshotLimits::kMaxCores)) continue;
+
+        // yld_count、(保留)、sched_count、sched_goidle、ttwu_count、ttwu_local、rq_cpu_time、run_delay
+        quint64 value = 0;
+        bool parsed = true;
+        for (int field = 0; field < 8 && parsed; ++field) parsed = ProcText::nextU64(line, value);
+        if (!parsed) continue;
+
+        if (cpu >= m_delay.size()) m_delay.resize(cpu + 1, 0);
+        m_delay[cpu] = value;
+        cpuCount = qMax(cpuCount, int(cpu) + 1);
+    }
+
+    const double elapsedMs = m_prevReadNs > 0 ? double(readNs - m_prevReadNs) / 1e6 : 0.0;
+    if (elapsedMs > 0.0 && cpuCount > 0) {
+        double sum = 0.0;
+        int online = 0;
+        for (int i = 0; i < cpuCount; ++i) {
+            const quint64 prev = i < int(m_prevDelay.size()) ? m_prevDelay[i] : 0;
+            const quint64 cur = m_delay[i];
+            // 離線 (不在檔案中) 或剛上線的 CPU 沒有可比較的基準
+            if (cur == 0 || prev == 0 || cur < prev) {
+                out.runDelayMsPerSec[i] = 0.0f;
+                continue;
+            }
+            // 等待時間 (毫秒) / 間隔 (秒) = 每秒累積的等待毫秒數
+            out.runDelayMsPerSec[i] = float(double(cur - prev) / 1e6 / (elapsedMs / 1000.0));
+            sum += out.runDelayMsPerSec[i];
+            ++online;
+        }
+        out.cpuCount = cpuCount;
+        out.avgRunDelayMsPerSec = online > 0 ? float(sum / online) : 0.0f;
+        out.hasRunDelay = true;
+    }
+
+    m_prevDelay.swap(m_delay);
+    m_prevReadNs = readNs;
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,37 @@
+#ifndef SCHEDSTATSAMPLER_H
+#define SCHEDSTATSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <vector>
+
+/**
+ * @brief Linux 排程延遲與負載 (/proc/schedstat、/proc/loadavg)
+ * schedstat 每個 cpuN 行的第 8 個欄位是 run_delay：
+ * 該 CPU 上的工作累計在 run queue 等待的時間 (奈秒)。
+ * 與上一次取樣的差值除以間隔，即為每秒累積的等待時間。
+ *
+ * 兩個檔案都常駐開啟；核心未提供 schedstat 時只回報 loadavg。
+ */
+class SchedStatSampler
+{
+public:
+    SchedStatSampler();
+
+    void sample(SchedSample &out);
+
+private:
+    void sampleLoad(SchedSample &out);
+    void sampleRunDelay(SchedSample &out);
+
+    ProcFile m_loadavg;
+    ProcFile m_schedstat;
+    std::vector<quint64> m_prevDelay;   // 依 CPU 編號，0 代表尚無基準
+    std::vector<quint64> m_delay;       // 本次解析結果，與 m_prevDelay 交換使用
+    qint64 m_prevReadNs = 0;
+};
+#endif // Q_OS_LINUX
+
+#endif // SCHEDSTATSAMPLER_H
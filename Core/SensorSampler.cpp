@@ -0,0 +1,138 @@
+#include "SensorSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <QDir>
+#include <algorithm>
+
+namespace {
+const QString kHwmonRoot = QStringLiteral("/sys/class/hwmon");
+const QString kThermalRoot = QStringLiteral("/sys/class/thermal");
+
+// 從 "hwmon12"、"temp3_input" 這類名稱中取出 prefix 之後的編號
+int indexAfter(const QString &name, int prefixLength) {
+    int end = prefixLength;
+    while (end < name.size() && name.at(end).isDigit()) ++end;
+    return name.mid(prefixLength, end - prefixLength).toInt();
+}
+
+// 依編號排序 (QDir 的字串排序會讓 hwmon10 排在 hwmon2 之前)
+QStringList entriesByIndex(const QString &dir, const QString &filter, int prefixLength, QDir::Filters filters) {
+    QStringList names = QDir(dir).entryList({filter}, filters | QDir::NoDotAndDotDot);
+    std::sort(names.begin(), names.end(), [prefixLength](const QString &a, const QString &b) {
+        return indexAfter(a, prefixLength) < indexAfter(b, prefixLength);
+    });
+    return names;
+}
+}
+
+QString SensorSampler::readLabel(const QString &path) {
+    ProcFile file;
+    if (!file.open(path.toStdString())) return QString();
+    const std::string_view text = ProcText::trim(file.read());
+    return QString::fromUtf8(text.data(), static_cast<int>(text.size()));
+}
+
+bool SensorSampler::isCpuTempChip(const QString &chipName) {
+    // Intel / AMD / 常見 ARM SoC 的 CPU 溫度驅動；nvme、amdgpu、acpitz 等不列入
+    static const QStringList kChips = {
+        "coretemp", "k10temp", "k8temp", "zenpower", "via_cputemp",
+        "cpu_thermal", "cpu-thermal", "soc_thermal", "cpu0_thermal"
+    };
+    return kChips.contains(chipName);
+}
+
+void SensorSampler::addSensor(const QString &path, SensorSample::Type type, const QString &label, float scale) {
+    if (static_cast<int>(m_sensors.size()) >= SnapshotLimits::kMaxSensors) return;
+
+    Sensor sensor;
+    if (!sensor.input.open(path.toStdString())) return;
+    sensor.type = type;
+    sensor.label.set(label);
+    sensor.scale = scale;
+    m_sensors.push_back(std::move(sensor));
+}
+
+void SensorSampler::discover() {
+    m_discovered = true;
+    if (!discoverHwmon()) discoverThermalZones();
+
+    // 溫度在前、風扇在後，各自維持探索順序 (封裝 -> 核心)
+    std::stable_sort(m_sensors.begin(), m_sensors.end(), [](const Sensor &a, const Sensor &b) {
+        return a.type < b.type;
+    });
+}
+
+bool SensorSampler::discoverHwmon() {
+    bool foundCpuTemp = false;
+    for (const QString &entry : entriesByIndex(kHwmonRoot, "hwmon*", 5, QDir::Dirs | QDir::System)) {
+        // 舊核心的驅動把屬性放在 device/ 底下
+        QString base = kHwmonRoot + "/" + entry + "/";
+        QString chip = readLabel(base + "name");
+        if (chip.isEmpty()) {
+            base += "device/";
+            chip = readLabel(base + "name");
+        }
+
+        if (isCpuTempChip(chip)) {
+            for (const QString &file : entriesByIndex(base, "temp*_input", 4, QDir::Files)) {
+                const int index = indexAfter(file, 4);
+                QString label = readLabel(base + QString("temp%1_label").arg(index));
+                if (label.isEmpty()) label = QString("%1 temp%2").arg(chip).arg(index);
+                addSensor(base + file, SensorSample::Temperature, label, 0.001f); // 毫度
+                foundCpuTemp = true;
+            }
+        }
+
+        // 風扇不限晶片 (nct6775、it87、dell_smm ...)
+        for (const QString &file : entriesByIndex(base, "fan*_input", 3, QDir::Files)) {
+            const int index = indexAfter(file, 3);
+            QString label = readLabel(base + QString("fan%1_label").arg(index));
+            if (label.isEmpty()) label = QString("fan%1").arg(index);
+            addSensor(base + file, SensorSample::Fan, label, 1.0f);
+        }
+    }
+    return foundCpuTemp;
+}
+
+void SensorSampler::discoverThermalZones() {
+    QStringList fallback;
+    bool found = false;
+    for (const QString &entry : entriesByIndex(kThermalRoot, "thermal_zone*", 12, QDir::Dirs | QDir::System)) {
+        const QString base = kThermalRoot + "/" + entry + "/";
+        const QString type = readLabel(base + "type");
+        const QString lower = type.toLower();
+        if (lower == "x86_pkg_temp" || lower.contains("cpu") || lower.contains("soc")) {
+            addSensor(base + "temp", SensorSample::Temperature, type, 0.001f);
+            found = true;
+        } else if (lower == "acpitz") {
+            fallback << base;
+        }
+    }
+
+    // 只有 ACPI 區域時 (常見於筆電 BIOS) 才退而求其次使用 acpitz
+    if (!found) {
+        for (const QString &base : fallback) {
+            addSensor(base + "temp", SensorSample::Temperature, readLabel(base + "type"), 0.001f);
+        }
+    }
+}
+
+void SensorSampler::sample(SystemSnapshot &out) {
+    if (!m_discovered) discover();
+
+    const int count = static_cast<int>(m_sensors.size());
+    out.sensorCount = count;
+    for (int i = 0; i < count; ++i) {
+        Sensor &sensor = m_sensors[i];
+        SensorSample &sample = out.sensors[i];
+        sample.type = sensor.type;
+        sample.label = sensor.label;
+
+        qint64 raw = 0;
+        // 感測器暫時無法讀取時 (例如 EC 忙碌回傳 EAGAIN) 標記為不存在，下一輪再試
+        sample.present = ProcText::readI64(sensor.input, raw);
+        sample.value = sample.present ? static_cast<float>(raw) * sensor.scale : 0.0f;
+    }
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,48 @@
+#ifndef SENSORSAMPLER_H
+#define SENSORSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <QString>
+#include <vector>
+
+/**
+ * @brief Linux 硬體感測器取樣 (hwmon / thermal_zone)
+ * 第一次取樣時探索 /sys/class/hwmon 與 /sys/class/thermal 一次，
+ * 只保留 CPU 封裝 / 核心溫度 (coretemp、k10temp ...) 與風扇轉速的輸入檔並常駐開啟；
+ * 之後每次取樣只對這些檔案做 pread。伺服器上的 hwmon 樹可能有數百個項目，
+ * 因此探索結果不會在每次取樣時重做 (熱插拔的感測器需重新啟動程式才會出現)。
+ *
+ * 沒有 CPU 溫度驅動的 hwmon 時 (部分虛擬機或 ARM 板)，改用 thermal_zone 中
+ * x86_pkg_temp / cpu / soc 類型的區域。
+ */
+class SensorSampler
+{
+public:
+    /** @brief 填入 out.sensors[0..out.sensorCount)，第一次呼叫時進行探索 */
+    void sample(SystemSnapshot &out);
+
+private:
+    struct Sensor {
+        ProcFile input;
+        SensorSample::Type type = SensorSample::Temperature;
+        SampleName label;
+        float scale = 1.0f;   // 原始值換算為 °C 或 RPM 的倍率
+    };
+
+    void discover();
+    bool discoverHwmon();       // 回傳是否找到 CPU 溫度
+    void discoverThermalZones();
+    void addSensor(const QString &path, SensorSample::Type type, const QString &label, float scale);
+
+    static bool isCpuTempChip(const QString &chipName);
+    static QString readLabel(const QString &path);
+
+    std::vector<Sensor> m_sensors;
+    bool m_discovered = false;
+};
+#endif // Q_OS_LINUX
+
+#endif // SENSORSAMPLER_H
@@ -0,0 +1,323 @@
+#include "SmapsSampler.h"
+
+#ifdef Q_OS_LINUX
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+enum Field {
+    Rss = 0,
+    Pss,
+    Swap,
+    SwapPss,
+    FieldCount
+};
+
+const ProcKeyTable::Key kRollupKeys[] = {
+    {"Rss", Rss}, {"Pss", Pss}, {"Swap", Swap}, {"SwapPss", SwapPss},
+};
+
+constexpr qint64 kNsPerMs = 1000000;
+constexpr qint64 kTickBudgetNs = 10 * kNsPerMs;  // 每輪讀取 smaps_rollup 的時間上限
+constexpr qint64 kMinIntervalMs = 1000;
+constexpr qint64 kMaxIntervalMs = 120 * 1000;
+constexpr qint64 kRetryIntervalMs = 5 * 60 * 1000; // 無法讀取的行程 (權限不足、核心執行緒)
+constexpr quint64 kMissing = ~quint64(0);
+
+// 至少 4 MB，或超過 1/16 且至少 512 KB
+bool significantChange(quint64 baseKb, qint64 deltaKb) {
+    const quint64 change = quint64(deltaKb < 0 ? -deltaKb : deltaKb);
+    return change >= 4096 || (change >= 512 && change * 16 >= baseKb);
+}
+
+// 讀取整個檔案到 buffer (smaps_rollup 約 1 KB)；失敗時 error 為 errno
+std::string_view readFile(const char *path, char *buffer, size_t size, int &error) {
+    int fd;
+    do {
+        fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    if (fd < 0) {
+        error = errno;
+        return std::string_view();
+    }
+
+    size_t used = 0;
+    error = 0;
+    while (used < size) {
+        const ssize_t n = ::read(fd, buffer + used, size - used);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) error = errno;
+        if (n <= 0) break;
+        used += static_cast<size_t>(n);
+    }
+    ::close(fd);
+    return std::string_view(buffer, used);
+}
+
+// /proc/<pid>/stat：取出 comm 與 starttime (第 22 欄)
+bool parseStat(std::string_view content, char (&name)[16], quint64 &startTime) {
+    const size_t open = content.find('(');
+    const size_t close = content.rfind(')');
+    if (open == std::string_view::npos || close == std::string_view::npos || close < open) return false;
+
+    const std::string_view comm = content.substr(open + 1, close - open - 1);
+    const size_t nameLength = qMin(comm.size(), sizeof(name) - 1);
+    std::memcpy(name, comm.data(), nameLength);
+    name[nameLength] = '\0';
+
+    std::string_view fields = content.substr(close + 1);
+    std::string_view token;
+    for (int field = 3; field <= 22; ++field) {
+        if (!ProcText::nextToken(fields, token)) return false;
+    }
+    return ProcText::toU64(token, startTime);
+}
+}
+
+SmapsSampler::SmapsSampler()
+    : m_keys(kRollupKeys, sizeof(kRollupKeys) / sizeof(kRollupKeys[0]), ':') {
+    // 舊核心沒有 smaps_rollup；逐一讀 smaps 的成本太高，直接視為不支援
+    m_supported = ::access("/proc/self/smaps_rollup", R_OK) == 0;
+    m_pageKb = qMax(1L, sysconf(_SC_PAGESIZE) / 1024);
+}
+
+SmapsSampler::~SmapsSampler() {
+    for (auto &item : m_entries) release(item.second);
+    if (m_procDir) closedir(m_procDir);
+}
+
+void SmapsSampler::release(Entry &entry) {
+    if (entry.statmFd >= 0) {
+        ::close(entry.statmFd);
+        entry.statmFd = -1;
+        DescriptorBudget::release();
+    }
+}
+
+qint64 SmapsSampler::refreshIntervalMs(quint64 pssKb, qint64 growthKb, int stableReads) {
+    // 明顯變化的行程每秒重讀，以便及早發現記憶體洩漏
+    if (significantChange(pssKb, growthKb)) return kMinIntervalMs;
+
+    static const struct { quint64 minKb; qint64 intervalMs; } kTiers[] = {
+        {1024 * 1024, 1000},
+        {256 * 1024, 2000},
+        {64 * 1024, 5000},
+        {16 * 1024, 15000},
+        {0, 60000},
+    };
+    qint64 interval = kMaxIntervalMs;
+    for (const auto &tier : kTiers) {
+        if (pssKb >= tier.minKb) {
+            interval = tier.intervalMs;
+            break;
+        }
+    }
+
+    // 小而穩定的行程 (15 秒以上的級距) 連續不變時再延長
+    if (interval >= 15000 && stableReads >= 3) interval <<= qMin(stableReads - 2, 3);
+    return qMin(interval, kMaxIntervalMs);
+}
+
+void SmapsSampler::listPids(qint64 nowNs) {
+    m_due.clear();
+    if (!m_procDir) {
+        m_procDir = opendir("/proc");
+        if (!m_procDir) return;
+    } else {
+        rewinddir(m_procDir);
+    }
+
+    while (dirent *ent = readdir(m_procDir)) {
+        quint64 pid;
+        if (ent->d_name[0] < '1' || ent->d_name[0] > '9') continue;
+        if (!ProcText::toU64(ent->d_name, pid) || pid > 0x7fffffff) continue;
+
+        auto result = m_entries.try_emplace(static_cast<int>(pid));
+        Entry &entry = result.first->second;
+        entry.seenRound = m_round;
+        if (entry.state == New || nowNs >= entry.dueNs
+            || (entry.state == Measured && residentChanged(static_cast<int>(pid), entry))) {
+            m_due.push_back(&*result.first);
+        }
+    }
+}
+
+bool SmapsSampler::readResident(int pid, Entry &entry, quint64 &pages) {
+    // statm：size resident shared text lib data dt (單位為頁)
+    char buffer[128];
+    ssize_t n = -1;
+    if (entry.statmFd >= 0) {
+        do {
+            n = ::pread(entry.statmFd, buffer, sizeof(buffer), 0);
+        } while (n < 0 && errno == EINTR);
+    } else {
+        char path[40];
+        std::snprintf(path, sizeof(path), "/proc/%d/statm", pid);
+        int error = 0;
+        n = static_cast<ssize_t>(readFile(path, buffer, sizeof(buffer), error).size());
+    }
+    if (n <= 0) return false;
+
+    std::string_view content(buffer, static_cast<size_t>(n));
+    std::string_view token;
+    return ProcText::nextToken(content, token) && ProcText::nextToken(content, token) && ProcText::toU64(token, pages);
+}
+
+bool SmapsSampler::residentChanged(int pid, Entry &entry) {
+    quint64 pages = 0;
+    // 讀取失敗代表行程已結束 (或 PID 已被重複使用)：交給 readEntry 確認
+    if (!readResident(pid, entry, pages)) return true;
+    const qint64 deltaKb = (qint64(pages) - qint64(entry.residentPages)) * m_pageKb;
+    return significantChange(entry.residentPages * quint64(m_pageKb), deltaKb);
+}
+
+void SmapsSampler::readEntry(int pid, Entry &entry, qint64 nowNs) {
+    char path[40];
+    char buffer[4096];
+    int error = 0;
+
+    // stat 很便宜，每次讀取 smaps_rollup 前先確認仍是同一個行程
+    std::snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    char name[16];
+    quint64 startTime = 0;
+    if (!parseStat(readFile(path, buffer, 1024, error), name, startTime)) {
+        entry.alive = false;
+        return;
+    }
+    if (entry.state != New && entry.startTime != startTime) {
+        // PID 被重複使用：舊的數值與變化量都不可比較
+        const quint64 seenRound = entry.seenRound;
+        release(entry);
+        entry = Entry();
+        entry.seenRound = seenRound;
+    }
+    entry.startTime = startTime;
+    std::memcpy(entry.name, name, sizeof(name));
+
+    std::snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", pid);
+    const std::string_view content = readFile(path, buffer, sizeof(buffer), error);
+    entry.readNs = nowNs;
+    if (content.empty()) {
+        if (error == ENOENT) {
+            entry.alive = false;    // 在兩次讀取之間結束
+            return;
+        }
+        // 其他使用者的行程在 open 時就被拒絕；核心執行緒沒有 mm，read 回傳 ESRCH
+        // (剛好結束的行程也會是 ESRCH，下一輪 /proc 中沒有它時自然移除)
+        entry.state = (error == EACCES || error == EPERM) ? Denied : NoMemory;
+        entry.intervalNs = kRetryIntervalMs * kNsPerMs;
+        entry.dueNs = nowNs + entry.intervalNs;
+        return;
+    }
+
+    quint64 values[FieldCount] = {0, 0, 0, kMissing};
+    m_keys.parse(content, values);
+
+    const bool hadValue = entry.state == Measured;
+    const qint64 growthKb = hadValue ? qint64(values[Pss]) - qint64(entry.pssKb) : 0;
+    entry.stableReads = (hadValue && growthKb == 0) ? quint8(qMin(entry.stableReads + 1, 255)) : 0;
+
+    entry.pssKb = values[Pss];
+    entry.rssKb = values[Rss];
+    entry.swapKb = values[SwapPss] != kMissing ? values[SwapPss] : values[Swap]; // 沒有 SwapPss 時退回 Swap
+    entry.state = Measured;
+
+    // 記錄目前的常駐頁數，之後每輪與它比較
+    if (entry.statmFd < 0 && DescriptorBudget::acquire()) {
+        std::snprintf(path, sizeof(path), "/proc/%d/statm", pid);
+        do {
+            entry.statmFd = ::open(path, O_RDONLY | O_CLOEXEC);
+        } while (entry.statmFd < 0 && errno == EINTR);
+        if (entry.statmFd < 0) DescriptorBudget::release();
+    }
+    if (!readResident(pid, entry, entry.residentPages)) entry.residentPages = entry.rssKb / quint64(m_pageKb);
+
+    entry.intervalNs = refreshIntervalMs(entry.pssKb, growthKb, entry.stableReads) * kNsPerMs;
+    entry.dueNs = nowNs + entry.intervalNs;
+}
+
+void SmapsSampler::sample(MemoryTopSample &out) {
+    if (!m_supported) {
+        out.valid = false;
+        return;
+    }
+
+    const qint64 startNs = ProcText::monotonicNs();
+    ++m_round;
+    listPids(startNs);
+
+    // 新行程最優先，其餘依逾期時間相對於自己間隔的比例：
+    // 同樣逾期 2 秒，每秒該讀一次的大行程比每分鐘讀一次的小行程緊急得多
+    std::sort(m_due.begin(), m_due.end(), [startNs](const Item *a, const Item *b) {
+        const Entry &ea = a->second;
+        const Entry &eb = b->second;
+        if ((ea.state == New) != (eb.state == New)) return ea.state == New;
+        if (ea.state == New) return a->first < b->first;
+        const double urgencyA = double(startNs - ea.dueNs) / double(ea.intervalNs);
+        const double urgencyB = double(startNs - eb.dueNs) / double(eb.intervalNs);
+        if (urgencyA != urgencyB) return urgencyA > urgencyB;
+        return a->first < b->first;
+    });
+
+    // 至少讀一個，避免 /proc 走訪本身就用完預算時永遠沒有進度
+    size_t read = 0;
+    while (read < m_due.size()) {
+        if (read > 0 && ProcText::monotonicNs() - startNs >= kTickBudgetNs) break;
+        readEntry(m_due[read]->first, m_due[read]->second, startNs);
+        ++read;
+    }
+
+    // 移除已結束的行程，同時統計與收集可排名的項目
+    m_ranked.clear();
+    out.deniedCount = 0;
+    out.totalPssBytes = 0;
+    out.totalSwapBytes = 0;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        Entry &entry = it->second;
+        if (entry.seenRound != m_round || !entry.alive) {
+            release(entry);
+            it = m_entries.erase(it);
+            continue;
+        }
+        if (entry.state == Measured) {
+            m_ranked.push_back(&*it);
+            out.totalPssBytes += entry.pssKb * 1024;
+            out.totalSwapBytes += entry.swapKb * 1024;
+        } else if (entry.state == Denied) {
+            ++out.deniedCount;
+        }
+        ++it;
+    }
+
+    const size_t topCount = qMin<size_t>(m_ranked.size(), SnapshotLimits::kMaxTopProcesses);
+    std::partial_sort(m_ranked.begin(), m_ranked.begin() + static_cast<std::ptrdiff_t>(topCount), m_ranked.end(),
+                      [](const Item *a, const Item *b) {
+        if (a->second.pssKb != b->second.pssKb) return a->second.pssKb > b->second.pssKb;
+        return a->first < b->first;
+    });
+
+    out.valid = true;
+    out.processCount = static_cast<int>(m_entries.size());
+    out.measuredCount = static_cast<int>(m_ranked.size());
+    out.readCount = static_cast<int>(read);
+    out.pendingCount = static_cast<int>(m_due.size() - read);
+    out.count = static_cast<int>(topCount);
+    for (int i = 0; i < out.count; ++i) {
+        const Item *item = m_ranked[i];
+        const Entry &entry = item->second;
+        MemoryProcessSample &process = out.top[i];
+        process.pid = item->first;
+        std::memcpy(process.name.text, entry.name, sizeof(entry.name));
+        process.pssBytes = entry.pssKb * 1024;
+        process.rssBytes = entry.rssKb * 1024;
+        process.swapBytes = entry.swapKb * 1024;
+        process.ageMs = static_cast<qint32>((startNs - entry.readNs) / kNsPerMs);
+    }
+    out.scanMicros = (ProcText::monotonicNs() - startNs) / 1000;
+}
+
+#endif // Q_OS_LINUX
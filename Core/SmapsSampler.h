@@ -0,0 +1,91 @@
+#ifndef SMAPSSAMPLER_H
+#define SMAPSSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <dirent.h>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Linux 行程記憶體排行 (/proc/<pid>/smaps_rollup 的 PSS 與 SwapPss)
+ * smaps_rollup 需要走訪行程的每個 VMA，大型行程一次可達數毫秒，不能每輪全部重讀。
+ * 每個行程依上次的結果排定下次讀取時間：
+ *   - 依 PSS 大小分級，越大越常重讀 (1 GB 以上每秒，16 MB 以下每分鐘)；
+ *   - 與上次相比明顯成長或縮小的行程改為每秒重讀；
+ *   - 連續數次完全不變的行程間隔加倍 (上限 2 分鐘)。
+ * 尚未到期的行程每輪以 /proc/<pid>/statm 檢查常駐頁數 (O(1)，不走訪 VMA)，
+ * 與上次讀取 smaps_rollup 時相比明顯變化就立即到期，原本很小的行程開始暴增也能在一秒內發現。
+ * 每輪只在時間預算內讀取到期的行程，依逾期程度 (逾期時間 / 間隔) 排序，
+ * 新行程最優先；讀不完的留到下一輪，不會超出預算。
+ *
+ * 行程以 (pid, starttime) 識別；其他使用者的行程 (EACCES) 與核心執行緒 (沒有 mm，ESRCH)
+ * 每 5 分鐘才重試一次，只為了發現 PID 被重複使用。
+ * smaps_rollup 每次臨時開啟，不常駐描述元：讀取間隔以秒計，開檔成本可以忽略，
+ * 常駐的描述元反而會讓已結束行程的 mm_struct 無法釋放。
+ * statm 每輪都要讀，描述元常駐 (受 DescriptorBudget 限制，超出預算時每輪臨時開啟)。
+ */
+class SmapsSampler
+{
+public:
+    SmapsSampler();
+    ~SmapsSampler();
+
+    SmapsSampler(const SmapsSampler &) = delete;
+    SmapsSampler &operator=(const SmapsSampler &) = delete;
+
+    /** @brief 讀取本輪到期的行程並以快取數值排名 */
+    void sample(MemoryTopSample &out);
+
+    /**
+     * @brief 依 PSS 與上次讀取後的變化決定下次讀取的間隔
+     * @param stableReads 連續幾次讀到完全相同的 PSS
+     */
+    static qint64 refreshIntervalMs(quint64 pssKb, qint64 growthKb, int stableReads);
+
+private:
+    enum State : quint8 {
+        New = 0,      // 尚未讀取
+        Measured,
+        Denied,       // 權限不足
+        NoMemory      // 核心執行緒
+    };
+
+    struct Entry {
+        int statmFd = -1;         // 只有可量測的行程才開啟；超出描述元預算時為 -1
+        quint64 startTime = 0;
+        quint64 residentPages = 0; // 上次讀取 smaps_rollup 時 statm 的常駐頁數
+        quint64 pssKb = 0;
+        quint64 rssKb = 0;
+        quint64 swapKb = 0;
+        qint64 readNs = 0;        // 上次讀取 smaps_rollup 的時間
+        qint64 dueNs = 0;         // 下次到期時間
+        qint64 intervalNs = 0;
+        char name[16] = {0};
+        State state = New;
+        quint8 stableReads = 0;
+        bool alive = true;        // 讀取 stat 失敗代表已結束
+        quint64 seenRound = 0;
+    };
+    using Item = std::pair<const int, Entry>;
+
+    void listPids(qint64 nowNs);
+    void readEntry(int pid, Entry &entry, qint64 nowNs);
+    bool readResident(int pid, Entry &entry, quint64 &pages);
+    bool residentChanged(int pid, Entry &entry);
+    void release(Entry &entry);
+
+    DIR *m_procDir = nullptr;
+    std::unordered_map<int, Entry> m_entries;
+    std::vector<Item *> m_due;        // 本輪到期的行程 (重複使用容量)
+    std::vector<const Item *> m_ranked;
+    ProcKeyTable m_keys;
+    quint64 m_round = 0;
+    long m_pageKb = 4;
+    bool m_supported = false;         // smaps_rollup 自 4.14 起才有
+};
+#endif // Q_OS_LINUX
+
+#endif // SMAPSSAMPLER_H
@@ -0,0 +1,140 @@
+#ifndef SNAPSHOTBUFFER_H
+#define SNAPSHOTBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief 無鎖的「最新值」交換緩衝 (單一生產者、單一消費者)
+ * 三個緩衝區輪替：生產者寫 back、消費者讀 front，middle 透過一個原子變數交換。
+ * 兩端都不會阻塞，消費者永遠拿到最新一份完整的資料；交換本身只是一次原子操作。
+ * 注意 back 區保留的是兩次發布前的內容：生產者若需要沿用上一份的數值，
+ * 必須自行寫入完整的資料 (SystemCollector 每次發布時整份複製 m_working)。
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    TripleBuffer(const TripleBuffer &) = delete;
+    TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+    /** @brief 生產者：取得可寫入的緩衝區 (內容為兩次發布前的舊資料) */
+    T &writeBuffer() { return m_slots[m_back].value; }
+
+    /** @brief 生產者：發布 writeBuffer() 的內容 */
+    void publish() {
+        const uint8_t prev = m_middle.exchange(static_cast<uint8_t>(m_back | kFreshBit), std::memory_order_acq_rel);
+        m_back = prev & kIndexMask;
+    }
+
+    /**
+     * @brief 消費者：取得最新發布的資料
+     * 回傳的指標在同一消費者下一次呼叫 read() 前有效；尚未發布過則回傳 nullptr
+     */
+    const T *read() {
+        if (m_middle.load(std::memory_order_relaxed) & kFreshBit) {
+            const uint8_t prev = m_middle.exchange(m_front, std::memory_order_acq_rel);
+            m_front = prev & kIndexMask;
+            m_hasData = true;
+        }
+        return m_hasData ? &m_slots[m_front].value : nullptr;
+    }
+
+    /** @brief 消費者：是否有尚未讀取的新資料 */
+    bool hasNew() const { return m_middle.load(std::memory_order_relaxed) & kFreshBit; }
+
+private:
+    static constexpr uint8_t kIndexMask = 0x3;
+    static constexpr uint8_t kFreshBit = 0x4;
+
+    // 每個緩衝區獨占快取列，避免生產者與消費者互相干擾
+    struct alignas(64) Slot {
+        T value;
+    };
+    Slot m_slots[3];
+
+    alignas(64) std::atomic<uint8_t> m_middle{1};
+    alignas(64) uint8_t m_back = 0;   // 只由生產者存取
+    alignas(64) uint8_t m_front = 2;  // 只由消費者存取
+    bool m_hasData = false;
+};
+
+/**
+ * @brief 固定容量的無鎖環狀佇列 (單一生產者、單一消費者)
+ * 用於傳遞歷史取樣點：生產者不等待，佇列滿時丟棄並計數。
+ * Capacity 必須是 2 的冪次。
+ */
+template <typename T, std::size_t Capacity>
+class SpscRing
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(std::is_trivially_copyable<T>::value, "SpscRing stores trivially copyable values");
+
+public:
+    SpscRing() = default;
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    /** @brief 生產者：放入一筆資料，佇列已滿時回傳 false */
+    bool push(const T &value) {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail == Capacity) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail == Capacity) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        m_items[head & kMask] = value;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief 消費者：取出一筆資料，佇列為空時回傳 false */
+    bool pop(T &out) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cachedHead) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead) return false;
+        }
+        out = m_items[tail & kMask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** @brief 消費者：一次取出所有資料並逐筆交給 fn，回傳取出的筆數 */
+    template <typename Fn>
+    std::size_t drain(Fn &&fn) {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        const std::size_t head = m_head.load(std::memory_order_acquire);
+        for (std::size_t i = tail; i != head; ++i) {
+            fn(m_items[i & kMask]);
+        }
+        m_tail.store(head, std::memory_order_release);
+        return head - tail;
+    }
+
+    /** @brief 因佇列已滿而丟棄的筆數 */
+    std::size_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    T m_items[Capacity];
+
+    // 生產者端
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cachedTail = 0;
+    // 消費者端
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cachedHead = 0;
+
+    alignas(64) std::atomic<std::size_t> m_dropped{0};
+};
+
+#endif // SNAPSHOTBUFFER_H
@@ -0,0 +1,326 @@
+#include "SystemCollector.h"
+#include "SystemSampler.h"
+#include "SampleScheduler.h"
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QtAlgorithms>
+#include <QDebug>
+#include <algorithm>
+
+SystemCollector* SystemCollector::m_instance = nullptr;
+QMutex SystemCollector::m_mutex;
+
+SystemCollector::SystemCollector(QObject *parent) : QObject(parent) {
+    // 收集執行緒：所有取樣都在這裡進行，GUI 執行緒不會被 PDH 或檔案系統呼叫卡住
+    m_thread = new QThread(this);
+    m_thread->setObjectName("SystemCollector");
+
+    m_context = new QObject();
+    m_context->moveToThread(m_thread);
+    m_thread->start(QThread::LowPriority);
+
+    QMetaObject::invokeMethod(m_context, [this]() { startInThread(); }, Qt::QueuedConnection);
+
+    // PSI 停滯時收集執行緒已發布新快照：先丟棄本輪快取 (此連線先於小工具的連線執行)，
+    // 讓接收 pressureStall 的小工具讀到最新資料
+    connect(this, &SystemCollector::pressureStall, this, [this]() { m_current = nullptr; });
+
+    // 程式結束前先停止執行緒並釋放 PDH 資源
+    if (QCoreApplication::instance()) {
+        connect(QCoreApplication::instance(), &QCoreApplication::aboutToQuit, this, &SystemCollector::shutdown);
+    }
+}
+
+SystemCollector* SystemCollector::instance() {
+    if (!m_instance) {
+        QMutexLocker locker(&m_mutex);
+        if (!m_instance) {
+            m_instance = new SystemCollector();
+        }
+    }
+    return m_instance;
+}
+
+/** --- GUI 執行緒介面 --- **/
+
+void SystemCollector::setInterval(Domains domains, int ms) {
+    {
+        QMutexLocker locker(&m_stateMutex);
+        for (int i = 0; i < kDomainCount; ++i) {
+            if (domains.testFlag(static_cast<Domain>(1 << i))) {
+                m_intervals[i] = qMax(1, ms);
+            }
+        }
+    }
+    QMetaObject::invokeMethod(m_context, [this]() { rearmInThread(); }, Qt::QueuedConnection);
+}
+
+void SystemCollector::setEnabled(QObject *owner, Domains domains, bool enabled) {
+    QMutexLocker locker(&m_stateMutex);
+    if (!m_optionalOwners.contains(owner)) {
+        if (!enabled) return;
+        // owner 被刪除時撤銷它的需求
+        connect(owner, &QObject::destroyed, this, [this, owner]() {
+            QMutexLocker locker(&m_stateMutex);
+            m_optionalOwners.remove(owner);
+            updateEnabledLocked();
+        });
+    }
+
+    int &bits = m_optionalOwners[owner];
+    bits = enabled ? (bits | domains.toInt()) : (bits & ~domains.toInt());
+    updateEnabledLocked();
+}
+
+void SystemCollector::updateEnabledLocked() {
+    int after = kAlwaysEnabled;
+    for (int bits : std::as_const(m_optionalOwners)) after |= bits;
+    const int before = m_enabled.exchange(after, std::memory_order_relaxed);
+    if (before == after) return;
+
+    const Domains started = Domains::fromInt(after & ~before);
+    QMetaObject::invokeMethod(m_context, [this, started]() {
+        rearmInThread();
+        if (!started) return;
+
+        // 新啟用的領域立即取樣，不必等到下一個週期
+        for (int i = 0; i < kDomainCount; ++i) {
+            if (started.testFlag(static_cast<Domain>(1 << i))) m_nextDue[i] = 0;
+        }
+        collect();
+    }, Qt::QueuedConnection);
+}
+
+void SystemCollector::setCgroupView(const QString &subtree, int sortBy) {
+    QMutexLocker locker(&m_stateMutex);
+    m_cgroupSubtree = subtree;
+    m_cgroupSortBy = sortBy;
+}
+
+void SystemCollector::setFreqResidencyWindow(int seconds) {
+    QMutexLocker locker(&m_stateMutex);
+    m_freqWindowSec = qMax(1, seconds);
+}
+
+void SystemCollector::setPowercapRoot(const QString &root) {
+    QMutexLocker locker(&m_stateMutex);
+    m_powercapRoot = root;
+}
+
+void SystemCollector::setThreadTarget(int pid) {
+    QMutexLocker locker(&m_stateMutex);
+    m_threadPid = qMax(0, pid);
+}
+
+const SystemSnapshot *SystemCollector::snapshot() {
+    // 每個排程輪次只取一次最新快照，同一輪的小工具看到相同的取樣週期
+    const quint64 round = SampleScheduler::instance()->round();
+    if (!m_current || round != m_readRound) {
+        m_current = m_latest.read();
+        m_readRound = round;
+    }
+    return m_current;
+}
+
+int SystemCollector::drainHistory(const std::function<void(const MetricPoint &)> &fn) {
+    return static_cast<int>(m_history.drain(fn));
+}
+
+void SystemCollector::shutdown() {
+    if (!m_context || !m_thread->isRunning()) return;
+
+    QMetaObject::invokeMethod(m_context, [this]() { stopInThread(); }, Qt::BlockingQueuedConnection);
+    m_thread->quit();
+    m_thread->wait();
+
+    delete m_context;
+    m_context = nullptr;
+}
+
+/** --- 收集執行緒 --- **/
+
+void SystemCollector::startInThread() {
+    m_sampler = new SystemSampler();
+
+    m_tickTimer = new QTimer(m_context);
+    connect(m_tickTimer, &QTimer::timeout, m_context, [this]() { collect(); });
+    rearmInThread();
+
+    collect(); // 立即取樣一次，讓小工具不必等待一個完整週期
+}
+
+void SystemCollector::stopInThread() {
+    delete m_tickTimer;
+    m_tickTimer = nullptr;
+    delete m_pressureNotifier;
+    m_pressureNotifier = nullptr;
+    delete m_sampler;
+    m_sampler = nullptr;
+}
+
+void SystemCollector::rearmInThread() {
+    if (!m_tickTimer) return;
+
+    const Domains enabled = Domains::fromInt(m_enabled.load(std::memory_order_relaxed));
+    int tick = 0;
+    {
+        QMutexLocker locker(&m_stateMutex);
+        for (int i = 0; i < kDomainCount; ++i) {
+            if (!enabled.testFlag(static_cast<Domain>(1 << i))) continue;
+            if (tick == 0 || m_intervals[i] < tick) tick = m_intervals[i];
+        }
+    }
+    if (tick == 0) tick = 1000;
+    if (m_tickTimer->interval() != tick || !m_tickTimer->isActive()) {
+        m_tickTimer->start(tick);
+    }
+}
+
+void SystemCollector::collect() {
+    if (!m_sampler) return;
+
+    int intervals[kDomainCount];
+    QString cgroupSubtree;
+    int cgroupSortBy;
+    int freqWindowSec;
+    QString powercapRoot;
+    int threadPid;
+    {
+        QMutexLocker locker(&m_stateMutex);
+        std::copy(m_intervals, m_intervals + kDomainCount, intervals);
+        cgroupSubtree = m_cgroupSubtree;
+        cgroupSortBy = m_cgroupSortBy;
+        freqWindowSec = m_freqWindowSec;
+        powercapRoot = m_powercapRoot;
+        threadPid = m_threadPid;
+    }
+
+    // 以最短週期喚醒；較慢的領域允許半個週期的誤差，避免因計時抖動錯過一輪
+    const qint64 now = snapshotClockMs();
+    const int tolerance = (m_tickTimer ? m_tickTimer->interval() : 0) / 2;
+    const Domains enabled = Domains::fromInt(m_enabled.load(std::memory_order_relaxed));
+    Domains due;
+    for (int i = 0; i < kDomainCount; ++i) {
+        if (!enabled.testFlag(static_cast<Domain>(1 << i))) continue;
+        if (now + tolerance >= m_nextDue[i]) {
+            due |= static_cast<Domain>(1 << i);
+            m_nextDue[i] = now + intervals[i];
+        }
+    }
+    if (!due) return;
+
+    if (due.testFlag(Cpu)) m_sampler->sampleCpu(m_working.cpu);
+    if (due.testFlag(Memory)) m_sampler->sampleMemory(m_working.memory);
+    if (due.testFlag(Disk)) m_sampler->sampleDisks(m_working);
+    if (due.testFlag(Network)) m_sampler->sampleNetwork(m_working);
+    if (due.testFlag(Sensors)) m_sampler->sampleSensors(m_working);
+    if (due.testFlag(Processes)) m_sampler->sampleProcesses(m_working);
+    if (due.testFlag(Pressure)) {
+        m_sampler->samplePressure(m_working);
+        if (!m_pressureNotifier) watchPressureTriggers();
+    }
+    if (due.testFlag(Cgroups)) m_sampler->sampleCgroups(m_working, cgroupSubtree, cgroupSortBy);
+    if (due.testFlag(Interrupts)) m_sampler->sampleInterrupts(m_working);
+    if (due.testFlag(Scheduler)) m_sampler->sampleSched(m_working);
+    if (due.testFlag(CpuIdle)) m_sampler->sampleCpuIdle(m_working);
+    if (due.testFlag(FreqResidency)) m_sampler->sampleFreqResidency(m_working, freqWindowSec);
+    if (due.testFlag(Power)) m_sampler->samplePower(m_working, powercapRoot);
+    if (due.testFlag(Throttle)) m_sampler->sampleThrottle(m_working);
+    if (due.testFlag(Threads)) m_sampler->sampleThreads(m_working, threadPid);
+    if (due.testFlag(ProcessMemory)) m_sampler->sampleProcessMemory(m_working);
+
+    m_working.sequence = ++m_sequence;
+    m_working.timestampMs = now;
+
+    // 發布：整份複製到三重緩衝的 back 區後交換，不需要鎖也不配置記憶體。
+    // back 區是兩次發布前的內容，未到期的領域必須沿用 m_working 的數值，因此不能就地取樣；
+    // 複製約 100 KB，每個取樣週期一次 (成本見 Benchmarks 的 snapshot 量測)
+    m_latest.writeBuffer() = m_working;
+    m_latest.publish();
+
+    pushHistory(due);
+}
+
+void SystemCollector::watchPressureTriggers() {
+    const int fd = m_sampler->pressureTriggerFd();
+    if (fd < 0) return; // 核心不支援 trigger，維持週期取樣
+
+    m_pressureNotifier = new QSocketNotifier(fd, QSocketNotifier::Read, m_context);
+    connect(m_pressureNotifier, &QSocketNotifier::activated, m_context, [this]() {
+        m_sampler->drainPressureTriggers();
+        if (!(m_enabled.load(std::memory_order_relaxed) & Pressure)) return;
+
+        // 停滯發生：立即取樣並通知 GUI，不等下一個計時週期
+        m_nextDue[qCountTrailingZeroBits(quint32(Pressure))] = 0;
+        collect();
+        emit pressureStall();
+    });
+}
+
+void SystemCollector::pushHistory(Domains due) {
+    const SystemSnapshot &snap = m_working;
+    auto push = [&](quint16 kind, int slot, double value) {
+        m_history.push(MetricPoint{snap.timestampMs, kind, static_cast<quint16>(slot), static_cast<float>(value)});
+    };
+
+    if (due.testFlag(Cpu) && snap.cpu.valid) {
+        push(MetricPoint::CpuTotal, 0, snap.cpu.totalUsage);
+        for (int i = 0; i < snap.cpu.coreCount; ++i) {
+            push(MetricPoint::CpuCore, i, snap.cpu.coreUsage[i]);
+        }
+    }
+    if (due.testFlag(Memory) && snap.memory.valid) {
+        push(MetricPoint::MemoryLoad, 0, snap.memory.loadPercent);
+    }
+    if (due.testFlag(Disk)) {
+        for (int i = 0; i < snap.diskSlots; ++i) {
+            const DiskSample &disk = snap.disks[i];
+            if (!disk.present) continue;
+            push(MetricPoint::DiskRead, i, disk.readBytesPerSec);
+            push(MetricPoint::DiskWrite, i, disk.writeBytesPerSec);
+            push(MetricPoint::DiskActive, i, disk.activePercent);
+        }
+    }
+    if (due.testFlag(Network)) {
+        double totalSent = 0.0;
+        double totalRecv = 0.0;
+        for (int i = 0; i < snap.interfaceSlots; ++i) {
+            const NetworkSample &iface = snap.interfaces[i];
+            if (!iface.present) continue;
+            push(MetricPoint::NetSent, i, iface.sentBytesPerSec);
+            push(MetricPoint::NetRecv, i, iface.recvBytesPerSec);
+            totalSent += iface.sentBytesPerSec;
+            totalRecv += iface.recvBytesPerSec;
+        }
+        push(MetricPoint::NetSentTotal, 0, totalSent);
+        push(MetricPoint::NetRecvTotal, 0, totalRecv);
+    }
+    if (due.testFlag(Sensors)) {
+        for (int i = 0; i < snap.sensorCount; ++i) {
+            const SensorSample &sensor = snap.sensors[i];
+            if (!sensor.present) continue;
+            push(sensor.type == SensorSample::Fan ? MetricPoint::SensorFan : MetricPoint::SensorTemp, i, sensor.value);
+        }
+    }
+    if (due.testFlag(Scheduler)) {
+        const SchedSample &sched = snap.sched;
+        if (sched.valid) push(MetricPoint::LoadAvg1, 0, sched.load1);
+        if (sched.hasRunDelay) {
+            push(MetricPoint::RunDelayAvg, 0, sched.avgRunDelayMsPerSec);
+            for (int i = 0; i < sched.cpuCount; ++i) {
+                push(MetricPoint::RunDelay, i, sched.runDelayMsPerSec[i]);
+            }
+        }
+    }
+    if (due.testFlag(Power) && snap.power.valid) {
+        push(MetricPoint::PowerPackage, 0, snap.power.packageWatts);
+        for (int i = 0; i < snap.power.zoneCount; ++i) {
+            push(MetricPoint::PowerZone, i, snap.power.zones[i].watts);
+        }
+    }
+    if (due.testFlag(Throttle) && snap.throttle.valid) {
+        const ThrottleSample &throttle = snap.throttle;
+        for (int i = 0; i < throttle.coreCount; ++i) push(MetricPoint::ThrottleCore, i, throttle.coreEvents[i]);
+        for (int i = 0; i < throttle.packageCount; ++i) push(MetricPoint::ThrottlePackage, i, throttle.packageEvents[i]);
+    }
+}
@@ -0,0 +1,155 @@
+#ifndef SYSTEMCOLLECTOR_H
+#define SYSTEMCOLLECTOR_H
+
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QHash>
+#include <functional>
+#include <atomic>
+#include "SystemSnapshot.h"
+#include "SnapshotBuffer.h"
+
+class SystemSampler;
+class QSocketNotifier;
+
+/**
+ * @brief 系統資訊收集中心 (單例模式)
+ * 在專用的收集執行緒中執行所有取樣 (PDH、記憶體、硬碟與網路)，
+ * 每個取樣週期產生一份不可修改的 SystemSnapshot 交給 GUI 執行緒。
+ * 小工具在 updateData() 中只讀取快照並負責顯示。
+ *
+ * 資料交換完全無鎖：最新快照經由 TripleBuffer，歷史取樣點經由 SpscRing，
+ * 生產者 (收集執行緒) 與消費者 (GUI 執行緒) 都不會互相等待。
+ */
+class SystemCollector : public QObject
+{
+    Q_OBJECT
+public:
+    /** @brief 取樣領域，可用 | 組合 */
+    enum Domain {
+        Cpu = 0x1,
+        Memory = 0x2,
+        Disk = 0x4,
+        Network = 0x8,
+        Sensors = 0x10,     // 溫度與風扇 (選用，預設停用)
+        Processes = 0x20,   // 行程 CPU 排行 (選用，預設停用)
+        Pressure = 0x40,    // PSI 停滯資訊 (選用，預設停用)
+        Cgroups = 0x80,     // cgroup v2 用量排行 (選用，預設停用)
+        Interrupts = 0x100, // 中斷與 softirq 速率 (選用，預設停用)
+        Scheduler = 0x200,  // run queue 等待時間與負載 (選用，預設停用)
+        CpuIdle = 0x400,    // C-state 停留比例 (選用，預設停用)
+        FreqResidency = 0x800, // 頻率停留分佈 (選用，預設停用)
+        Power = 0x1000,     // RAPL 功耗 (選用，預設停用)
+        Throttle = 0x2000,  // 過熱降頻事件 (選用，預設停用)
+        Threads = 0x4000,   // 選取行程的執行緒排行 (選用，只在展開時啟用)
+        ProcessMemory = 0x8000 // 行程記憶體 (PSS) 排行 (選用，預設停用)
+    };
+    Q_DECLARE_FLAGS(Domains, Domain)
+
+    static SystemCollector* instance();
+
+    /**
+     * @brief 設定各領域的取樣週期，由對應的小工具在 setUpdateInterval 時呼叫
+     * 收集執行緒以所有領域中最短的週期喚醒，每次只取樣已到期的領域
+     */
+    void setInterval(Domains domains, int ms);
+
+    /**
+     * @brief 啟用或停用選用的取樣領域 (例如 Sensors)
+     * 停用的領域不會被取樣，也不影響收集執行緒的喚醒週期；
+     * 由對應的小工具在顯示設定改變時呼叫，沒有人需要的資料就不讀取。
+     * 以 owner 區分需求：同一個領域只要還有任何 owner 需要就維持啟用，
+     * owner 被刪除時自動撤銷它的需求。
+     */
+    void setEnabled(QObject *owner, Domains domains, bool enabled);
+
+    /**
+     * @brief 設定 Cgroups 領域要檢視的子樹與排序方式
+     * @param subtree 相對於 cgroup2 掛載點的路徑，空字串代表整個階層
+     * @param sortBy CgroupTopSample::SortKey
+     */
+    void setCgroupView(const QString &subtree, int sortBy);
+
+    /** @brief 設定 FreqResidency 領域的時間窗 (秒) */
+    void setFreqResidencyWindow(int seconds);
+
+    /** @brief 設定 Power 領域的 powercap 根目錄 (空字串代表 /sys/class/powercap) */
+    void setPowercapRoot(const QString &root);
+
+    /** @brief 設定 Threads 領域要展開的行程 (0 代表不展開) */
+    void setThreadTarget(int pid);
+
+    /**
+     * @brief 取得最新的快照 (僅限 GUI 執行緒，不會阻塞)
+     * 同一個排程輪次 (SampleScheduler::round) 內的所有呼叫都回傳同一份，
+     * 讓各小工具顯示的數值來自相同的取樣週期。尚未取樣前回傳空指標。
+     * 指標在下一個排程輪次前有效，請勿保存。
+     */
+    const SystemSnapshot *snapshot();
+
+    /**
+     * @brief 取出自上次呼叫以來的所有歷史取樣點 (僅限 GUI 執行緒)
+     * @return 取出的筆數
+     */
+    int drainHistory(const std::function<void(const MetricPoint &)> &fn);
+
+    /** @brief 停止收集執行緒 (程式結束時呼叫) */
+    void shutdown();
+
+signals:
+    /**
+     * @brief PSI trigger 觸發 (收集執行緒發出，以 queued 方式送達 GUI 執行緒)
+     * 發出前已完成一次 Pressure 取樣並發布快照，接收者可直接讀取 snapshot()
+     */
+    void pressureStall();
+
+private:
+    explicit SystemCollector(QObject *parent = nullptr);
+    static SystemCollector* m_instance;
+    static QMutex m_mutex;
+    static constexpr int kDomainCount = 16;
+    static constexpr int kAlwaysEnabled = int(Cpu) | int(Memory) | int(Disk) | int(Network);
+
+    void updateEnabledLocked(); // 依 m_optionalOwners 重新計算 m_enabled (需持有 m_stateMutex)
+
+    // --- 以下成員只在收集執行緒中存取 ---
+    void startInThread();
+    void stopInThread();
+    void rearmInThread();
+    void collect();
+    void pushHistory(Domains due);
+    void watchPressureTriggers();
+
+    QThread *m_thread;
+    QObject *m_context;         // 位於收集執行緒的事件接收者
+    QTimer *m_tickTimer = nullptr;
+    QSocketNotifier *m_pressureNotifier = nullptr;
+    SystemSampler *m_sampler = nullptr;
+    quint64 m_sequence = 0;
+    qint64 m_nextDue[kDomainCount] = {};
+    SystemSnapshot m_working;   // 下一份要發布的快照 (未到期的領域沿用上一份數值)
+
+    // --- 跨執行緒共享 ---
+    QMutex m_stateMutex;        // 只保護設定 (取樣週期、選用領域)，不在資料路徑上
+    int m_intervals[kDomainCount] = {1000, 1000, 2000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000}; // 依 Domain 位元順序
+    QHash<QObject *, int> m_optionalOwners; // owner -> 要求啟用的選用領域
+    std::atomic<int> m_enabled{kAlwaysEnabled}; // 已啟用的 Domain 位元
+    QString m_cgroupSubtree;
+    int m_cgroupSortBy = CgroupTopSample::ByCpu;
+    int m_freqWindowSec = 60;
+    QString m_powercapRoot;
+    int m_threadPid = 0;
+    TripleBuffer<SystemSnapshot> m_latest;
+    SpscRing<MetricPoint, 16384> m_history;
+
+    // --- GUI 執行緒快取 ---
+    const SystemSnapshot *m_current = nullptr;
+    quint64 m_readRound = 0;
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(SystemCollector::Domains)
+
+#endif // SYSTEMCOLLECTOR_H
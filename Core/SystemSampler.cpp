@@ -0,0 +1,619 @@
+#include "SystemSampler.h"
+#include <QStorageInfo>
+#include <QThread>
+#include <QDebug>
+
+#ifdef Q_OS_WIN
+// MinGW 某些版本可能缺少此結構定義，手動補上以避免編譯錯誤
+typedef struct _PROCESSOR_POWER_INFORMATION {
+    ULONG Number;
+    ULONG MaxMhz;
+    ULONG CurrentMhz;
+    ULONG MhzLimit;
+    ULONG MaxIdleState;
+    ULONG CurrentIdleState;
+} PROCESSOR_POWER_INFORMATION, *PPROCESSOR_POWER_INFORMATION;
+#endif
+
+SystemSampler::SystemSampler() {
+#ifdef Q_OS_WIN
+    initCpuPdh();
+    initDiskPdh();
+    initNetworkPdh();
+#endif
+}
+
+SystemSampler::~SystemSampler() {
+#ifdef Q_OS_WIN
+    if (m_pdhQuery) PdhCloseQuery(m_pdhQuery);
+    if (m_pdhFreqQuery) PdhCloseQuery(m_pdhFreqQuery);
+    if (m_pdhDiskQuery) PdhCloseQuery(m_pdhDiskQuery);
+    if (m_pdhNetQuery) PdhCloseQuery(m_pdhNetQuery);
+#endif
+}
+
+/** --- CPU --- **/
+
+void SystemSampler::sampleCpu(CpuSample &out) {
+#ifdef Q_OS_WIN
+    out.valid = true;
+    out.totalUsage = getCpuUsage();
+
+    if (!m_pdhQuery) return;
+
+    // 1. 取得 CPU 使用率 (PDH)
+    if (PdhCollectQueryData(m_pdhQuery) != ERROR_SUCCESS) return;
+
+    // 2. 取得 CPU 基礎頻率 (CallNtPowerInformation)
+    int coreCount = m_coreCounters.size();
+    std::vector<PROCESSOR_POWER_INFORMATION> ppi(coreCount);
+    long pwrStatus = CallNtPowerInformation(ProcessorInformation, NULL, 0, &ppi[0], coreCount * sizeof(PROCESSOR_POWER_INFORMATION));
+
+    // 3. 收集頻率效能數據
+    if (m_pdhFreqQuery) {
+        PdhCollectQueryData(m_pdhFreqQuery);
+    }
+
+    coreCount = qMin(coreCount, SnapshotLimits::kMaxCores);
+    out.coreCount = coreCount;
+
+    for (int i = 0; i < coreCount; ++i) {
+        // --- A. 取得使用率 ---
+        PDH_FMT_COUNTERVALUE value;
+        double usage = 0.0;
+        if (PdhGetFormattedCounterValue(m_coreCounters[i], PDH_FMT_DOUBLE, NULL, &value) == ERROR_SUCCESS) {
+            usage = value.doubleValue;
+        }
+
+        // --- B. 計算個別核心頻率 ---
+        // 取得該核心的基礎頻率
+        double baseMhz = 0.0;
+        if (pwrStatus == 0) {
+            baseMhz = ppi[i].MaxMhz;
+        }
+
+        // 取得該核心的效能百分比
+        double perfPercent = 100.0;
+        if (m_pdhFreqQuery && i < (int)m_freqCounters.size() && m_freqCounters[i]) {
+            PDH_FMT_COUNTERVALUE freqVal;
+            if (PdhGetFormattedCounterValue(m_freqCounters[i], PDH_FMT_DOUBLE, NULL, &freqVal) == ERROR_SUCCESS) {
+                perfPercent = freqVal.doubleValue;
+            }
+        }
+
+        out.coreUsage[i] = usage;
+        out.coreMhz[i] = baseMhz * (perfPercent / 100.0); // 真實頻率
+    }
+    m_topology.aggregate(out, out.topology);
+#elif defined(Q_OS_LINUX)
+    m_cpuStat.sample(out);
+    m_cpuFreq.sample(out); // 依 /proc/stat 得到的核心數讀取各核心頻率
+    m_topology.aggregate(out, out.topology);
+#else
+    Q_UNUSED(out);
+#endif
+}
+
+#ifdef Q_OS_WIN
+// 輔助函式：將 FILETIME 轉換為 unsigned long long
+static unsigned long long fileTimeToInt64(const FILETIME &ft) {
+    return (((unsigned long long)(ft.dwHighDateTime)) << 32) | ((unsigned long long)ft.dwLowDateTime);
+}
+
+double SystemSampler::getCpuUsage() {
+    FILETIME idleTime, kernelTime, userTime;
+    if (!GetSystemTimes(&idleTime, &kernelTime, &userTime)) {
+        return 0.0;
+    }
+
+    unsigned long long idleDiff = fileTimeToInt64(idleTime) - fileTimeToInt64(m_preIdleTime);
+    unsigned long long kernelDiff = fileTimeToInt64(kernelTime) - fileTimeToInt64(m_preKernelTime);
+    unsigned long long userDiff = fileTimeToInt64(userTime) - fileTimeToInt64(m_preUserTime);
+
+    // KernelTime 包含 IdleTime，所以總系統時間 = Kernel + User
+    unsigned long long totalSys = kernelDiff + userDiff;
+
+    double cpuPercent = 0.0;
+    if (totalSys > 0) {
+        // (Total - Idle) / Total
+        cpuPercent = (double)(totalSys - idleDiff) * 100.0 / totalSys;
+    }
+
+    // 儲存目前時間供下次計算
+    m_preIdleTime = idleTime;
+    m_preKernelTime = kernelTime;
+    m_preUserTime = userTime;
+
+    // 限制範圍 0-100
+    return qBound(0.0, cpuPercent, 100.0);
+}
+
+void SystemSampler::initCpuPdh() {
+    PDH_STATUS status = PdhOpenQuery(NULL, 0, &m_pdhQuery);
+    if (status != ERROR_SUCCESS) {
+        qWarning() << "PdhOpenQuery failed:" << status;
+        m_pdhQuery = NULL;
+        return;
+    }
+
+    // 取得邏輯核心數
+    int coreCount = QThread::idealThreadCount();
+    m_coreCounters.resize(coreCount);
+
+    for (int i = 0; i < coreCount; ++i) {
+        // 建立計數器路徑: \Processor(i)\% Processor Time
+        QString path = QString("\\Processor(%1)\\% Processor Time").arg(i);
+        status = PdhAddCounter(m_pdhQuery, path.toStdWString().c_str(), 0, &m_coreCounters[i]);
+        if (status != ERROR_SUCCESS) {
+            qWarning() << "PdhAddCounter failed for core" << i << ":" << status;
+        }
+    }
+
+    // 第一次收集數據 (通常第一次會失敗或無數據)
+    PdhCollectQueryData(m_pdhQuery);
+
+    // --- 初始化頻率查詢 (Processor Performance) ---
+    status = PdhOpenQuery(NULL, 0, &m_pdhFreqQuery);
+    if (status == ERROR_SUCCESS) {
+        m_freqCounters.resize(coreCount);
+        for (int i = 0; i < coreCount; ++i) {
+            // 格式: \Processor Information(群組,群組內編號)\% Processor Performance
+            // 超過 64 個邏輯處理器時分屬多個處理器群組，不能固定使用群組 0
+            int group, number;
+            CpuTopology::groupIndex(i, group, number);
+            QString path = QString("\\Processor Information(%1,%2)\\% Processor Performance").arg(group).arg(number);
+            status = PdhAddCounter(m_pdhFreqQuery, path.toStdWString().c_str(), 0, &m_freqCounters[i]);
+
+            if (status != ERROR_SUCCESS) {
+                 // Fallback: 嘗試舊版 "\Processor Performance(i)\% Processor Performance"
+                 path = QString("\\Processor Performance(%1)\\% Processor Performance").arg(i);
+                 status = PdhAddCounter(m_pdhFreqQuery, path.toStdWString().c_str(), 0, &m_freqCounters[i]);
+                 if (status != ERROR_SUCCESS) {
+                     qWarning() << "Failed to add freq counter for core" << i;
+                     m_freqCounters[i] = NULL;
+                 }
+            }
+        }
+        PdhCollectQueryData(m_pdhFreqQuery);
+    } else {
+        m_pdhFreqQuery = NULL;
+    }
+
+    // 溫度感測器：Linux 見 sampleSensors()；Windows 的 ACPI Thermal Zone 在許多系統上無效，暫不支援
+}
+#endif
+
+/** --- Memory --- **/
+
+void SystemSampler::sampleMemory(MemorySample &out) {
+#ifdef Q_OS_WIN
+    MEMORYSTATUSEX memInfo;
+    memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+    if (GlobalMemoryStatusEx(&memInfo)) {
+        out.valid = true;
+        out.loadPercent = (int)memInfo.dwMemoryLoad;
+        out.totalBytes = memInfo.ullTotalPhys;
+        out.availableBytes = memInfo.ullAvailPhys;
+    }
+#elif defined(Q_OS_LINUX)
+    m_memInfo.sample(out);
+#else
+    Q_UNUSED(out);
+#endif
+}
+
+/** --- 槽位分配 --- **/
+
+int SystemSampler::slotFor(QStringList &table, const QString &name, int capacity) {
+    int slot = table.indexOf(name);
+    if (slot < 0 && table.size() < capacity) {
+        table.append(name);
+        slot = table.size() - 1;
+    }
+    return slot; // 槽位已滿時回傳 -1，該項目不列入快照
+}
+
+/** --- Disk --- **/
+
+void SystemSampler::sampleDisks(SystemSnapshot &out) {
+#ifdef Q_OS_WIN
+    if (m_pdhDiskQuery) {
+        PdhCollectQueryData(m_pdhDiskQuery);
+    }
+    QStringList seenDrives;
+#endif
+
+    for (int i = 0; i < out.diskSlots; ++i) {
+        out.disks[i].present = false;
+    }
+
+    const QList<QStorageInfo> volumes = QStorageInfo::mountedVolumes();
+    for (const QStorageInfo &storage : volumes) {
+        if (!storage.isValid() || !storage.isReady()) continue;
+
+        // 注意：QStorageInfo 在 Windows 上 rootPath 就是 "C:/"
+        const QString rootPath = storage.rootPath();
+        const int slot = slotFor(m_diskSlots, rootPath, SnapshotLimits::kMaxDisks);
+        if (slot < 0) continue;
+
+        DiskSample &disk = out.disks[slot];
+        disk = DiskSample();
+        disk.present = true;
+        disk.rootPath.set(rootPath);
+        disk.displayName.set(storage.displayName());
+        disk.bytesTotal = storage.bytesTotal();
+        disk.bytesAvailable = storage.bytesAvailable();
+
+#ifdef Q_OS_WIN
+        // path 格式為 "C:/"，PDH 需要 "C:"
+        QString driveLetter = rootPath.left(2);
+        seenDrives.append(driveLetter);
+        if (!m_readCounters.contains(driveLetter)) {
+            // 新硬碟：加入 Pdh Counter，數據要到下一次收集才有效
+            addDiskCounter(driveLetter);
+        } else {
+            PDH_FMT_COUNTERVALUE value;
+            if (PdhGetFormattedCounterValue(m_readCounters[driveLetter], PDH_FMT_DOUBLE, NULL, &value) == ERROR_SUCCESS) {
+                disk.readBytesPerSec = value.doubleValue;
+            }
+            if (m_writeCounters.contains(driveLetter) &&
+                PdhGetFormattedCounterValue(m_writeCounters[driveLetter], PDH_FMT_DOUBLE, NULL, &value) == ERROR_SUCCESS) {
+                disk.writeBytesPerSec = value.doubleValue;
+            }
+            if (m_idleCounters.contains(driveLetter) &&
+                PdhGetFormattedCounterValue(m_idleCounters[driveLetter], PDH_FMT_DOUBLE, NULL, &value) == ERROR_SUCCESS) {
+                // Active Time = 100 - Idle Time
+                disk.activePercent = qBound(0.0, 100.0 - value.doubleValue, 100.0);
+            }
+        }
+#endif
+    }
+    out.diskSlots = m_diskSlots.size();
+
+#ifdef Q_OS_WIN
+    // 移除已拔除硬碟的計數器
+    const QStringList known = m_readCounters.keys();
+    for (const QString &driveLetter : known) {
+        if (!seenDrives.contains(driveLetter)) {
+            removeDiskCounter(driveLetter);
+        }
+    }
+#endif
+}
+
+#ifdef Q_OS_WIN
+void SystemSampler::initDiskPdh() {
+    if (PdhOpenQuery(NULL, 0, &m_pdhDiskQuery) != ERROR_SUCCESS) {
+        qWarning() << "Failed to open PDH query for disks";
+        m_pdhDiskQuery = NULL;
+    }
+}
+
+void SystemSampler::addDiskCounter(const QString &driveLetter) {
+    if (!m_pdhDiskQuery) return;
+    if (m_readCounters.contains(driveLetter)) return; // 已存在
+
+    // LogicalDisk(C:)\Disk Read Bytes/sec
+    QString readPath = QString("\\LogicalDisk(%1)\\Disk Read Bytes/sec").arg(driveLetter);
+    QString writePath = QString("\\LogicalDisk(%1)\\Disk Write Bytes/sec").arg(driveLetter);
+    QString idlePath = QString("\\LogicalDisk(%1)\\% Idle Time").arg(driveLetter);
+
+    PDH_HCOUNTER hRead, hWrite, hIdle;
+
+    if (PdhAddCounter(m_pdhDiskQuery, readPath.toStdWString().c_str(), 0, &hRead) == ERROR_SUCCESS) {
+        m_readCounters.insert(driveLetter, hRead);
+    } else {
+        qWarning() << "Failed to add read counter for" << driveLetter;
+    }
+
+    if (PdhAddCounter(m_pdhDiskQuery, writePath.toStdWString().c_str(), 0, &hWrite) == ERROR_SUCCESS) {
+        m_writeCounters.insert(driveLetter, hWrite);
+    } else {
+        qWarning() << "Failed to add write counter for" << driveLetter;
+    }
+
+    if (PdhAddCounter(m_pdhDiskQuery, idlePath.toStdWString().c_str(), 0, &hIdle) == ERROR_SUCCESS) {
+        m_idleCounters.insert(driveLetter, hIdle);
+    } else {
+        qWarning() << "Failed to add idle counter for" << driveLetter;
+    }
+}
+
+void SystemSampler::removeDiskCounter(const QString &driveLetter) {
+    if (!m_pdhDiskQuery) return;
+
+    if (m_readCounters.contains(driveLetter)) {
+        PdhRemoveCounter(m_readCounters.take(driveLetter));
+    }
+    if (m_writeCounters.contains(driveLetter)) {
+        PdhRemoveCounter(m_writeCounters.take(driveLetter));
+    }
+    if (m_idleCounters.contains(driveLetter)) {
+        PdhRemoveCounter(m_idleCounters.take(driveLetter));
+    }
+}
+#endif
+
+/** --- Network --- **/
+
+void SystemSampler::sampleNetwork(SystemSnapshot &out) {
+    for (int i = 0; i < out.interfaceSlots; ++i) {
+        out.interfaces[i].present = false;
+    }
+#ifdef Q_OS_WIN
+    if (!m_pdhNetQuery) {
+        initNetworkPdh();
+        if (!m_pdhNetQuery) return;
+    }
+
+    // 收集數據
+    PDH_STATUS collectStatus = PdhCollectQueryData(m_pdhNetQuery);
+    if (collectStatus != ERROR_SUCCESS) {
+        qWarning() << "PdhCollectQueryData failed:" << collectStatus;
+        return;
+    }
+
+    // Temporary storage for per-interface data (介面順序以 Sent 計數器為準)
+    QStringList names;
+    QMap<QString, double> sentMap;
+    QMap<QString, double> recvMap;
+
+    auto processCounter = [&](PDH_HCOUNTER counter, QMap<QString, double> &dataMap, bool isSent) {
+        if (!counter) return;
+
+        DWORD bufferSize = 0;
+        DWORD itemCount = 0;
+
+        PDH_STATUS status = PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE, &bufferSize, &itemCount, NULL);
+
+        if (status == PDH_MORE_DATA || (status == ERROR_SUCCESS && bufferSize > 0)) {
+            QVector<char> buffer(bufferSize);
+            PPDH_FMT_COUNTERVALUE_ITEM_W items = (PPDH_FMT_COUNTERVALUE_ITEM_W)buffer.data();
+
+            if (PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE, &bufferSize, &itemCount, items) == ERROR_SUCCESS) {
+                for (DWORD i = 0; i < itemCount; i++) {
+                    QString name = QString::fromWCharArray(items[i].szName);
+
+                    if (name.contains("Loopback", Qt::CaseInsensitive)) continue;
+
+                    if (isSent && !names.contains(name)) names.append(name);
+
+                    if (items[i].FmtValue.CStatus == PDH_CSTATUS_VALID_DATA ||
+                        items[i].FmtValue.CStatus == PDH_CSTATUS_NEW_DATA) {
+                        dataMap[name] = items[i].FmtValue.doubleValue;
+                    }
+                }
+            }
+        }
+    };
+
+    processCounter(m_pdhCounterSent, sentMap, true);
+    processCounter(m_pdhCounterReceived, recvMap, false);
+
+    for (const QString &name : names) {
+        const int slot = slotFor(m_interfaceSlots, name, SnapshotLimits::kMaxInterfaces);
+        if (slot < 0) continue;
+
+        NetworkSample &iface = out.interfaces[slot];
+        iface.present = true;
+        iface.name.set(name);
+        iface.sentBytesPerSec = sentMap.value(name, 0);
+        iface.recvBytesPerSec = recvMap.value(name, 0);
+    }
+    out.interfaceSlots = m_interfaceSlots.size();
+#endif
+}
+
+#ifdef Q_OS_WIN
+void SystemSampler::initNetworkPdh() {
+    if (PdhOpenQuery(NULL, 0, &m_pdhNetQuery) != ERROR_SUCCESS) {
+        qWarning() << "Failed to open PDH query for network";
+        m_pdhNetQuery = NULL;
+        return;
+    }
+
+    // 嘗試加入英文計數器 (Vista+)
+    // Network Interface(*)\Bytes Sent/sec
+    PDH_STATUS status = PdhAddEnglishCounterW(m_pdhNetQuery, L"\\Network Interface(*)\\Bytes Sent/sec", 0, &m_pdhCounterSent);
+    if (status != ERROR_SUCCESS) {
+        qWarning() << "Failed to add English counter for Sent (Status:" << status << "). Trying index-based...";
+        // Fallback: 使用索引路徑 \510(*)\506 (Network Interface / Bytes Sent/sec)
+        if (PdhAddCounterW(m_pdhNetQuery, L"\\510(*)\\506", 0, &m_pdhCounterSent) != ERROR_SUCCESS) {
+            qWarning() << "Failed to add index counter for Sent.";
+        }
+    }
+
+    status = PdhAddEnglishCounterW(m_pdhNetQuery, L"\\Network Interface(*)\\Bytes Received/sec", 0, &m_pdhCounterReceived);
+    if (status != ERROR_SUCCESS) {
+        qWarning() << "Failed to add English counter for Received (Status:" << status << "). Trying index-based...";
+        // Fallback: 使用索引路徑 \510(*)\264 (Network Interface / Bytes Received/sec)
+        if (PdhAddCounterW(m_pdhNetQuery, L"\\510(*)\\264", 0, &m_pdhCounterReceived) != ERROR_SUCCESS) {
+            qWarning() << "Failed to add index counter for Received.";
+        }
+    }
+
+    // 第一次收集數據 (初始化)
+    PdhCollectQueryData(m_pdhNetQuery);
+    qDebug() << "SystemSampler network PDH initialized. Query:" << m_pdhNetQuery << "Sent:" << m_pdhCounterSent << "Recv:" << m_pdhCounterReceived;
+}
+#endif
+
+/** --- Sensors --- **/
+
+void SystemSampler::sampleSensors(SystemSnapshot &out) {
+#ifdef Q_OS_LINUX
+    m_sensors.sample(out);
+#else
+    // Windows 的 MSAcpi_ThermalZoneTemperature 需要系統管理員權限且多數主機板不支援，暫不提供
+    Q_UNUSED(out);
+#endif
+}
+
+/** --- Processes --- **/
+
+void SystemSampler::sampleProcesses(SystemSnapshot &out) {
+#ifdef Q_OS_LINUX
+    if (!m_processes) m_processes = std::make_unique<ProcessSampler>();
+    m_processes->sample(out.processes);
+#else
+    Q_UNUSED(out);
+#endif
+}
+
+/** --- Pressure --- **/
+
+void SystemSampler::samplePressure(SystemSnapshot &out) {
+#ifdef Q_OS_LINUX
+    if (!m_pressure) m_pressure = std::make_unique<PressureSampler>();
+    m_pressure->sample(out.pressure);
+#else
+    Q_UNUSED(out);
+#endif
+}
+
+int SystemSampler::pressureTriggerFd() const {
+#ifdef Q_OS_LINUX
+    return m_pressure ? m_pressure->triggerFd() : -1;
+#else
+    return -1;
+#endif
+}
+
+void SystemSampler::drainPressureTriggers() {
+#ifdef Q_OS_LINUX
+    if (m_pressure) m_pressure->drainTriggers();
+#endif
+}
+
+/** --- Cgroups --- **/
+
+void SystemSampler::sampleCgroups(SystemSnapshot &out, const QString &subtree, int sortBy) {
+#ifdef Q_OS_LINUX
+    if (!m_cgroups) m_cgroups = std::make_unique<CgroupSampler>();
+
+    // 子樹為掛載點下的相對路徑：去掉前後的斜線，不允許 ".." 跳出 cgroup 階層
+    QString relative = subtree.trimmed();
+    while (relative.startsWith('/')) relative.remove(0, 1);
+    while (relative.endsWith('/')) relative.chop(1);
+    if (relative.split('/').contains(QStringLiteral(".."))) relative.clear();
+
+    const auto sortKey = static_cast<CgroupTopSample::SortKey>(qBound(0, sortBy, int(CgroupTopSample::ByIo)));
+    m_cgroups->configure(relative.toStdString(), sortKey);
+    m_cgroups->sample(out.cgroups);
+#else
+    Q_UNUSED(out);
+    Q_UNUSED(subtree);
+    Q_UNUSED(sortBy);
+#endif
+}
+
+/** --- Interrupts --- **/
+
+void SystemSampler::sampleInterrupts(SystemSnapshot &out) {
+#ifdef Q_OS_LINUX
+    if (!m_interrupts) m_interrupts = std::make_unique<InterruptSampler>();
+    m_interrupts->sample(out.interrupts);
+#else
+    Q_UNUSED(out);
+#endif
+}
+
+/** --- Scheduler --- **/
+
+void SystemSampler::sampleSched(SystemSnapshot &out) {
+#ifdef Q_OS_LINUX
+    if (!m_sched) m_sched = std::make_unique<SchedStatSampler>();
+    m_sched->sample(out.sched);
+#else
+    Q_UNUSED(out);
+#endif
+}
+
+/** --- CPU idle states --- **/
+
+void SystemSampler::sampleCpuIdle(SystemSnapshot &out) {
+#ifdef Q_OS_WIN
+    // Windows 只提供瞬間的 idle state，沒有累計停留時間
+    CpuIdleSample &idle = out.cpuIdle;
+    const int coreCount = qMin<int>(int(m_coreCounters.size()), SnapshotLimits::kMaxCores);
+    if (coreCount <= 0) return;
+    std::vector<PROCESSOR_POWER_INFORMATION> ppi(coreCount);
+    if (CallNtPowerInformation(ProcessorInformation, NULL, 0, &ppi[0], coreCount * sizeof(PROCESSOR_POWER_INFORMATION)) != 0) return;
+
+    idle.coreCount = coreCount;
+    idle.maxState = 0;
+    for (int i = 0; i < coreCount; ++i) {
+        idle.currentState[i] = quint8(qMin<ULONG>(ppi[i].CurrentIdleState, 255));
+        idle.maxState = qMax(idle.maxState, int(ppi[i].MaxIdleState));
+    }
+    idle.hasCurrentState = true;
+#elif defined(Q_OS_LINUX)
+    if (!m_cpuIdle) m_cpuIdle = std::make_unique<CpuIdleSampler>();
+    m_cpuIdle->sample(out.cpuIdle);
+#else
+    Q_UNUSED(out);
+#endif
+}
+
+/** --- Frequency residency --- **/
+
+void SystemSampler::sampleFreqResidency(SystemSnapshot &out, int windowSec) {
+#ifdef Q_OS_LINUX
+    if (!m_freqResidency) m_freqResidency = std::make_unique<FreqResidencySampler>();
+    m_freqResidency->sample(out.freqResidency, windowSec);
+#else
+    Q_UNUSED(out);
+    Q_UNUSED(windowSec);
+#endif
+}
+
+/** --- Power --- **/
+
+void SystemSampler::samplePower(SystemSnapshot &out, const QString &powercapRoot) {
+#ifdef Q_OS_LINUX
+    if (!m_rapl) m_rapl = std::make_unique<RaplSampler>();
+
+    QString root = powercapRoot.trimmed();
+    while (root.size() > 1 && root.endsWith('/')) root.chop(1);
+    if (root.isEmpty()) root = QStringLiteral("/sys/class/powercap");
+    m_rapl->configure(root.toStdString());
+    m_rapl->sample(out.power);
+#else
+    Q_UNUSED(out);
+    Q_UNUSED(powercapRoot);
+#endif
+}
+
+/** --- Thermal throttling --- **/
+
+void SystemSampler::sampleThrottle(SystemSnapshot &out) {
+#ifdef Q_OS_LINUX
+    if (!m_throttle) m_throttle = std::make_unique<ThrottleSampler>();
+    m_throttle->sample(out.throttle);
+#else
+    Q_UNUSED(out);
+#endif
+}
+
+/** --- Threads --- **/
+
+void SystemSampler::sampleThreads(SystemSnapshot &out, int pid) {
+#ifdef Q_OS_LINUX
+    if (!m_threads) m_threads = std::make_unique<ThreadSampler>();
+    m_threads->sample(pid, out.threads);
+#else
+    Q_UNUSED(out);
+    Q_UNUSED(pid);
+#endif
+}
+
+/** --- Process memory --- **/
+
+void SystemSampler::sampleProcessMemory(SystemSnapshot &out) {
+#ifdef Q_OS_LINUX
+    if (!m_smaps) m_smaps = std::make_unique<SmapsSampler>();
+    m_smaps->sample(out.memoryTop);
+#else
+    Q_UNUSED(out);
+#endif
+}
@@ -0,0 +1,131 @@
+#ifndef SYSTEMSAMPLER_H
+#define SYSTEMSAMPLER_H
+
+#include "SystemSnapshot.h"
+#include "CpuTopology.h"
+#include <QMap>
+#include <QVector>
+#include <QStringList>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <pdh.h>
+#include <pdhmsg.h>
+#include <powrprof.h>
+#include <vector>
+#endif
+
+#ifdef Q_OS_LINUX
+#include "CgroupSampler.h"
+#include "CpuIdleSampler.h"
+#include "CpuStatSampler.h"
+#include "CpuFreqSampler.h"
+#include "FreqResidencySampler.h"
+#include "InterruptSampler.h"
+#include "MemInfoSampler.h"
+#include "SensorSampler.h"
+#include "ProcessSampler.h"
+#include "PressureSampler.h"
+#include "RaplSampler.h"
+#include "SchedStatSampler.h"
+#include "SmapsSampler.h"
+#include "ThreadSampler.h"
+#include "ThrottleSampler.h"
+#include <memory>
+#endif
+
+/**
+ * @brief 系統資訊取樣器
+ * 集中各平台的取樣實作 (PDH、GlobalMemoryStatusEx、QStorageInfo、Linux procfs ...)，
+ * 只在收集執行緒中使用，不碰任何 UI 元件。
+ */
+class SystemSampler
+{
+public:
+    SystemSampler();
+    ~SystemSampler();
+
+    void sampleCpu(CpuSample &out);
+    void sampleMemory(MemorySample &out);
+    void sampleDisks(SystemSnapshot &out);
+    void sampleNetwork(SystemSnapshot &out);
+    void sampleSensors(SystemSnapshot &out);
+    void sampleProcesses(SystemSnapshot &out);
+    void samplePressure(SystemSnapshot &out);
+    void sampleCgroups(SystemSnapshot &out, const QString &subtree, int sortBy);
+    void sampleInterrupts(SystemSnapshot &out);
+    void sampleSched(SystemSnapshot &out);
+    void sampleCpuIdle(SystemSnapshot &out);
+    void sampleFreqResidency(SystemSnapshot &out, int windowSec);
+    void samplePower(SystemSnapshot &out, const QString &powercapRoot);
+    void sampleThrottle(SystemSnapshot &out);
+    void sampleThreads(SystemSnapshot &out, int pid);
+    void sampleProcessMemory(SystemSnapshot &out);
+
+    /** @brief PSI trigger 的 epoll 描述元 (-1 代表不支援)，需先呼叫過 samplePressure */
+    int pressureTriggerFd() const;
+    void drainPressureTriggers();
+
+private:
+    // 名稱 -> 槽位 (只增不減，槽位一旦分配就不再改變)
+    QStringList m_diskSlots;
+    QStringList m_interfaceSlots;
+    static int slotFor(QStringList &table, const QString &name, int capacity);
+
+    CpuTopology m_topology;     // 建立時讀取一次
+
+#ifdef Q_OS_WIN
+    // --- CPU ---
+    FILETIME m_preIdleTime = {0, 0};
+    FILETIME m_preKernelTime = {0, 0};
+    FILETIME m_preUserTime = {0, 0};
+
+    // Pdh for per-core usage
+    PDH_HQUERY m_pdhQuery = NULL;
+    std::vector<PDH_HCOUNTER> m_coreCounters;
+
+    // Pdh for Processor Performance (Frequency)
+    PDH_HQUERY m_pdhFreqQuery = NULL;
+    std::vector<PDH_HCOUNTER> m_freqCounters;
+
+    double getCpuUsage();
+    void initCpuPdh();
+
+    // --- Disk ---
+    PDH_HQUERY m_pdhDiskQuery = NULL;
+    // Key: Drive Letter (e.g., "C:") -> Counter
+    QMap<QString, PDH_HCOUNTER> m_readCounters;
+    QMap<QString, PDH_HCOUNTER> m_writeCounters;
+    QMap<QString, PDH_HCOUNTER> m_idleCounters;
+
+    void initDiskPdh();
+    void addDiskCounter(const QString &driveLetter);
+    void removeDiskCounter(const QString &driveLetter);
+
+    // --- Network ---
+    PDH_HQUERY m_pdhNetQuery = NULL;
+    PDH_HCOUNTER m_pdhCounterSent = NULL;
+    PDH_HCOUNTER m_pdhCounterReceived = NULL;
+    void initNetworkPdh();
+#endif
+
+#ifdef Q_OS_LINUX
+    CpuStatSampler m_cpuStat;
+    CpuFreqSampler m_cpuFreq;
+    MemInfoSampler m_memInfo;
+    SensorSampler m_sensors;
+    std::unique_ptr<ProcessSampler> m_processes; // 第一次需要時才建立 (會調整描述元上限並建立執行緒池)
+    std::unique_ptr<PressureSampler> m_pressure;  // 第一次需要時才建立 (會向核心註冊 trigger)
+    std::unique_ptr<CgroupSampler> m_cgroups;     // 第一次需要時才建立 (會建立 inotify)
+    std::unique_ptr<InterruptSampler> m_interrupts; // 第一次需要時才建立 (大型主機的 /proc/interrupts 可達數百 KB)
+    std::unique_ptr<SchedStatSampler> m_sched;
+    std::unique_ptr<CpuIdleSampler> m_cpuIdle; // 大型主機上常駐數千個描述元，只在啟用時建立
+    std::unique_ptr<FreqResidencySampler> m_freqResidency;
+    std::unique_ptr<RaplSampler> m_rapl;
+    std::unique_ptr<ThrottleSampler> m_throttle;
+    std::unique_ptr<ThreadSampler> m_threads;
+    std::unique_ptr<SmapsSampler> m_smaps;
+#endif
+};
+
+#endif // SYSTEMSAMPLER_H
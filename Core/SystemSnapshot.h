@@ -0,0 +1,482 @@
+#ifndef SYSTEMSNAPSHOT_H
+#define SYSTEMSNAPSHOT_H
+
+#include <QString>
+#include <QtGlobal>
+#include <QElapsedTimer>
+#include <cstring>
+
+/**
+ * @brief 單次取樣結果 (由收集執行緒產生，發布後即不可修改)
+ * 同一個快照內的 CPU、記憶體、硬碟與網路數值來自同一個取樣週期，
+ * 小工具只需負責格式化與顯示。
+ *
+ * 所有結構都是固定配置 (不含 Qt 容器)，可直接放進無鎖緩衝區交換。
+ * 硬碟與網路介面使用「槽位」：同一名稱在程式執行期間固定對應同一個索引，
+ * 歷史資料只需記錄槽位即可對應回名稱。
+ */
+
+/** @brief 行程共用的單調時鐘 (毫秒)，快照與歷史資料的時間戳都以此為準 */
+inline qint64 snapshotClockMs() {
+    static const QElapsedTimer clock = [] { QElapsedTimer t; t.start(); return t; }();
+    return clock.elapsed();
+}
+
+namespace SnapshotLimits {
+constexpr int kMaxCores = 256;
+constexpr int kMaxPackages = 16;
+constexpr int kMaxDisks = 32;
+constexpr int kMaxInterfaces = 64;
+constexpr int kMaxSensors = 64;
+constexpr int kMaxTopProcesses = 16;
+constexpr int kMaxTopThreads = 32;
+constexpr int kMaxTopCgroups = 16;
+constexpr int kMaxTopIrqs = 16;
+constexpr int kMaxSoftirqTypes = 16;
+constexpr int kMaxIdleStates = 10;     // cpuidle 驅動的狀態數 (intel_idle 最多約 8 個)
+constexpr int kMaxFreqPolicies = 64;   // cpufreq policy 數 (acpi-cpufreq 可能每個核心一個)
+constexpr int kMaxFreqSteps = 32;      // time_in_state 的頻率檔位數
+constexpr int kMaxPowerZones = 32;     // RAPL 區域 (每個插槽的 package、core、uncore、dram 與 psys)
+constexpr int kNameLength = 128;
+}
+
+/** @brief 固定長度的 UTF-8 名稱欄位 */
+struct SampleName {
+    char text[SnapshotLimits::kNameLength] = {0};
+
+    void set(const QString &name) {
+        const QByteArray utf8 = name.toUtf8();
+        const int len = qMin<int>(utf8.size(), SnapshotLimits::kNameLength - 1);
+        std::memcpy(text, utf8.constData(), len);
+        text[len] = '\0';
+    }
+    QString toString() const { return QString::fromUtf8(text); }
+    bool equals(const QString &name) const { return toString() == name; }
+};
+
+/** @brief 一組邏輯處理器 (插槽、實體核心或核心類型) 的彙總 */
+struct CpuGroupSample {
+    float usage = 0.0f;           // 平均使用率 (%)
+    float mhz = 0.0f;             // 平均頻率 (只計入有頻率的執行緒)，0 代表無法取得
+    quint16 threads = 0;          // 邏輯處理器數
+    quint16 cores = 0;            // 實體核心數
+};
+
+/**
+ * @brief 依拓撲彙總的 CPU 使用率與頻率：插槽 -> 實體核心 -> SMT 執行緒
+ * 實體核心依 (插槽、類型、核心編號) 排序，列出時自然依插槽與 P/E 核心分組。
+ */
+struct CpuTopologySample {
+    enum CoreType : quint8 {
+        Performance = 0,          // 非混合架構的核心都歸為此類
+        Efficiency,
+        TypeCount
+    };
+
+    bool valid = false;
+    bool hybrid = false;          // 同時有 P-core 與 E-core
+    int packageCount = 0;
+    CpuGroupSample packages[SnapshotLimits::kMaxPackages];
+    CpuGroupSample types[TypeCount];
+
+    int coreCount = 0;            // 實體核心數
+    CpuGroupSample cores[SnapshotLimits::kMaxCores];
+    quint8 corePackage[SnapshotLimits::kMaxCores] = {};
+    quint8 coreType[SnapshotLimits::kMaxCores] = {};
+    qint16 threadCore[SnapshotLimits::kMaxCores] = {}; // 邏輯處理器 -> cores[] 索引，-1 代表離線或未知
+};
+
+struct CpuSample {
+    bool valid = false;
+    double totalUsage = 0.0;                         // 整體使用率 (%)
+    int coreCount = 0;
+    float coreUsage[SnapshotLimits::kMaxCores] = {}; // 各邏輯核心使用率 (%)
+    float coreMhz[SnapshotLimits::kMaxCores] = {};   // 各邏輯核心目前頻率 (MHz)，0 代表無法取得
+
+    // 時間分類 (%，佔全部 CPU 時間)，目前只有 Linux 提供
+    bool hasBreakdown = false;
+    float userPercent = 0.0f;     // user + nice
+    float systemPercent = 0.0f;
+    float iowaitPercent = 0.0f;
+    float irqPercent = 0.0f;      // irq + softirq
+    float stealPercent = 0.0f;    // 虛擬機被 hypervisor 佔用的時間
+
+    // 全系統排程活動 (每秒)，目前只有 Linux 提供
+    bool hasActivity = false;
+    double contextSwitchesPerSec = 0.0;
+    double forksPerSec = 0.0;
+    int procsRunning = 0;         // 目前可執行 (執行中或在 run queue 等待) 的工作數
+    int procsBlocked = 0;         // 等待 I/O 完成的工作數
+
+    CpuTopologySample topology;
+};
+
+struct MemorySample {
+    bool valid = false;
+    int loadPercent = 0;
+    quint64 totalBytes = 0;
+    quint64 availableBytes = 0;
+
+    // 詳細分類 (/proc/meminfo)，目前只有 Linux 提供
+    bool hasBreakdown = false;
+    quint64 cachedBytes = 0;      // 頁面快取 (不含 swap cache)
+    quint64 buffersBytes = 0;
+    quint64 dirtyBytes = 0;
+    quint64 writebackBytes = 0;
+    quint64 slabBytes = 0;
+    quint64 shmemBytes = 0;
+    quint64 swapTotalBytes = 0;
+    quint64 swapUsedBytes = 0;
+    quint64 zswapBytes = 0;       // zswap 壓縮後佔用的記憶體
+    quint64 zswappedBytes = 0;    // 存放在 zswap 中的原始資料量
+    quint64 zramBytes = 0;        // 所有 zram 裝置佔用的記憶體 (mm_stat mem_used_total)
+    quint64 zramDataBytes = 0;    // 所有 zram 裝置存放的原始資料量
+
+    // 分頁事件速率 (/proc/vmstat，每秒)
+    bool hasVmstat = false;
+    double pageFaultsPerSec = 0.0;
+    double majorFaultsPerSec = 0.0;
+    double swapInPerSec = 0.0;    // 分頁數
+    double swapOutPerSec = 0.0;
+};
+
+struct DiskSample {
+    bool present = false;         // 此槽位目前是否掛載
+    SampleName rootPath;          // 例如 "C:/"
+    SampleName displayName;
+    quint64 bytesTotal = 0;
+    quint64 bytesAvailable = 0;
+    double readBytesPerSec = 0.0;
+    double writeBytesPerSec = 0.0;
+    double activePercent = 0.0;   // Active Time = 100 - Idle Time
+};
+
+struct NetworkSample {
+    bool present = false;         // 此槽位目前是否存在
+    SampleName name;
+    double sentBytesPerSec = 0.0;
+    double recvBytesPerSec = 0.0;
+};
+
+struct SensorSample {
+    enum Type : quint8 {
+        Temperature = 0,          // °C
+        Fan                       // RPM
+    };
+
+    bool present = false;         // 本次是否讀取成功
+    quint8 type = Temperature;
+    SampleName label;             // 例如 "Package id 0"、"Core 3"、"fan1"
+    float value = 0.0f;
+};
+
+struct ProcessSample {
+    int pid = 0;
+    SampleName name;
+    float cpuPercent = 0.0f;      // 以單一核心為 100% (與 top 相同)
+    quint64 rssBytes = 0;
+};
+
+/** @brief CPU 使用率前幾名的行程 (依 cpuPercent 由高到低) */
+struct ProcessTopSample {
+    bool valid = false;
+    int processCount = 0;         // 本輪掃描到的行程數
+    qint64 scanMicros = 0;        // 本輪掃描耗時
+    int count = 0;
+    ProcessSample top[SnapshotLimits::kMaxTopProcesses];
+};
+
+struct MemoryProcessSample {
+    int pid = 0;
+    SampleName name;
+    quint64 pssBytes = 0;         // 共用頁面依共用的行程數平分，所有行程合計不會重複計算
+    quint64 rssBytes = 0;
+    quint64 swapBytes = 0;        // SwapPss (舊核心沒有時為 Swap)
+    qint32 ageMs = 0;             // 距離上次讀取 smaps_rollup 的時間
+};
+
+/** @brief PSS 前幾名的行程 (依 pssBytes 由高到低，數值來自各行程最近一次讀取) */
+struct MemoryTopSample {
+    bool valid = false;
+    int processCount = 0;         // /proc 中的行程數
+    int measuredCount = 0;        // 已有 smaps_rollup 數值的行程數
+    int deniedCount = 0;          // 權限不足 (其他使用者的行程)
+    int readCount = 0;            // 本輪讀取的 smaps_rollup 數
+    int pendingCount = 0;         // 已到期但超出本輪時間預算的行程數
+    qint64 scanMicros = 0;
+    quint64 totalPssBytes = 0;    // 所有已量測行程合計
+    quint64 totalSwapBytes = 0;
+    int count = 0;
+    MemoryProcessSample top[SnapshotLimits::kMaxTopProcesses];
+};
+
+struct ThreadSample {
+    int tid = 0;
+    SampleName name;              // comm (可由 pthread_setname_np 設定)
+    float cpuPercent = 0.0f;      // 以單一核心為 100%
+    char state = '?';             // R、S、D ...
+    int lastCpu = -1;             // 最後執行的 CPU
+    float runDelayMsPerSec = -1.0f; // 在 run queue 等待的時間，-1 代表核心沒有 schedstat
+};
+
+/** @brief 單一行程的執行緒排行 (只在選取行程時取樣) */
+struct ThreadTopSample {
+    bool valid = false;           // 第一次掃描只建立基準
+    bool exited = false;          // 選取的行程已結束
+    int pid = 0;
+    SampleName processName;
+    int threadCount = 0;
+    int count = 0;                // 依 CPU 使用率排序的前幾名
+    ThreadSample top[SnapshotLimits::kMaxTopThreads];
+    qint64 scanMicros = 0;
+};
+
+struct CgroupSample {
+    SampleName path;              // 相對於所選子樹的路徑，例如 "system.slice/docker-1234.scope"
+    float cpuPercent = 0.0f;      // 以單一核心為 100%
+    quint64 memoryBytes = 0;      // memory.current
+    quint64 anonBytes = 0;        // memory.stat anon (只有排行中的 cgroup 才讀取)
+    quint64 fileBytes = 0;        // memory.stat file (頁面快取)
+    double ioBytesPerSec = 0.0;   // io.stat rbytes + wbytes
+};
+
+/** @brief cgroup v2 子樹中用量最高的 cgroup */
+struct CgroupTopSample {
+    enum SortKey {
+        ByCpu = 0,
+        ByMemory,
+        ByIo
+    };
+
+    bool valid = false;
+    int cgroupCount = 0;          // 子樹中的 cgroup 數量
+    int populatedCount = 0;       // 其中有行程的數量 (只有這些會被讀取)
+    qint64 scanMicros = 0;
+    int count = 0;
+    CgroupSample top[SnapshotLimits::kMaxTopCgroups];
+};
+
+/** @brief Pressure Stall Information (/proc/pressure/*)，百分比為等待資源的時間比例 */
+struct PressureSample {
+    enum Resource {
+        Cpu = 0,
+        Memory,
+        Io,
+        ResourceCount
+    };
+
+    bool valid = false;
+    bool hasFull = false;         // 舊核心的 cpu 沒有 full 行
+    float someAvg10 = 0.0f;       // 至少一個工作在等待 (%)
+    float someAvg60 = 0.0f;
+    float fullAvg10 = 0.0f;       // 所有非閒置工作同時在等待 (%)
+    float fullAvg60 = 0.0f;
+    quint64 someDeltaUs = 0;      // 與上一次取樣之間新增的停滯時間 (微秒)
+    quint64 fullDeltaUs = 0;
+};
+
+struct IrqSample {
+    SampleName name;              // IRQ 編號 (或 LOC、RES 等) 與裝置名稱
+    double perSec = 0.0;          // 所有 CPU 合計
+};
+
+struct InterruptSample {
+    bool valid = false;           // 第一次取樣只建立基準
+    int cpuCount = 0;             // 索引為 CPU 編號
+    float irqPerSec[SnapshotLimits::kMaxCores] = {};     // 各 CPU 的硬體中斷 (/proc/interrupts 合計)
+    float softirqPerSec[SnapshotLimits::kMaxCores] = {}; // 各 CPU 的 softirq
+    double totalIrqPerSec = 0.0;
+    double totalSoftirqPerSec = 0.0;
+
+    int softirqTypeCount = 0;     // HI、TIMER、NET_RX ... (依 /proc/softirqs 順序)
+    SampleName softirqNames[SnapshotLimits::kMaxSoftirqTypes];
+    double softirqTypePerSec[SnapshotLimits::kMaxSoftirqTypes] = {};
+
+    int irqSourceCount = 0;       // /proc/interrupts 的列數
+    int topCount = 0;             // 依速率排序的前幾名中斷來源
+    IrqSample top[SnapshotLimits::kMaxTopIrqs];
+    qint64 scanMicros = 0;
+};
+
+/**
+ * @brief 排程延遲與負載 (/proc/schedstat、/proc/loadavg)
+ * run delay 是工作已可執行、卻在 run queue 等待 CPU 的時間；
+ * 每秒累積的等待時間 (ms/s) 除以 1000 即為該 CPU 平均在等待的工作數，
+ * 持續超過 1000 ms/s 代表工作數多於 CPU 能消化的量。
+ */
+struct SchedSample {
+    bool valid = false;           // loadavg 可用
+    float load1 = 0.0f;
+    float load5 = 0.0f;
+    float load15 = 0.0f;
+    int runnable = 0;             // loadavg 的可執行工作數
+    int threads = 0;              // 系統中的工作 (執行緒) 總數
+
+    bool hasRunDelay = false;     // 核心提供 schedstat (CONFIG_SCHED_INFO) 且已有基準
+    int cpuCount = 0;             // 索引為 CPU 編號
+    float runDelayMsPerSec[SnapshotLimits::kMaxCores] = {}; // 各 CPU 每秒累積的等待時間
+    float avgRunDelayMsPerSec = 0.0f; // 所有上線 CPU 的平均
+};
+
+/**
+ * @brief 各核心的 C-state 停留比例 (Linux cpuidle sysfs)
+ * residency 為取樣間隔內停留在各 idle state 的時間比例；
+ * 100% 減去所有 idle state 的合計即為 C0 (執行或忙碌輪詢) 的比例。
+ * Windows 只能取得瞬間的 idle state (PROCESSOR_POWER_INFORMATION)，沒有停留比例。
+ */
+struct CpuIdleSample {
+    bool valid = false;           // 第一次取樣只建立基準
+    int coreCount = 0;            // 索引為 CPU 編號
+    int stateCount = 0;           // 狀態索引與 cpuidle/stateN 相同 (通常 0 為 POLL)
+    SampleName stateNames[SnapshotLimits::kMaxIdleStates];
+    float residency[SnapshotLimits::kMaxCores][SnapshotLimits::kMaxIdleStates] = {}; // %
+    float wakeupsPerSec[SnapshotLimits::kMaxCores] = {}; // 進入 idle 的次數 (所有狀態合計)
+    float avgResidency[SnapshotLimits::kMaxIdleStates] = {}; // 所有核心平均
+    qint64 scanMicros = 0;
+
+    bool hasCurrentState = false; // Windows：目前所在的 idle state
+    int maxState = 0;
+    quint8 currentState[SnapshotLimits::kMaxCores] = {};
+};
+
+/** @brief 單一 cpufreq policy (共用同一個頻率的 CPU) 在時間窗內的頻率分佈 */
+struct FreqPolicySample {
+    SampleName cpus;              // 例如 "0-3" 或 "4,6"
+    int stepCount = 0;            // 依頻率由低到高排序
+    float stepMhz[SnapshotLimits::kMaxFreqSteps] = {};
+    float residency[SnapshotLimits::kMaxFreqSteps] = {}; // %
+    float avgMhz = 0.0f;          // 依停留時間加權的平均頻率
+};
+
+/**
+ * @brief 頻率停留分佈 (cpufreq stats/time_in_state)
+ * 以時間窗 (而非瞬間的 MHz) 呈現各頻率檔位的停留比例，可看出 boost 是否能持續。
+ * 只有提供頻率表的驅動 (acpi-cpufreq、cppc、多數 ARM 驅動) 有 time_in_state；
+ * intel_pstate / amd-pstate 的 active 模式沒有。
+ */
+struct FreqResidencySample {
+    bool valid = false;
+    int windowSec = 0;            // 設定的時間窗
+    float coveredSec = 0.0f;      // 實際涵蓋的時間 (啟用不久時小於時間窗)
+    int policyCount = 0;
+    FreqPolicySample policies[SnapshotLimits::kMaxFreqPolicies];
+    int coreCount = 0;
+    qint16 corePolicy[SnapshotLimits::kMaxCores] = {}; // CPU -> policies[] 索引，-1 代表沒有
+};
+
+struct PowerZoneSample {
+    enum Kind : quint8 { Package = 0, Core, Uncore, Dram, Psys, Other };
+
+    SampleName name;              // 例如 "package-0"、"package-0/dram"
+    quint8 kind = Other;
+    qint8 package = -1;           // 所屬插槽，psys 等不屬於單一插槽者為 -1
+    float watts = 0.0f;
+};
+
+/**
+ * @brief RAPL 功耗 (powercap sysfs 的 energy_uj 差值)
+ * 計數器到達 max_energy_range_uj 後歸零，計算差值時已處理。
+ */
+struct PowerSample {
+    bool valid = false;           // 至少一個區域有差值
+    bool permissionDenied = false; // 找到區域但 energy_uj 無法讀取 (新核心預設只有 root 可讀)
+    int zoneCount = 0;
+    PowerZoneSample zones[SnapshotLimits::kMaxPowerZones];
+    float packageWatts = 0.0f;    // 所有 package 區域合計
+};
+
+/**
+ * @brief 過熱降頻事件 (Linux thermal_throttle 計數器)
+ * 每個取樣間隔內新增的事件數與降頻時間；package 計數器由同一插槽的所有核心共用，只讀取一次。
+ */
+struct ThrottleSample {
+    bool valid = false;           // 核心提供 thermal_throttle 且已有基準
+    int coreCount = 0;            // 索引為 CPU 編號，0 代表沒有 thermal_throttle (虛擬機、非 x86)
+    quint32 coreEvents[SnapshotLimits::kMaxCores] = {};  // 本次間隔新增的 core_throttle_count
+    quint32 coreThrottleMs[SnapshotLimits::kMaxCores] = {}; // 本次間隔的 core_throttle_total_time_ms (舊核心沒有)
+    int packageCount = 0;
+    qint16 packageIds[SnapshotLimits::kMaxPackages] = {};
+    quint32 packageEvents[SnapshotLimits::kMaxPackages] = {};
+    quint32 packageThrottleMs[SnapshotLimits::kMaxPackages] = {};
+    int throttledCores = 0;       // 本次間隔有新事件的核心數
+    quint64 totalCoreEvents = 0;  // 開機以來累計 (所有核心)
+    quint64 totalPackageEvents = 0;
+};
+
+struct SystemSnapshot {
+    quint64 sequence = 0;         // 取樣週期編號
+    qint64 timestampMs = 0;       // 單調時鐘時間戳
+
+    CpuSample cpu;
+    MemorySample memory;
+
+    int diskSlots = 0;            // 已使用的槽位數 (含目前未掛載者)
+    DiskSample disks[SnapshotLimits::kMaxDisks];
+
+    int interfaceSlots = 0;
+    NetworkSample interfaces[SnapshotLimits::kMaxInterfaces];
+
+    // 感測器清單只在第一次取樣時探索，索引在程式執行期間固定
+    int sensorCount = 0;
+    SensorSample sensors[SnapshotLimits::kMaxSensors];
+
+    ProcessTopSample processes;
+
+    PressureSample pressure[PressureSample::ResourceCount];
+
+    CgroupTopSample cgroups;
+
+    InterruptSample interrupts;
+
+    SchedSample sched;
+
+    CpuIdleSample cpuIdle;
+
+    FreqResidencySample freqResidency;
+
+    PowerSample power;
+
+    ThrottleSample throttle;
+
+    ThreadTopSample threads;
+
+    MemoryTopSample memoryTop;
+};
+
+/**
+ * @brief 歷史取樣點 (經由 SPSC 環狀佇列從收集執行緒送往 GUI 執行緒)
+ * slot 依 kind 代表核心編號、硬碟槽位或介面槽位
+ */
+struct MetricPoint {
+    enum Kind : quint16 {
+        CpuTotal = 0,
+        CpuCore,
+        MemoryLoad,
+        DiskRead,
+        DiskWrite,
+        DiskActive,
+        NetSent,
+        NetRecv,
+        NetSentTotal,   // 所有介面合計 (slot 固定為 0)
+        NetRecvTotal,
+        SensorTemp,     // slot 為感測器索引
+        SensorFan,
+        RunDelay,       // slot 為 CPU 編號 (ms/s)
+        RunDelayAvg,    // 所有 CPU 平均 (slot 固定為 0)
+        LoadAvg1,
+        PowerPackage,   // 所有 package 合計 (W，slot 固定為 0)
+        PowerZone,      // slot 為 PowerSample::zones 索引
+        ThrottleCore,   // slot 為 CPU 編號 (每次取樣新增的事件數)
+        ThrottlePackage, // slot 為 ThrottleSample::packageIds 索引
+        WakeupLatencyP50, // 喚醒延遲探針 (µs，slot 固定為 0，由 LatencyWidget 直接寫入 MetricHistory)
+        WakeupLatencyP99,
+        WakeupLatencyMax
+    };
+
+    qint64 timestampMs;
+    quint16 kind;
+    quint16 slot;
+    float value;
+};
+
+#endif // SYSTEMSNAPSHOT_H
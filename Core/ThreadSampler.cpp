@@ -0,0 +1,232 @@
+#include "ThreadSampler.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+const char *const kFileNames[] = {"stat", "schedstat"};
+
+int openAt(int dirFd, int tid, const char *file) {
+    char path[48];
+    std::snprintf(path, sizeof(path), "%d/%s", tid, file);
+    int fd;
+    do {
+        fd = ::openat(dirFd, path, O_RDONLY | O_CLOEXEC);
+    } while (fd < 0 && errno == EINTR);
+    return fd;
+}
+
+std::string_view preadAll(int fd, char *buffer, size_t size) {
+    ssize_t n;
+    do {
+        n = ::pread(fd, buffer, size, 0);
+    } while (n < 0 && errno == EINTR);
+    return n > 0 ? std::string_view(buffer, static_cast<size_t>(n)) : std::string_view();
+}
+}
+
+ThreadSampler::ThreadSampler() {
+    m_ticksPerSecond = qMax(1L, sysconf(_SC_CLK_TCK));
+}
+
+ThreadSampler::~ThreadSampler() {
+    releaseAll();
+}
+
+void ThreadSampler::release(Entry &entry) {
+    for (int &fd : entry.fds) {
+        if (fd >= 0) {
+            ::close(fd);
+            DescriptorBudget::release();
+            fd = -1;
+        }
+    }
+}
+
+void ThreadSampler::releaseAll() {
+    for (auto &item : m_entries) release(item.second);
+    m_entries.clear();
+    m_ranked.clear();
+    if (m_taskDir) {
+        closedir(m_taskDir);
+        m_taskDir = nullptr;
+    }
+    m_prevScanNs = 0;
+}
+
+void ThreadSampler::select(int pid) {
+    releaseAll();
+    m_pid = pid;
+    m_processName[0] = '\0';
+    if (pid <= 0) return;
+
+    char path[32];
+    std::snprintf(path, sizeof(path), "/proc/%d/task", pid);
+    m_taskDir = opendir(path);
+
+    std::snprintf(path, sizeof(path), "/proc/%d/comm", pid);
+    ProcFile comm(path);
+    const std::string_view name = ProcText::trim(comm.read());
+    const size_t length = qMin(name.size(), sizeof(m_processName) - 1);
+    std::memcpy(m_processName, name.data(), length);
+    m_processName[length] = '\0';
+}
+
+std::string_view ThreadSampler::readFile(int tid, Entry &entry, File file, char *buffer, size_t size) {
+    if (entry.fds[file] >= 0) return preadAll(entry.fds[file], buffer, size);
+
+    const int fd = openAt(dirfd(m_taskDir), tid, kFileNames[file]);
+    if (fd < 0) return std::string_view();
+    const std::string_view content = preadAll(fd, buffer, size);
+    ::close(fd);
+    return content;
+}
+
+bool ThreadSampler::parseStat(std::string_view content, Entry &entry, quint64 &startTime) {
+    // 格式與 /proc/<pid>/stat 相同；comm 可能含空白或括號，以最後一個 ')' 為界
+    const size_t open = content.find('(');
+    const size_t close = content.rfind(')');
+    if (open == std::string_view::npos || close == std::string_view::npos || close < open) return false;
+
+    const std::string_view comm = content.substr(open + 1, close - open - 1);
+    const size_t nameLength = qMin(comm.size(), sizeof(entry.name) - 1);
+    std::memcpy(entry.name, comm.data(), nameLength);
+    entry.name[nameLength] = '\0';
+
+    // state 為第 3 欄，utime/stime 為第 14/15 欄，starttime 為第 22 欄，processor 為第 39 欄
+    std::string_view fields = content.substr(close + 1);
+    std::string_view token;
+    quint64 utime = 0, stime = 0, processor = 0;
+    for (int field = 3; field <= 39; ++field) {
+        if (!ProcText::nextToken(fields, token)) return false;
+        switch (field) {
+        case 3: entry.state = token.empty() ? '?' : token.front(); break;
+        case 14: if (!ProcText::toU64(token, utime)) return false; break;
+        case 15: if (!ProcText::toU64(token, stime)) return false; break;
+        case 22: if (!ProcText::toU64(token, startTime)) return false; break;
+        case 39: ProcText::toU64(token, processor); break;
+        default: break;
+        }
+    }
+    entry.ticks = utime + stime;
+    entry.lastCpu = int(processor);
+    return true;
+}
+
+void ThreadSampler::readEntry(int tid, Entry &entry) {
+    char buffer[1024];
+    const quint64 prevTicks = entry.ticks;
+    const quint64 prevDelay = entry.runDelayNs;
+    quint64 startTime = 0;
+
+    std::string_view content = readFile(tid, entry, Stat, buffer, sizeof(buffer));
+    if (content.empty() || !parseStat(content, entry, startTime)) {
+        entry.seenRound = 0; // 執行緒已結束，稍後移除
+        return;
+    }
+
+    // schedstat："執行時間 等待時間 時間片數" (奈秒)；核心未啟用 CONFIG_SCHED_INFO 時不存在
+    std::string_view sched = readFile(tid, entry, SchedStat, buffer, sizeof(buffer));
+    quint64 runNs = 0, delayNs = 0;
+    entry.hasDelay = ProcText::nextU64(sched, runNs) && ProcText::nextU64(sched, delayNs);
+    if (entry.hasDelay) entry.runDelayNs = delayNs;
+
+    // starttime 不同代表 TID 被重複使用
+    const bool sameThread = entry.hasBaseline && entry.startTime == startTime;
+    entry.ranked = sameThread;
+    entry.deltaTicks = (sameThread && entry.ticks >= prevTicks) ? entry.ticks - prevTicks : 0;
+    entry.deltaDelayNs = (sameThread && entry.hasDelay && entry.runDelayNs >= prevDelay) ? entry.runDelayNs - prevDelay : 0;
+    entry.startTime = startTime;
+    entry.hasBaseline = true;
+}
+
+void ThreadSampler::sample(int pid, ThreadTopSample &out) {
+    const qint64 startNs = ProcText::monotonicNs();
+    if (pid != m_pid) select(pid);
+
+    out.pid = pid;
+    std::memcpy(out.processName.text, m_processName, sizeof(m_processName));
+    out.exited = pid > 0 && !m_taskDir;
+    out.valid = false;
+    out.count = 0;
+    out.threadCount = 0;
+    if (!m_taskDir) return;
+
+    ++m_round;
+    rewinddir(m_taskDir);
+    while (dirent *ent = readdir(m_taskDir)) {
+        quint64 tid;
+        if (ent->d_name[0] < '1' || ent->d_name[0] > '9') continue;
+        if (!ProcText::toU64(ent->d_name, tid) || tid > 0x7fffffff) continue;
+
+        auto result = m_entries.try_emplace(int(tid));
+        Entry &entry = result.first->second;
+        if (result.second) {
+            for (int file = 0; file < FileCount; ++file) {
+                if (!DescriptorBudget::acquire()) break;
+                entry.fds[file] = openAt(dirfd(m_taskDir), int(tid), kFileNames[file]);
+                if (entry.fds[file] < 0) DescriptorBudget::release();
+            }
+        }
+        entry.seenRound = m_round;
+        readEntry(int(tid), entry);
+    }
+
+    // 行程結束時 task 目錄變為空的 (或讀取失敗)
+    if (m_entries.empty() || std::none_of(m_entries.begin(), m_entries.end(),
+                                          [this](const Item &item) { return item.second.seenRound == m_round; })) {
+        out.exited = true;
+        releaseAll();
+        m_pid = 0;
+        return;
+    }
+
+    m_ranked.clear();
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->second.seenRound != m_round) {
+            release(it->second);
+            it = m_entries.erase(it);
+            continue;
+        }
+        if (it->second.ranked) m_ranked.push_back(&*it);
+        ++it;
+    }
+
+    const size_t topCount = qMin<size_t>(m_ranked.size(), SnapshotLimits::kMaxTopThreads);
+    std::partial_sort(m_ranked.begin(), m_ranked.begin() + static_cast<std::ptrdiff_t>(topCount), m_ranked.end(),
+                      [](const Item *a, const Item *b) {
+        if (a->second.deltaTicks != b->second.deltaTicks) return a->second.deltaTicks > b->second.deltaTicks;
+        if (a->second.deltaDelayNs != b->second.deltaDelayNs) return a->second.deltaDelayNs > b->second.deltaDelayNs;
+        return a->first < b->first;
+    });
+
+    const qint64 elapsedNs = startNs - m_prevScanNs;
+    const bool hasInterval = m_prevScanNs > 0 && elapsedNs > 0;
+    m_prevScanNs = startNs;
+
+    out.threadCount = int(m_entries.size());
+    out.valid = hasInterval;
+    out.count = hasInterval ? int(topCount) : 0;
+    const double ticksToPercent = hasInterval ? 100.0 * 1e9 / (double(m_ticksPerSecond) * double(elapsedNs)) : 0.0;
+    for (int i = 0; i < out.count; ++i) {
+        const Item *item = m_ranked[i];
+        const Entry &entry = item->second;
+        ThreadSample &thread = out.top[i];
+        thread.tid = item->first;
+        std::memcpy(thread.name.text, entry.name, sizeof(entry.name));
+        thread.cpuPercent = float(double(entry.deltaTicks) * ticksToPercent);
+        thread.state = entry.state;
+        thread.lastCpu = entry.lastCpu;
+        // 等待奈秒 / 間隔奈秒 * 1000 = 每秒等待的毫秒數
+        thread.runDelayMsPerSec = entry.hasDelay ? float(double(entry.deltaDelayNs) * 1000.0 / double(elapsedNs)) : -1.0f;
+    }
+    out.scanMicros = (ProcText::monotonicNs() - startNs) / 1000;
+}
+
+#endif // Q_OS_LINUX
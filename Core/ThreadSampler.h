@@ -0,0 +1,74 @@
+#ifndef THREADSAMPLER_H
+#define THREADSAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include <dirent.h>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Linux 單一行程的執行緒排行 (/proc/<pid>/task/<tid>/stat 與 schedstat)
+ * 只掃描選取行程的 task 目錄：目錄常駐開啟 (每輪 rewinddir)，
+ * 每個執行緒的 stat / schedstat 在第一次看到時以 openat 開啟，之後每輪只做 pread。
+ * 常駐描述元受 DescriptorBudget 限制，超出預算的執行緒每輪臨時開啟。
+ *
+ * 執行緒以 (tid, starttime) 識別；選取的行程改變或結束時釋放所有描述元。
+ */
+class ThreadSampler
+{
+public:
+    ThreadSampler();
+    ~ThreadSampler();
+
+    ThreadSampler(const ThreadSampler &) = delete;
+    ThreadSampler &operator=(const ThreadSampler &) = delete;
+
+    /** @brief 掃描 pid 的所有執行緒並填入 out；pid 改變時重新建立基準 */
+    void sample(int pid, ThreadTopSample &out);
+
+private:
+    enum File {
+        Stat = 0,
+        SchedStat,
+        FileCount
+    };
+
+    struct Entry {
+        int fds[FileCount] = {-1, -1};  // 超出描述元預算時為 -1，每輪臨時開啟
+        quint64 startTime = 0;
+        quint64 ticks = 0;              // utime + stime
+        quint64 runDelayNs = 0;
+        quint64 deltaTicks = 0;
+        quint64 deltaDelayNs = 0;
+        char name[16] = {0};
+        char state = '?';
+        int lastCpu = -1;
+        bool hasDelay = false;
+        bool hasBaseline = false;
+        bool ranked = false;
+        quint64 seenRound = 0;
+    };
+    using Item = std::pair<const int, Entry>;
+
+    void select(int pid);
+    void releaseAll();
+    void release(Entry &entry);
+    std::string_view readFile(int tid, Entry &entry, File file, char *buffer, size_t size);
+    void readEntry(int tid, Entry &entry);
+    static bool parseStat(std::string_view content, Entry &entry, quint64 &startTime);
+
+    int m_pid = 0;
+    DIR *m_taskDir = nullptr;
+    char m_processName[16] = {0};
+    std::unordered_map<int, Entry> m_entries;
+    std::vector<const Item *> m_ranked;
+    quint64 m_round = 0;
+    qint64 m_prevScanNs = 0;
+    long m_ticksPerSecond = 100;
+};
+#endif // Q_OS_LINUX
+
+#endif // THREADSAMPLER_H
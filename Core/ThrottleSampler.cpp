@@ -0,0 +1,133 @@
+#include "ThrottleSampler.h"
+
+#ifdef Q_OS_LINUX
+#include "ProcReader.h"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+// 核心重新上線後才會出現 thermal_throttle 目錄
+constexpr qint64 kRediscoverNs = 30LL * 1000 * 1000 * 1000;
+}
+
+ThrottleSampler::ThrottleSampler() {
+    m_cpus.resize(size_t(qBound(0, int(sysconf(_SC_NPROCESSORS_CONF)), SnapshotLimits::kMaxCores)));
+    discover();
+}
+
+ThrottleSampler::~ThrottleSampler() {
+    for (Cpu &cpu : m_cpus) {
+        close(cpu.events);
+        close(cpu.timeMs);
+    }
+    for (Package &package : m_packages) {
+        close(package.events);
+        close(package.timeMs);
+    }
+}
+
+void ThrottleSampler::open(Counter &counter, int cpu, const char *file) {
+    if (!DescriptorBudget::acquire()) return;
+    char path[96];
+    std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/thermal_throttle/%s", cpu, file);
+    do {
+        counter.fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    } while (counter.fd < 0 && errno == EINTR);
+    if (counter.fd < 0) DescriptorBudget::release();
+    counter.hasBaseline = false;
+}
+
+void ThrottleSampler::close(Counter &counter) {
+    if (counter.fd >= 0) {
+        ::close(counter.fd);
+        DescriptorBudget::release();
+        counter.fd = -1;
+    }
+    counter.hasBaseline = false;
+}
+
+bool ThrottleSampler::read(Counter &counter, quint32 &delta) {
+    delta = 0;
+    quint64 value;
+    if (counter.fd < 0 || !ProcText::readU64(counter.fd, value)) return false;
+    if (counter.hasBaseline && value >= counter.value) delta = quint32(qMin<quint64>(value - counter.value, 0xffffffffu));
+    counter.value = value;
+    counter.hasBaseline = true;
+    return true;
+}
+
+void ThrottleSampler::discover() {
+    for (int i = 0; i < int(m_cpus.size()); ++i) {
+        Cpu &cpu = m_cpus[i];
+        if (cpu.present) continue;
+        open(cpu.events, i, "core_throttle_count");
+        if (cpu.events.fd < 0) continue;
+        open(cpu.timeMs, i, "core_throttle_total_time_ms");
+        cpu.present = true;
+
+        // 每個插槽只保留第一個看到的核心的 package 計數器
+        char path[96];
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", i);
+        ProcFile idFile(path);
+        quint64 id = 0;
+        ProcText::readU64(idFile, id);
+        bool known = false;
+        for (const Package &package : m_packages) known = known || package.id == int(id);
+        if (known || int(m_packages.size()) >= SnapshotLimits::kMaxPackages) continue;
+
+        Package package;
+        package.id = int(id);
+        open(package.events, i, "package_throttle_count");
+        open(package.timeMs, i, "package_throttle_total_time_ms");
+        m_packages.push_back(package);
+    }
+    m_lastDiscoverNs = ProcText::monotonicNs();
+}
+
+void ThrottleSampler::sample(ThrottleSample &out) {
+    if (ProcText::monotonicNs() - m_lastDiscoverNs > kRediscoverNs) discover();
+
+    bool any = false;
+    bool baseline = true;
+    out.throttledCores = 0;
+    out.totalCoreEvents = 0;
+    out.coreCount = int(m_cpus.size());
+    for (int i = 0; i < out.coreCount; ++i) {
+        Cpu &cpu = m_cpus[i];
+        out.coreEvents[i] = 0;
+        out.coreThrottleMs[i] = 0;
+        if (!cpu.present) continue;
+
+        const bool hadBaseline = cpu.events.hasBaseline;
+        if (!read(cpu.events, out.coreEvents[i])) {
+            // 核心離線：關閉後等待重新探索
+            close(cpu.events);
+            close(cpu.timeMs);
+            cpu.present = false;
+            continue;
+        }
+        read(cpu.timeMs, out.coreThrottleMs[i]);
+        any = true;
+        baseline = baseline && hadBaseline;
+        out.totalCoreEvents += cpu.events.value;
+        if (out.coreEvents[i] > 0) ++out.throttledCores;
+    }
+
+    out.totalPackageEvents = 0;
+    out.packageCount = int(m_packages.size());
+    for (int i = 0; i < out.packageCount; ++i) {
+        Package &package = m_packages[i];
+        out.packageIds[i] = qint16(package.id);
+        read(package.events, out.packageEvents[i]);
+        read(package.timeMs, out.packageThrottleMs[i]);
+        out.totalPackageEvents += package.events.value;
+    }
+
+    // 第一次取樣 (或新核心剛加入) 只建立基準；沒有任何 thermal_throttle 目錄時 coreCount 為 0
+    if (!any) out.coreCount = 0;
+    out.valid = any && baseline;
+}
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,58 @@
+#ifndef THROTTLESAMPLER_H
+#define THROTTLESAMPLER_H
+
+#include "SystemSnapshot.h"
+
+#ifdef Q_OS_LINUX
+#include <vector>
+
+/**
+ * @brief Linux 過熱降頻計數器 (/sys/devices/system/cpu/cpuN/thermal_throttle/)
+ * 每個核心讀取 core_throttle_count 與 core_throttle_total_time_ms；
+ * package_throttle_* 在同一插槽的所有核心內容相同，只從每個插槽的第一個核心讀取。
+ *
+ * 描述元在探索時開啟並常駐 (受 DescriptorBudget 限制，超出預算的計數器略過)，
+ * 每次取樣以 pread 讀取。離線核心的目錄不存在，每隔一段時間重新探索。
+ */
+class ThrottleSampler
+{
+public:
+    ThrottleSampler();
+    ~ThrottleSampler();
+
+    ThrottleSampler(const ThrottleSampler &) = delete;
+    ThrottleSampler &operator=(const ThrottleSampler &) = delete;
+
+    void sample(ThrottleSample &out);
+
+private:
+    struct Counter {
+        int fd = -1;
+        quint64 value = 0;
+        bool hasBaseline = false;
+    };
+
+    struct Cpu {
+        Counter events;
+        Counter timeMs;
+        bool present = false;
+    };
+
+    struct Package {
+        int id = 0;
+        Counter events;
+        Counter timeMs;
+    };
+
+    void discover();
+    static void open(Counter &counter, int cpu, const char *file);
+    static void close(Counter &counter);
+    static bool read(Counter &counter, quint32 &delta); // 回傳 false 代表讀取失敗
+
+    std::vector<Cpu> m_cpus;
+    std::vector<Package> m_packages;
+    qint64 m_lastDiscoverNs = 0;
+};
+#endif // Q_OS_LINUX
+
+#endif // THROTTLESAMPLER_H
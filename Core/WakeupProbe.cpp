@@ -0,0 +1,155 @@
+#include "WakeupProbe.h"
+
+#include <QtAlgorithms>
+#include <algorithm>
+#include <chrono>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <ctime>
+#include <sys/prctl.h>
+#endif
+
+/** --- 直方圖 --- **/
+
+int LatencyHistogram::bucketFor(qint64 ns) {
+    if (ns < kSubBuckets) return ns > 0 ? int(ns) : 0;
+    const quint64 value = std::min<quint64>(quint64(ns), (quint64(1) << kMaxBits) - 1);
+    const int msb = 63 - int(qCountLeadingZeroBits(value));
+    const int sub = int(value >> (msb - kSubBucketBits)) & (kSubBuckets - 1);
+    return kSubBuckets + (msb - kSubBucketBits) * kSubBuckets + sub;
+}
+
+qint64 LatencyHistogram::bucketUpperNs(int index) {
+    if (index < kSubBuckets) return index;
+    const int msb = (index - kSubBuckets) / kSubBuckets + kSubBucketBits;
+    const int sub = (index - kSubBuckets) % kSubBuckets;
+    const qint64 lower = qint64(kSubBuckets + sub) << (msb - kSubBucketBits);
+    return lower + (qint64(1) << (msb - kSubBucketBits)) - 1;
+}
+
+qint64 LatencyHistogram::percentileNs(double p) const {
+    if (total == 0) return -1;
+    // 第 ceil(p * total) 筆 (至少第 1 筆) 落在哪個桶
+    const quint64 rank = std::max<quint64>(1, quint64(p * double(total) + 0.999999));
+    quint64 seen = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        seen += counts[i];
+        if (seen >= rank) return std::min(bucketUpperNs(i), maxNs);
+    }
+    return maxNs;
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &other) {
+    for (int i = 0; i < kBucketCount; ++i) counts[i] += other.counts[i];
+    total += other.total;
+    maxNs = std::max(maxNs, other.maxNs);
+}
+
+/** --- 探針執行緒 --- **/
+
+WakeupProbe::~WakeupProbe() {
+    stop();
+}
+
+void WakeupProbe::start(int periodUs) {
+    stop();
+    for (auto &count : m_counts) count.store(0, std::memory_order_relaxed);
+    std::fill(m_taken, m_taken + LatencyHistogram::kBucketCount, 0);
+    m_intervalMaxNs.store(0, std::memory_order_relaxed);
+    m_overruns.store(0, std::memory_order_relaxed);
+    m_cpuNs.store(-1, std::memory_order_relaxed);
+
+    m_periodUs = std::max(1, periodUs);
+    m_stop.store(false, std::memory_order_relaxed);
+    m_thread = std::thread(&WakeupProbe::run, this, qint64(m_periodUs) * 1000);
+}
+
+void WakeupProbe::stop() {
+    if (!m_thread.joinable()) return;
+    m_stop.store(true, std::memory_order_release);
+    m_thread.join();
+}
+
+quint64 WakeupProbe::takeInterval(LatencyHistogram &out) {
+    out.total = 0;
+    for (int i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+        const quint64 now = m_counts[i].load(std::memory_order_relaxed);
+        out.counts[i] = now - m_taken[i];
+        out.total += out.counts[i];
+        m_taken[i] = now;
+    }
+    out.maxNs = m_intervalMaxNs.exchange(0, std::memory_order_relaxed);
+    return out.total;
+}
+
+void WakeupProbe::record(qint64 lateNs) {
+    std::atomic<quint64> &count = m_counts[LatencyHistogram::bucketFor(lateNs)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    // 讀取端會以 exchange(0) 重設，這裡必須用 CAS 才不會蓋掉重設
+    qint64 current = m_intervalMaxNs.load(std::memory_order_relaxed);
+    while (lateNs > current && !m_intervalMaxNs.compare_exchange_weak(current, lateNs, std::memory_order_relaxed)) {}
+}
+
+#ifdef Q_OS_LINUX
+namespace {
+constexpr qint64 kNsPerSec = 1000000000;
+
+qint64 toNs(const timespec &ts) { return qint64(ts.tv_sec) * kNsPerSec + ts.tv_nsec; }
+timespec fromNs(qint64 ns) { return timespec{time_t(ns / kNsPerSec), long(ns % kNsPerSec)}; }
+}
+
+void WakeupProbe::run(qint64 periodNs) {
+    // 預設的 timer slack (50 µs) 會讓核心延後喚醒以合併計時器，量到的就不是排程延遲
+    ::prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    qint64 next = toNs(ts);
+    qint64 lastCpuRead = next;
+
+    while (!m_stop.load(std::memory_order_acquire)) {
+        next += periodNs;
+        const timespec target = fromNs(next);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &target, nullptr) == EINTR) {}
+
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        const qint64 now = toNs(ts);
+        const qint64 late = now - next;
+        record(late);
+
+        // 延遲超過一個週期時跳過已錯過的喚醒，否則之後會連續「補睡」出一串假的 0 延遲
+        if (late >= periodNs) {
+            const qint64 missed = late / periodNs;
+            m_overruns.store(m_overruns.load(std::memory_order_relaxed) + quint64(missed), std::memory_order_relaxed);
+            next += missed * periodNs;
+        }
+
+        // 執行緒 CPU 時間不在 vDSO 中，每秒才讀一次
+        if (now - lastCpuRead >= kNsPerSec) {
+            lastCpuRead = now;
+            if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0) m_cpuNs.store(toNs(ts), std::memory_order_relaxed);
+        }
+    }
+}
+#else
+void WakeupProbe::run(qint64 periodNs) {
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(periodNs));
+    Clock::time_point next = Clock::now();
+
+    while (!m_stop.load(std::memory_order_acquire)) {
+        next += period;
+        std::this_thread::sleep_until(next);
+        const qint64 late = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - next).count();
+        record(late);
+
+        if (late >= periodNs) {
+            const qint64 missed = late / periodNs;
+            m_overruns.store(m_overruns.load(std::memory_order_relaxed) + quint64(missed), std::memory_order_relaxed);
+            next += missed * period;
+        }
+    }
+}
+#endif
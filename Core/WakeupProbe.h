@@ -0,0 +1,94 @@
+#ifndef WAKEUPPROBE_H
+#define WAKEUPPROBE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <thread>
+
+/**
+ * @brief 喚醒延遲直方圖 (對數分桶)
+ * 每個 2 倍區間再切成 4 份，相對誤差小於 25%；0 ~ 3 ns 為精確值，上限約 1100 秒。
+ * 百分位數回報所在桶的上界 (偏保守)，但不超過實際觀察到的最大值。
+ */
+struct LatencyHistogram {
+    static constexpr int kSubBucketBits = 2;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxBits = 40;    // 超過 2^40 ns 的值併入最後一桶
+    static constexpr int kBucketCount = kSubBuckets + (kMaxBits - kSubBucketBits) * kSubBuckets;
+
+    quint64 counts[kBucketCount] = {};
+    quint64 total = 0;
+    qint64 maxNs = 0;
+
+    static int bucketFor(qint64 ns);
+    static qint64 bucketUpperNs(int index);
+
+    /** @brief p 為 0 ~ 1；沒有資料時回傳 -1 */
+    qint64 percentileNs(double p) const;
+
+    /** @brief 累加另一個直方圖 (例如把每個區間併入啟動以來的累計) */
+    void merge(const LatencyHistogram &other);
+
+    void clear() { *this = LatencyHistogram(); }
+};
+
+/**
+ * @brief 排程喚醒延遲探針 (cyclictest 式)
+ * 專用執行緒以 clock_nanosleep(TIMER_ABSTIME) 依固定週期睡眠，
+ * 醒來後量測實際時間比預定時間晚了多少，累計在對數直方圖中。
+ * 每次喚醒只有兩次 clock 呼叫與幾個 relaxed 原子寫入，不配置記憶體也不上鎖；
+ * 以預設 10 ms 週期計算，探針本身的 CPU 用量約為單一核心的萬分之幾。
+ *
+ * 探針以一般優先權執行 (不要求 SCHED_FIFO)，量到的是一般桌面執行緒實際面對的延遲；
+ * timer slack 設為 1 ns，避免核心預設的 50 µs 合併誤差直接加在量測值上。
+ * 非 Linux 平台改用 std::this_thread::sleep_until，結果包含系統計時器的解析度。
+ */
+class WakeupProbe
+{
+public:
+    WakeupProbe() = default;
+    ~WakeupProbe();
+
+    WakeupProbe(const WakeupProbe &) = delete;
+    WakeupProbe &operator=(const WakeupProbe &) = delete;
+
+    /** @brief 以 periodUs 週期啟動 (已在執行時以新週期重新啟動)，並重設所有統計 */
+    void start(int periodUs);
+
+    /** @brief 停止探針執行緒；最多等待一個週期 */
+    void stop();
+
+    bool isRunning() const { return m_thread.joinable(); }
+    int periodUs() const { return m_periodUs; }
+
+    /**
+     * @brief 取出自上次呼叫以來的直方圖 (只能由單一執行緒呼叫)
+     * @return 區間內的喚醒次數
+     */
+    quint64 takeInterval(LatencyHistogram &out);
+
+    /** @brief 自啟動以來錯過的週期數 (延遲超過一個週期時跳過的喚醒) */
+    quint64 overruns() const { return m_overruns.load(std::memory_order_relaxed); }
+
+    /** @brief 探針執行緒自啟動以來使用的 CPU 時間 (ns)，不支援時為 -1 */
+    qint64 cpuNs() const { return m_cpuNs.load(std::memory_order_relaxed); }
+
+private:
+    void run(qint64 periodNs);
+    void record(qint64 lateNs);
+
+    std::thread m_thread;
+    std::atomic<bool> m_stop{false};
+    int m_periodUs = 0;
+
+    // 探針執行緒是唯一的寫入者：計數以 load + store 遞增，不需要 lock 前綴的指令
+    std::atomic<quint64> m_counts[LatencyHistogram::kBucketCount] = {};
+    std::atomic<qint64> m_intervalMaxNs{0};  // 讀取端以 exchange(0) 取出
+    std::atomic<quint64> m_overruns{0};
+    std::atomic<qint64> m_cpuNs{-1};
+
+    // 讀取端狀態
+    quint64 m_taken[LatencyHistogram::kBucketCount] = {};
+};
+
+#endif // WAKEUPPROBE_H
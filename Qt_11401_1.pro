@@ -11,7 +11,31 @@ CONFIG += c++17
 SOURCES += \
     Core/BaseComponent.cpp \
     ControlPanel.cpp \
+    Core/CgroupSampler.cpp \
+    Core/CpuFreqSampler.cpp \
+    Core/CpuIdleSampler.cpp \
+    Core/CpuStatSampler.cpp \
+    Core/CpuTopology.cpp \
+    Core/FreqResidencySampler.cpp \
+    Core/GorillaBlock.cpp \
+    Core/InterruptSampler.cpp \
+    Core/MemInfoSampler.cpp \
+    Core/MetricHistory.cpp \
+    Core/MinMaxDecimator.cpp \
+    Core/PressureSampler.cpp \
+    Core/ProcReader.cpp \
+    Core/ProcessSampler.cpp \
+    Core/RaplSampler.cpp \
+    Core/SampleScheduler.cpp \
+    Core/SchedStatSampler.cpp \
+    Core/SensorSampler.cpp \
     Core/SettingsManager.cpp \
+    Core/SmapsSampler.cpp \
+    Core/SystemCollector.cpp \
+    Core/SystemSampler.cpp \
+    Core/ThreadSampler.cpp \
+    Core/ThrottleSampler.cpp \
+    Core/WakeupProbe.cpp \
     ToolSettingsForm.cpp \
     Widgets/ImageWidget.cpp \
     Widgets/TimeWidget.cpp \
@@ -21,12 +45,42 @@ SOURCES += \
     Widgets/ToDoWidget.cpp \
     Widgets/PomodoroWidget.cpp \
     Widgets/ClipboardWidget.cpp \
+    Widgets/SparklineGraph.cpp \
+    Widgets/CoreHeatmap.cpp \
+    Widgets/FreqResidencyStrip.cpp \
+    Widgets/LatencyWidget.cpp \
     main.cpp
 
 HEADERS += \
     Core/BaseComponent.h \
     ControlPanel.h \
+    Core/CgroupSampler.h \
+    Core/CpuFreqSampler.h \
+    Core/CpuIdleSampler.h \
+    Core/CpuStatSampler.h \
+    Core/CpuTopology.h \
+    Core/FreqResidencySampler.h \
+    Core/GorillaBlock.h \
+    Core/InterruptSampler.h \
+    Core/MemInfoSampler.h \
+    Core/MetricHistory.h \
+    Core/MinMaxDecimator.h \
+    Core/PressureSampler.h \
+    Core/ProcReader.h \
+    Core/ProcessSampler.h \
+    Core/RaplSampler.h \
+    Core/SampleScheduler.h \
+    Core/SchedStatSampler.h \
+    Core/SensorSampler.h \
     Core/SettingsManager.h \
+    Core/SmapsSampler.h \
+    Core/SnapshotBuffer.h \
+    Core/SystemCollector.h \
+    Core/SystemSampler.h \
+    Core/SystemSnapshot.h \
+    Core/ThreadSampler.h \
+    Core/ThrottleSampler.h \
+    Core/WakeupProbe.h \
     ThemeManager.h \
     ToolSettingsForm.h \
     Widgets/ImageWidget.h \
@@ -36,7 +90,11 @@ HEADERS += \
     Widgets/NetworkWidget.h \
     Widgets/ToDoWidget.h \
     Widgets/PomodoroWidget.h \
-    Widgets/ClipboardWidget.h
+    Widgets/ClipboardWidget.h \
+    Widgets/SparklineGraph.h \
+    Widgets/CoreHeatmap.h \
+    Widgets/FreqResidencyStrip.h \
+    Widgets/LatencyWidget.h
 
 FORMS += \
     ControlPanel.ui \
@@ -4,6 +4,7 @@
 #include "ImageWidget.h"
 #include "Widgets/PomodoroWidget.h"
 #include "Widgets/ClipboardWidget.h"
+#include "Widgets/LatencyWidget.h"
 #include <QFileDialog>
 #include <QDir>
 #include <QFile>
@@ -76,7 +77,77 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
 
         QCheckBox *chkCores = new QCheckBox("顯示 CPU 核心詳細資訊", advGroup);
         QCheckBox *chkCoreFreq = new QCheckBox("顯示 CPU 頻率", advGroup); // 改名
+        QCheckBox *chkHeatmap = new QCheckBox("核心以熱圖顯示 (適合多核心主機)", advGroup);
+        chkHeatmap->setObjectName("cpu_heatmap_checkBox");
+        QCheckBox *chkTopology = new QCheckBox("依插槽 / 實體核心 / P-E 核心分組", advGroup);
+        chkTopology->setObjectName("cpu_topology_checkBox");
         QCheckBox *chkRam = new QCheckBox("顯示記憶體詳細 (GB)", advGroup);
+        QCheckBox *chkBreakdown = new QCheckBox("顯示 CPU 時間分類 (user/system/iowait/irq/steal)", advGroup);
+        chkBreakdown->setObjectName("cpu_breakdown_checkBox");
+        QCheckBox *chkGraph = new QCheckBox("顯示 CPU 使用率曲線", advGroup);
+        chkGraph->setObjectName("cpu_graph_checkBox");
+        QCheckBox *chkSensors = new QCheckBox("顯示溫度與風扇轉速", advGroup);
+        chkSensors->setObjectName("cpu_sensors_checkBox");
+        QCheckBox *chkProcesses = new QCheckBox("顯示 CPU 使用率最高的行程", advGroup);
+        chkProcesses->setObjectName("cpu_processes_checkBox");
+        QCheckBox *chkMemoryTop = new QCheckBox("顯示記憶體用量最高的行程 (PSS)", advGroup);
+        chkMemoryTop->setObjectName("cpu_memoryTop_checkBox");
+        chkMemoryTop->setToolTip("讀取 /proc/<pid>/smaps_rollup；大型行程較常重讀，其他使用者的行程需要權限");
+        QCheckBox *chkPressure = new QCheckBox("顯示 CPU / 記憶體停滯 (PSI)", advGroup);
+        chkPressure->setObjectName("cpu_pressure_checkBox");
+        QCheckBox *chkSched = new QCheckBox("顯示負載與 run queue 等待時間", advGroup);
+        chkSched->setObjectName("cpu_sched_checkBox");
+        QCheckBox *chkIdle = new QCheckBox("顯示各核心 C-state 停留比例", advGroup);
+        chkIdle->setObjectName("cpu_idle_checkBox");
+        QCheckBox *chkFreqResidency = new QCheckBox("顯示頻率停留分佈", advGroup);
+        chkFreqResidency->setObjectName("cpu_freqResidency_checkBox");
+        QLabel *lblFreqWindow = new QLabel("頻率分佈時間窗 (秒):", advGroup);
+        QSpinBox *spinFreqWindow = new QSpinBox(advGroup);
+        spinFreqWindow->setRange(5, 3600);
+        spinFreqWindow->setValue(60);
+        spinFreqWindow->setObjectName("freqWindow_spinBox");
+        QCheckBox *chkPower = new QCheckBox("顯示 RAPL 功耗", advGroup);
+        chkPower->setObjectName("cpu_power_checkBox");
+        QCheckBox *chkThrottle = new QCheckBox("顯示過熱降頻事件", advGroup);
+        chkThrottle->setObjectName("cpu_throttle_checkBox");
+        QLabel *lblPowercapRoot = new QLabel("powercap 目錄:", advGroup);
+        QLineEdit *editPowercapRoot = new QLineEdit(advGroup);
+        editPowercapRoot->setObjectName("powercapRoot_lineEdit");
+        editPowercapRoot->setPlaceholderText("預設: /sys/class/powercap");
+        editPowercapRoot->setToolTip("包含 intel-rapl:N 目錄的路徑，可指向測試用的目錄樹");
+        QLabel *lblProcessCount = new QLabel("行程數量:", advGroup);
+        QSpinBox *spinProcessCount = new QSpinBox(advGroup);
+        spinProcessCount->setRange(1, 16);
+        spinProcessCount->setValue(5);
+        spinProcessCount->setObjectName("topProcessCount_spinBox");
+
+        // cgroup 排行：子樹、排序方式與數量
+        QCheckBox *chkCgroups = new QCheckBox("顯示用量最高的 cgroup (容器 / 服務)", advGroup);
+        chkCgroups->setObjectName("cpu_cgroups_checkBox");
+        QLabel *lblCgroupRoot = new QLabel("cgroup 子樹:", advGroup);
+        QLineEdit *editCgroupRoot = new QLineEdit(advGroup);
+        editCgroupRoot->setObjectName("cgroupRoot_lineEdit");
+        editCgroupRoot->setPlaceholderText("預設: 整個階層 (例如 system.slice)");
+        editCgroupRoot->setToolTip("相對於 /sys/fs/cgroup 的路徑，只列出此子樹下的 cgroup");
+        QComboBox *comboCgroupSort = new QComboBox(advGroup);
+        comboCgroupSort->addItem("依 CPU 排序", 0);
+        comboCgroupSort->addItem("依記憶體排序", 1);
+        comboCgroupSort->addItem("依 I/O 排序", 2);
+        comboCgroupSort->setObjectName("cgroupSortBy_comboBox");
+        QLabel *lblCgroupCount = new QLabel("cgroup 數量:", advGroup);
+        QSpinBox *spinCgroupCount = new QSpinBox(advGroup);
+        spinCgroupCount->setRange(1, 16);
+        spinCgroupCount->setValue(5);
+        spinCgroupCount->setObjectName("cgroupCount_spinBox");
+
+        // 中斷、softirq 與 context switch 速率
+        QCheckBox *chkInterrupts = new QCheckBox("顯示中斷 / softirq / context switch 速率", advGroup);
+        chkInterrupts->setObjectName("cpu_interrupts_checkBox");
+        QLabel *lblIrqCount = new QLabel("中斷來源數量:", advGroup);
+        QSpinBox *spinIrqCount = new QSpinBox(advGroup);
+        spinIrqCount->setRange(1, 16);
+        spinIrqCount->setValue(5);
+        spinIrqCount->setObjectName("topIrqCount_spinBox");
         
         // 新增：頻率演算法選擇
         QLabel *lblFreq = new QLabel("頻率顯示演算法:", advGroup);
@@ -87,7 +158,35 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
 
         layout->addWidget(chkCores);
         layout->addWidget(chkCoreFreq); // 新增
+        layout->addWidget(chkHeatmap);
+        layout->addWidget(chkTopology);
         layout->addWidget(chkRam);
+        layout->addWidget(chkBreakdown);
+        layout->addWidget(chkGraph);
+        layout->addWidget(chkSensors);
+        layout->addWidget(chkProcesses);
+        layout->addWidget(chkMemoryTop);
+        layout->addWidget(chkPressure);
+        layout->addWidget(chkSched);
+        layout->addWidget(chkIdle);
+        layout->addWidget(chkFreqResidency);
+        layout->addWidget(lblFreqWindow);
+        layout->addWidget(spinFreqWindow);
+        layout->addWidget(chkPower);
+        layout->addWidget(lblPowercapRoot);
+        layout->addWidget(editPowercapRoot);
+        layout->addWidget(chkThrottle);
+        layout->addWidget(lblProcessCount);
+        layout->addWidget(spinProcessCount);
+        layout->addWidget(chkCgroups);
+        layout->addWidget(lblCgroupRoot);
+        layout->addWidget(editCgroupRoot);
+        layout->addWidget(comboCgroupSort);
+        layout->addWidget(lblCgroupCount);
+        layout->addWidget(spinCgroupCount);
+        layout->addWidget(chkInterrupts);
+        layout->addWidget(lblIrqCount);
+        layout->addWidget(spinIrqCount);
         layout->addWidget(lblFreq);
         layout->addWidget(comboFreq);
 
@@ -98,9 +197,75 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
         connect(chkCoreFreq, &QCheckBox::clicked, this, [this, chkCoreFreq](){ // 新增
             emit settingChanged("showCoreFreq", chkCoreFreq->isChecked());
         });
+        connect(chkHeatmap, &QCheckBox::clicked, this, [this, chkHeatmap](){
+            emit settingChanged("coreHeatmap", chkHeatmap->isChecked());
+        });
+        connect(chkTopology, &QCheckBox::clicked, this, [this, chkTopology](){
+            emit settingChanged("groupTopology", chkTopology->isChecked());
+        });
         connect(chkRam, &QCheckBox::clicked, this, [this, chkRam](){
             emit settingChanged("showRamDetail", chkRam->isChecked());
         });
+        connect(chkBreakdown, &QCheckBox::clicked, this, [this, chkBreakdown](){
+            emit settingChanged("showBreakdown", chkBreakdown->isChecked());
+        });
+        connect(chkGraph, &QCheckBox::clicked, this, [this, chkGraph](){
+            emit settingChanged("showGraph", chkGraph->isChecked());
+        });
+        connect(chkSensors, &QCheckBox::clicked, this, [this, chkSensors](){
+            emit settingChanged("showSensors", chkSensors->isChecked());
+        });
+        connect(chkProcesses, &QCheckBox::clicked, this, [this, chkProcesses](){
+            emit settingChanged("showTopProcesses", chkProcesses->isChecked());
+        });
+        connect(chkMemoryTop, &QCheckBox::clicked, this, [this, chkMemoryTop](){
+            emit settingChanged("showMemoryTop", chkMemoryTop->isChecked());
+        });
+        connect(spinProcessCount, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int val){
+            emit settingChanged("topProcessCount", val);
+        });
+        connect(chkPressure, &QCheckBox::clicked, this, [this, chkPressure](){
+            emit settingChanged("showPressure", chkPressure->isChecked());
+        });
+        connect(chkCgroups, &QCheckBox::clicked, this, [this, chkCgroups](){
+            emit settingChanged("showCgroups", chkCgroups->isChecked());
+        });
+        connect(editCgroupRoot, &QLineEdit::editingFinished, this, [this, editCgroupRoot](){
+            emit settingChanged("cgroupRoot", editCgroupRoot->text());
+        });
+        connect(comboCgroupSort, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this, comboCgroupSort](int){
+            emit settingChanged("cgroupSortBy", comboCgroupSort->currentData());
+        });
+        connect(spinCgroupCount, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int val){
+            emit settingChanged("cgroupCount", val);
+        });
+        connect(chkInterrupts, &QCheckBox::clicked, this, [this, chkInterrupts](){
+            emit settingChanged("showInterrupts", chkInterrupts->isChecked());
+        });
+        connect(spinIrqCount, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int val){
+            emit settingChanged("topIrqCount", val);
+        });
+        connect(chkSched, &QCheckBox::clicked, this, [this, chkSched](){
+            emit settingChanged("showSched", chkSched->isChecked());
+        });
+        connect(chkIdle, &QCheckBox::clicked, this, [this, chkIdle](){
+            emit settingChanged("showCpuIdle", chkIdle->isChecked());
+        });
+        connect(chkFreqResidency, &QCheckBox::clicked, this, [this, chkFreqResidency](){
+            emit settingChanged("showFreqResidency", chkFreqResidency->isChecked());
+        });
+        connect(spinFreqWindow, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int val){
+            emit settingChanged("freqWindow", val);
+        });
+        connect(chkPower, &QCheckBox::clicked, this, [this, chkPower](){
+            emit settingChanged("showPower", chkPower->isChecked());
+        });
+        connect(editPowercapRoot, &QLineEdit::editingFinished, this, [this, editPowercapRoot](){
+            emit settingChanged("powercapRoot", editPowercapRoot->text());
+        });
+        connect(chkThrottle, &QCheckBox::clicked, this, [this, chkThrottle](){
+            emit settingChanged("showThrottle", chkThrottle->isChecked());
+        });
         connect(comboFreq, QOverload<int>::of(&QComboBox::currentIndexChanged), this, [this, comboFreq](int index){
             emit settingChanged("freqAlgo", comboFreq->currentData());
         });
@@ -119,10 +284,16 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
         chkSpeed->setObjectName("chkSpeed");
         QCheckBox *chkActive = new QCheckBox("顯示硬碟活動時間 (Active Time)", advGroup);
         chkActive->setObjectName("chkActive");
+        QCheckBox *chkDiskGraph = new QCheckBox("顯示活動時間曲線", advGroup);
+        chkDiskGraph->setObjectName("chkDiskGraph");
+        QCheckBox *chkDiskPressure = new QCheckBox("顯示 I/O 停滯 (PSI)", advGroup);
+        chkDiskPressure->setObjectName("chkDiskPressure");
 
         layout->addWidget(chkUsage);
         layout->addWidget(chkSpeed);
         layout->addWidget(chkActive);
+        layout->addWidget(chkDiskGraph);
+        layout->addWidget(chkDiskPressure);
 
         connect(chkUsage, &QCheckBox::clicked, this, [this, chkUsage](){
             emit settingChanged("showUsagePercent", chkUsage->isChecked());
@@ -133,6 +304,12 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
         connect(chkActive, &QCheckBox::clicked, this, [this, chkActive](){
             emit settingChanged("showActiveTime", chkActive->isChecked());
         });
+        connect(chkDiskGraph, &QCheckBox::clicked, this, [this, chkDiskGraph](){
+            emit settingChanged("showGraph", chkDiskGraph->isChecked());
+        });
+        connect(chkDiskPressure, &QCheckBox::clicked, this, [this, chkDiskPressure](){
+            emit settingChanged("showPressure", chkDiskPressure->isChecked());
+        });
 
         ui->verticalLayout->insertWidget(ui->verticalLayout->count()-1, advGroup);
     }
@@ -146,6 +323,9 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
 
         QCheckBox *chkPing = new QCheckBox("顯示 Ping 延遲", advGroup);
         chkPing->setObjectName("network_ping_checkBox");
+
+        QCheckBox *chkNetGraph = new QCheckBox("顯示速度曲線", advGroup);
+        chkNetGraph->setObjectName("network_graph_checkBox");
         
         // Ping Target
         QLabel *lblPing = new QLabel("Ping 延遲檢測目標 (IP/網域):", advGroup);
@@ -164,6 +344,7 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
 
         layout->addWidget(chkBits);
         layout->addWidget(chkPing);
+        layout->addWidget(chkNetGraph);
         layout->addWidget(lblPing);
         layout->addWidget(editPing);
         layout->addWidget(lblInterface);
@@ -177,6 +358,10 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
             emit settingChanged("showPing", chkPing->isChecked());
         });
 
+        connect(chkNetGraph, &QCheckBox::clicked, this, [this, chkNetGraph](){
+            emit settingChanged("showGraph", chkNetGraph->isChecked());
+        });
+
         connect(editPing, &QLineEdit::editingFinished, this, [this, editPing](){
             emit settingChanged("pingTarget", editPing->text());
         });
@@ -259,6 +444,28 @@ void ToolSettingsForm::createAdvancedSettings(const QString &toolId) {
             emit settingChanged("historyLimit", val);
         });
 
+        ui->verticalLayout->insertWidget(ui->verticalLayout->count()-1, advGroup);
+    }
+    else if (toolId == "wakeup_latency") {
+        QGroupBox *advGroup = new QGroupBox("喚醒延遲探針設定", this);
+        advGroup->setObjectName("advanced_groupBox");
+        QVBoxLayout *layout = new QVBoxLayout(advGroup);
+
+        QLabel *lblPeriod = new QLabel("探針週期 (µs):", advGroup);
+        QSpinBox *spinPeriod = new QSpinBox(advGroup);
+        spinPeriod->setRange(100, 100000);
+        spinPeriod->setSingleStep(100);
+        spinPeriod->setValue(10000);
+        spinPeriod->setObjectName("probePeriod_spinBox");
+        spinPeriod->setToolTip("週期越短，每秒的樣本越多，探針本身的 CPU 用量也越高");
+
+        layout->addWidget(lblPeriod);
+        layout->addWidget(spinPeriod);
+
+        connect(spinPeriod, QOverload<int>::of(&QSpinBox::valueChanged), this, [this](int val){
+            emit settingChanged("probePeriodUs", val);
+        });
+
         ui->verticalLayout->insertWidget(ui->verticalLayout->count()-1, advGroup);
     }
 }
@@ -292,6 +499,78 @@ void ToolSettingsForm::updateAllUI(BaseComponent* w) {
         if (comboFreq) {
             comboFreq->setCurrentIndex(static_cast<int>(cpuWidget->frequencyMode()));
         }
+        QCheckBox* chkHeatmap = findChild<QCheckBox*>("cpu_heatmap_checkBox");
+        if (chkHeatmap) chkHeatmap->setChecked(cpuWidget->isCoreHeatmap());
+        QCheckBox* chkTopology = findChild<QCheckBox*>("cpu_topology_checkBox");
+        if (chkTopology) chkTopology->setChecked(cpuWidget->isGroupTopology());
+        QCheckBox* chkGraph = findChild<QCheckBox*>("cpu_graph_checkBox");
+        if (chkGraph) chkGraph->setChecked(cpuWidget->isShowGraph());
+        QCheckBox* chkBreakdown = findChild<QCheckBox*>("cpu_breakdown_checkBox");
+        if (chkBreakdown) chkBreakdown->setChecked(cpuWidget->isShowBreakdown());
+        QCheckBox* chkSensors = findChild<QCheckBox*>("cpu_sensors_checkBox");
+        if (chkSensors) chkSensors->setChecked(cpuWidget->isShowSensors());
+        QCheckBox* chkProcesses = findChild<QCheckBox*>("cpu_processes_checkBox");
+        if (chkProcesses) chkProcesses->setChecked(cpuWidget->isShowTopProcesses());
+        QCheckBox* chkMemoryTop = findChild<QCheckBox*>("cpu_memoryTop_checkBox");
+        if (chkMemoryTop) chkMemoryTop->setChecked(cpuWidget->isShowMemoryTop());
+        QCheckBox* chkPressure = findChild<QCheckBox*>("cpu_pressure_checkBox");
+        if (chkPressure) chkPressure->setChecked(cpuWidget->isShowPressure());
+        QCheckBox* chkSched = findChild<QCheckBox*>("cpu_sched_checkBox");
+        if (chkSched) chkSched->setChecked(cpuWidget->isShowSched());
+        QCheckBox* chkIdle = findChild<QCheckBox*>("cpu_idle_checkBox");
+        if (chkIdle) chkIdle->setChecked(cpuWidget->isShowCpuIdle());
+        QCheckBox* chkFreqResidency = findChild<QCheckBox*>("cpu_freqResidency_checkBox");
+        if (chkFreqResidency) chkFreqResidency->setChecked(cpuWidget->isShowFreqResidency());
+        QSpinBox* spinFreqWindow = findChild<QSpinBox*>("freqWindow_spinBox");
+        if (spinFreqWindow) {
+            spinFreqWindow->blockSignals(true);
+            spinFreqWindow->setValue(cpuWidget->freqWindow());
+            spinFreqWindow->blockSignals(false);
+        }
+        QCheckBox* chkPower = findChild<QCheckBox*>("cpu_power_checkBox");
+        if (chkPower) chkPower->setChecked(cpuWidget->isShowPower());
+        QCheckBox* chkThrottle = findChild<QCheckBox*>("cpu_throttle_checkBox");
+        if (chkThrottle) chkThrottle->setChecked(cpuWidget->isShowThrottle());
+        QLineEdit* editPowercapRoot = findChild<QLineEdit*>("powercapRoot_lineEdit");
+        if (editPowercapRoot) {
+            editPowercapRoot->blockSignals(true);
+            editPowercapRoot->setText(cpuWidget->powercapRoot());
+            editPowercapRoot->blockSignals(false);
+        }
+        QSpinBox* spinProcessCount = findChild<QSpinBox*>("topProcessCount_spinBox");
+        if (spinProcessCount) {
+            spinProcessCount->blockSignals(true);
+            spinProcessCount->setValue(cpuWidget->topProcessCount());
+            spinProcessCount->blockSignals(false);
+        }
+        QCheckBox* chkCgroups = findChild<QCheckBox*>("cpu_cgroups_checkBox");
+        if (chkCgroups) chkCgroups->setChecked(cpuWidget->isShowCgroups());
+        QLineEdit* editCgroupRoot = findChild<QLineEdit*>("cgroupRoot_lineEdit");
+        if (editCgroupRoot) {
+            editCgroupRoot->blockSignals(true);
+            editCgroupRoot->setText(cpuWidget->cgroupRoot());
+            editCgroupRoot->blockSignals(false);
+        }
+        QComboBox* comboCgroupSort = findChild<QComboBox*>("cgroupSortBy_comboBox");
+        if (comboCgroupSort) {
+            comboCgroupSort->blockSignals(true);
+            comboCgroupSort->setCurrentIndex(cpuWidget->cgroupSortBy());
+            comboCgroupSort->blockSignals(false);
+        }
+        QSpinBox* spinCgroupCount = findChild<QSpinBox*>("cgroupCount_spinBox");
+        if (spinCgroupCount) {
+            spinCgroupCount->blockSignals(true);
+            spinCgroupCount->setValue(cpuWidget->cgroupCount());
+            spinCgroupCount->blockSignals(false);
+        }
+        QCheckBox* chkInterrupts = findChild<QCheckBox*>("cpu_interrupts_checkBox");
+        if (chkInterrupts) chkInterrupts->setChecked(cpuWidget->isShowInterrupts());
+        QSpinBox* spinIrqCount = findChild<QSpinBox*>("topIrqCount_spinBox");
+        if (spinIrqCount) {
+            spinIrqCount->blockSignals(true);
+            spinIrqCount->setValue(cpuWidget->topIrqCount());
+            spinIrqCount->blockSignals(false);
+        }
     }
     
     // 更新進階設定 (如果是 DiskWidget)
@@ -304,6 +583,11 @@ void ToolSettingsForm::updateAllUI(BaseComponent* w) {
         if (chkUsage) chkUsage->setChecked(diskWidget->isShowUsagePercent());
         if (chkSpeed) chkSpeed->setChecked(diskWidget->isShowTransferSpeed());
         if (chkActive) chkActive->setChecked(diskWidget->isShowActiveTime());
+
+        QCheckBox* chkDiskGraph = findChild<QCheckBox*>("chkDiskGraph");
+        if (chkDiskGraph) chkDiskGraph->setChecked(diskWidget->isShowGraph());
+        QCheckBox* chkDiskPressure = findChild<QCheckBox*>("chkDiskPressure");
+        if (chkDiskPressure) chkDiskPressure->setChecked(diskWidget->isShowPressure());
     }
     NetworkWidget* netWidget = dynamic_cast<NetworkWidget*>(w);
     if (netWidget) {
@@ -321,6 +605,13 @@ void ToolSettingsForm::updateAllUI(BaseComponent* w) {
             chkPing->blockSignals(false);
         }
 
+        QCheckBox* chkNetGraph = findChild<QCheckBox*>("network_graph_checkBox");
+        if (chkNetGraph) {
+            chkNetGraph->blockSignals(true);
+            chkNetGraph->setChecked(netWidget->isShowGraph());
+            chkNetGraph->blockSignals(false);
+        }
+
         QLineEdit* editPing = findChild<QLineEdit*>("pingTarget_lineEdit");
         if (editPing) {
             editPing->blockSignals(true);
@@ -385,6 +676,15 @@ void ToolSettingsForm::updateAllUI(BaseComponent* w) {
             spinLimit->blockSignals(false);
         }
     }
+    LatencyWidget* latWidget = dynamic_cast<LatencyWidget*>(w);
+    if (latWidget) {
+        QSpinBox *spinPeriod = findChild<QSpinBox*>("probePeriod_spinBox");
+        if (spinPeriod) {
+            spinPeriod->blockSignals(true);
+            spinPeriod->setValue(latWidget->probePeriodUs());
+            spinPeriod->blockSignals(false);
+        }
+    }
 
     this->blockSignals(false);
 }
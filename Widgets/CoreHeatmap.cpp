@@ -0,0 +1,188 @@
+#include "CoreHeatmap.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QHelpEvent>
+#include <QMouseEvent>
+#include <QToolTip>
+#include <algorithm>
+
+namespace {
+constexpr int kCellSize = 10;
+constexpr int kCellGap = 2;
+constexpr int kPitch = kCellSize + kCellGap;
+constexpr int kPreferredColumns = 16;
+}
+
+CoreHeatmap::CoreHeatmap(QWidget *parent) : QWidget(parent) {
+    setMouseTracking(true);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+    setFixedHeight(kCellSize);
+
+    // 低使用率為藍、高使用率為紅 (色相 210° -> 0°)，量化後預先建立調色盤
+    for (int i = 0; i < kBucketCount; ++i) {
+        const qreal t = qreal(i) / (kBucketCount - 1);
+        m_palette[i] = QColor::fromHsvF((1.0 - t) * 210.0 / 360.0, 0.75, 0.45 + 0.5 * t, 0.85);
+    }
+}
+
+QSize CoreHeatmap::sizeHint() const {
+    const int columns = qBound(1, m_count, kPreferredColumns);
+    const int rows = m_count > 0 ? (m_count + columns - 1) / columns : 1;
+    return QSize(columns * kPitch - kCellGap, rows * kPitch - kCellGap);
+}
+
+quint8 CoreHeatmap::bucketFor(float usage) {
+    return static_cast<quint8>(qBound(0, qRound(usage / 100.0f * (kBucketCount - 1)), kBucketCount - 1));
+}
+
+quint8 CoreHeatmap::cellStateFor(float usage, quint32 throttleEvents) {
+    return bucketFor(usage) | (throttleEvents > 0 ? kThrottledFlag : 0);
+}
+
+/** --- 資料 --- **/
+
+void CoreHeatmap::setCores(const float *usage, const float *mhz, int count, const quint32 *throttleEvents) {
+    count = qMax(0, count);
+    if (count != m_count) {
+        // 核心數量改變 (通常只在第一次取樣時發生)：重新配置並整張重畫
+        m_count = count;
+        m_usage.assign(usage, usage + count);
+        m_mhz.assign(count, 0.0f);
+        if (mhz) std::copy(mhz, mhz + count, m_mhz.begin());
+        m_throttle.assign(count, 0);
+        if (throttleEvents) std::copy(throttleEvents, throttleEvents + count, m_throttle.begin());
+        m_cells.resize(count);
+        std::transform(m_usage.begin(), m_usage.end(), m_throttle.begin(), m_cells.begin(), cellStateFor);
+        m_hovered = -1;
+        updateGeometry();
+        layoutCells();
+        update();
+        return;
+    }
+
+    std::copy(usage, usage + count, m_usage.begin());
+    if (mhz) std::copy(mhz, mhz + count, m_mhz.begin());
+    if (throttleEvents) {
+        std::copy(throttleEvents, throttleEvents + count, m_throttle.begin());
+    } else {
+        std::fill(m_throttle.begin(), m_throttle.end(), 0);
+    }
+    if (!isVisible()) {
+        std::transform(m_usage.begin(), m_usage.end(), m_throttle.begin(), m_cells.begin(), cellStateFor);
+        return;
+    }
+
+    // 只重繪顏色或降頻標記改變的格子，Qt 會合併這些區域
+    for (int i = 0; i < count; ++i) {
+        const quint8 state = cellStateFor(m_usage[i], m_throttle[i]);
+        if (state == m_cells[i]) continue;
+        m_cells[i] = state;
+        update(cellRect(i));
+    }
+}
+
+/** --- 版面 --- **/
+
+void CoreHeatmap::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    layoutCells();
+}
+
+void CoreHeatmap::layoutCells() {
+    const int columns = qMax(1, (width() + kCellGap) / kPitch);
+    const int rows = m_count > 0 ? (m_count + columns - 1) / columns : 1;
+    const int height = rows * kPitch - kCellGap;
+    if (columns != m_columns) {
+        m_columns = columns;
+        update();
+    }
+    if (height != this->height()) setFixedHeight(height);
+}
+
+QRect CoreHeatmap::cellRect(int index) const {
+    return QRect((index % m_columns) * kPitch, (index / m_columns) * kPitch, kCellSize, kCellSize);
+}
+
+int CoreHeatmap::cellAt(const QPoint &pos) const {
+    if (pos.x() < 0 || pos.y() < 0) return -1;
+    const int column = pos.x() / kPitch;
+    const int row = pos.y() / kPitch;
+    // 格子之間的間隙不算命中
+    if (column >= m_columns || pos.x() % kPitch >= kCellSize || pos.y() % kPitch >= kCellSize) return -1;
+    const int index = row * m_columns + column;
+    return index < m_count ? index : -1;
+}
+
+/** --- 繪製 --- **/
+
+void CoreHeatmap::paintEvent(QPaintEvent *event) {
+    if (m_count == 0) return;
+
+    // 只畫與重繪區域相交的列與欄
+    const QRect dirty = event->rect();
+    const int firstRow = qMax(0, dirty.top() / kPitch);
+    const int lastRow = qMin((m_count - 1) / m_columns, dirty.bottom() / kPitch);
+    const int firstColumn = qMax(0, dirty.left() / kPitch);
+    const int lastColumn = qMin(m_columns - 1, dirty.right() / kPitch);
+
+    QPainter painter(this);
+    const QPen throttledPen(QColor(255, 160, 0), 1);
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int column = firstColumn; column <= lastColumn; ++column) {
+            const int index = row * m_columns + column;
+            if (index >= m_count) break;
+            const QRect cell = cellRect(index);
+            painter.fillRect(cell, m_palette[m_cells[index] & ~kThrottledFlag]);
+            if (m_cells[index] & kThrottledFlag) {
+                painter.setPen(throttledPen);
+                painter.drawRect(cell.adjusted(0, 0, -1, -1));
+            }
+        }
+    }
+
+    if (m_hovered >= 0 && m_hovered < m_count) {
+        painter.setPen(QPen(QColor(255, 255, 255, 220), 1));
+        painter.drawRect(cellRect(m_hovered).adjusted(0, 0, -1, -1));
+    }
+}
+
+/** --- 滑鼠 --- **/
+
+void CoreHeatmap::setHovered(int index) {
+    if (index == m_hovered) return;
+    if (m_hovered >= 0) update(cellRect(m_hovered));
+    m_hovered = index;
+    if (m_hovered >= 0) update(cellRect(m_hovered));
+}
+
+void CoreHeatmap::mouseMoveEvent(QMouseEvent *event) {
+    setHovered(cellAt(event->position().toPoint()));
+    QWidget::mouseMoveEvent(event);
+}
+
+void CoreHeatmap::leaveEvent(QEvent *event) {
+    setHovered(-1);
+    QWidget::leaveEvent(event);
+}
+
+bool CoreHeatmap::event(QEvent *event) {
+    if (event->type() != QEvent::ToolTip) return QWidget::event(event);
+
+    QHelpEvent *help = static_cast<QHelpEvent *>(event);
+    const int index = cellAt(help->pos());
+    if (index < 0) {
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+
+    QString text = QString("Core %1: %2%").arg(index).arg(QString::number(m_usage[index], 'f', 1));
+    const float mhz = m_mhz[index];
+    if (mhz > 0) {
+        text += mhz >= 1000 ? QString(" @ %1 GHz").arg(QString::number(mhz / 1000.0, 'f', 2))
+                            : QString(" @ %1 MHz").arg(QString::number(mhz, 'f', 0));
+    }
+    if (m_throttle[index] > 0) text += QString("  THROTTLED x%1").arg(m_throttle[index]);
+    QToolTip::showText(help->globalPos(), text, this, cellRect(index));
+    return true;
+}
@@ -0,0 +1,63 @@
+#ifndef COREHEATMAP_H
+#define COREHEATMAP_H
+
+#include <QWidget>
+#include <QColor>
+#include <vector>
+
+/**
+ * @brief 各核心使用率熱圖 (可重複使用的自繪元件)
+ * 所有核心畫在同一個元件的格子中，取代每個核心一個 QLabel 的列表：
+ * 256 執行緒的主機也只有一個元件，切換顯示時不會觸發大量版面重排。
+ *
+ * 數值以 structure-of-arrays 保存 (使用率、頻率、降頻事件、已繪製的量化值各一個陣列)；
+ * 更新時只有量化後 (每 5%) 或降頻標記改變的格子才標記重繪，paintEvent 也只畫與重繪區域相交的格子。
+ * 本次間隔有過熱降頻事件的核心加上橘色外框；個別核心的數值只在滑鼠停留時以提示顯示。
+ */
+class CoreHeatmap : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit CoreHeatmap(QWidget *parent = nullptr);
+
+    /**
+     * @brief 更新各核心數值
+     * @param usage 使用率 (%)
+     * @param mhz 目前頻率 (MHz，0 代表無法取得)；可為 nullptr
+     * @param throttleEvents 本次間隔的過熱降頻事件數，大於 0 的核心加上外框；可為 nullptr
+     */
+    void setCores(const float *usage, const float *mhz, int count, const quint32 *throttleEvents = nullptr);
+
+    QSize sizeHint() const override;
+
+protected:
+    bool event(QEvent *event) override; // 滑鼠停留時顯示該核心的提示
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void leaveEvent(QEvent *event) override;
+
+private:
+    static constexpr int kBucketCount = 21;  // 0%, 5%, ... 100%
+    static constexpr quint8 kThrottledFlag = 0x80;
+
+    void layoutCells();
+    QRect cellRect(int index) const;
+    int cellAt(const QPoint &pos) const;
+    void setHovered(int index);
+    static quint8 bucketFor(float usage);
+    static quint8 cellStateFor(float usage, quint32 throttleEvents);
+
+    // 各核心數值 (structure of arrays)
+    std::vector<float> m_usage;
+    std::vector<float> m_mhz;
+    std::vector<quint32> m_throttle;
+    std::vector<quint8> m_cells;    // 目前畫面上的格子狀態：量化值，降頻時加上 kThrottledFlag
+    int m_count = 0;
+
+    int m_columns = 1;
+    int m_hovered = -1;
+    QColor m_palette[kBucketCount];
+};
+
+#endif // COREHEATMAP_H
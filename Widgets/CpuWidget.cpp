@@ -1,25 +1,49 @@
 #include "CpuWidget.h"
+#include "Core/SystemCollector.h"
+#include "Core/MetricHistory.h"
 #include <QStyle>
-#include <QDebug>
-#include <QThread>
-
-#ifdef Q_OS_WIN
-// MinGW 某些版本可能缺少此結構定義，手動補上以避免編譯錯誤
-typedef struct _PROCESSOR_POWER_INFORMATION {
-    ULONG Number;
-    ULONG MaxMhz;
-    ULONG CurrentMhz;
-    ULONG MhzLimit;
-    ULONG MaxIdleState;
-    ULONG CurrentIdleState;
-} PROCESSOR_POWER_INFORMATION, *PPROCESSOR_POWER_INFORMATION;
-#endif
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QLoggingCategory>
+#include <algorithm>
+
+/**
+ * @brief 各項掃描的耗時 (每次取樣一行，預設關閉)
+ * 以 QT_LOGGING_RULES="cpuwidget.scan.debug=true" 開啟
+ */
+Q_LOGGING_CATEGORY(lcScan, "cpuwidget.scan", QtWarningMsg)
+
+namespace {
+// 本小工具使用的取樣領域 (選用領域只在對應的顯示設定開啟時才會取樣)
+const SystemCollector::Domains kCollectorDomains = SystemCollector::Cpu | SystemCollector::Memory |
+    SystemCollector::Sensors | SystemCollector::Processes | SystemCollector::Pressure | SystemCollector::Cgroups |
+    SystemCollector::Interrupts | SystemCollector::Scheduler | SystemCollector::CpuIdle |
+    SystemCollector::FreqResidency | SystemCollector::Power | SystemCollector::Throttle |
+    SystemCollector::Threads | SystemCollector::ProcessMemory;
+
+// 每秒事件數：大於一千時以 k / M 表示
+QString formatRate(double perSec) {
+    if (perSec >= 1e6) return QString::number(perSec / 1e6, 'f', 1) + "M";
+    if (perSec >= 1e3) return QString::number(perSec / 1e3, 'f', 1) + "k";
+    return QString::number(perSec, 'f', 0);
+}
+}
 
 CpuWidget::CpuWidget(QWidget *parent) : BaseComponent(parent) {
     m_titleLabel = new QLabel("SYSTEM", this);
     m_cpuLabel = new QLabel("CPU: --%", this);
     m_ramLabel = new QLabel("RAM: --%", this);
     m_ramDetailLabel = new QLabel("Used: -- / -- GB", this);
+    m_breakdownLabel = new QLabel("usr --  sys --  io --  irq --  st --", this);
+    m_pressureLabel = new QLabel("PSI: --", this);
+    m_topologyLabel = new QLabel("Socket 0: --%", this);
+    m_schedLabel = new QLabel("load -- -- --", this);
+    m_idleLabel = new QLabel("C-state: --", this);
+    m_freqResidencyLabel = new QLabel("Freq residency: --", this);
+    m_powerLabel = new QLabel("Power: -- W", this);
+    m_throttleLabel = new QLabel("Throttle: --", this);
+    m_interruptsLabel = new QLabel("ctxt --/s  fork --/s  irq --/s  softirq --/s", this);
+    m_memoryTopLabel = new QLabel("PSS: --", this);
 
     // 垂直佈局
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
@@ -31,7 +55,49 @@ CpuWidget::CpuWidget(QWidget *parent) : BaseComponent(parent) {
 
     // 內容
     mainLayout->addWidget(m_cpuLabel, 0, Qt::AlignLeft);
-    
+    mainLayout->addWidget(m_breakdownLabel, 0, Qt::AlignLeft);
+    m_breakdownLabel->hide(); // 預設隱藏
+    mainLayout->addWidget(m_pressureLabel, 0, Qt::AlignLeft);
+    m_pressureLabel->hide();
+    mainLayout->addWidget(m_schedLabel, 0, Qt::AlignLeft);
+    m_schedLabel->hide();
+    mainLayout->addWidget(m_idleLabel, 0, Qt::AlignLeft);
+    m_idleLabel->hide();
+    mainLayout->addWidget(m_powerLabel, 0, Qt::AlignLeft);
+    m_powerLabel->hide();
+    mainLayout->addWidget(m_throttleLabel, 0, Qt::AlignLeft);
+    m_throttleLabel->hide();
+    mainLayout->addWidget(m_interruptsLabel, 0, Qt::AlignLeft);
+    m_interruptsLabel->hide();
+
+    // 中斷來源排行 (與 m_interruptsLabel 一起顯示)
+    m_irqContainer = new QWidget(this);
+    m_irqLayout = new QVBoxLayout(m_irqContainer);
+    m_irqLayout->setContentsMargins(10, 0, 0, 0);
+    m_irqLayout->setSpacing(2);
+    mainLayout->addWidget(m_irqContainer);
+    m_irqContainer->hide();
+
+    // CPU 使用率曲線 (最近 5 分鐘，預設隱藏)
+    m_cpuGraph = new SparklineGraph(this);
+    m_cpuGraph->setCapacity(300);
+    m_cpuGraph->setRange(0.0f, 100.0f);
+    m_cpuGraph->setColor(QColor(120, 200, 255));
+    m_cpuGraph->setSeries(MetricHistory::seriesKey(MetricPoint::CpuTotal));
+    mainLayout->addWidget(m_cpuGraph);
+    m_cpuGraph->hide();
+
+    // 插槽與 P/E 核心彙總 (預設隱藏)
+    mainLayout->addWidget(m_topologyLabel, 0, Qt::AlignLeft);
+    m_topologyLabel->hide();
+
+    // 頻率停留分佈 (預設隱藏)
+    mainLayout->addWidget(m_freqResidencyLabel, 0, Qt::AlignLeft);
+    m_freqResidencyLabel->hide();
+    m_freqStrip = new FreqResidencyStrip(this);
+    mainLayout->addWidget(m_freqStrip);
+    m_freqStrip->hide();
+
     // 核心列表容器
     m_coresContainer = new QWidget(this);
     m_coresLayout = new QVBoxLayout(m_coresContainer);
@@ -40,44 +106,89 @@ CpuWidget::CpuWidget(QWidget *parent) : BaseComponent(parent) {
     mainLayout->addWidget(m_coresContainer);
     m_coresContainer->hide(); // 預設隱藏
 
+    // 核心熱圖 (與核心列表擇一顯示)
+    m_coresHeatmap = new CoreHeatmap(this);
+    mainLayout->addWidget(m_coresHeatmap);
+    m_coresHeatmap->hide();
+
+    // 溫度與風扇列表 (預設隱藏，顯示時才啟用收集執行緒的感測器取樣)
+    m_sensorsContainer = new QWidget(this);
+    m_sensorsLayout = new QVBoxLayout(m_sensorsContainer);
+    m_sensorsLayout->setContentsMargins(10, 0, 0, 0);
+    m_sensorsLayout->setSpacing(2);
+    mainLayout->addWidget(m_sensorsContainer);
+    m_sensorsContainer->hide();
+
+    // 行程排行 (預設隱藏，顯示時才啟用收集執行緒的 /proc 掃描)
+    m_processesContainer = new QWidget(this);
+    m_processesLayout = new QVBoxLayout(m_processesContainer);
+    m_processesLayout->setContentsMargins(10, 0, 0, 0);
+    m_processesLayout->setSpacing(2);
+    mainLayout->addWidget(m_processesContainer);
+    m_processesContainer->hide();
+
+    // 執行緒排行 (點選行程時展開，再點一次收合)
+    m_threadsLabel = new QLabel(this);
+    m_threadsLabel->setObjectName("threadsLabel");
+    m_threadsLabel->setStyleSheet("font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 20px;");
+    m_threadsLabel->setCursor(Qt::PointingHandCursor);
+    m_threadsLabel->installEventFilter(this);
+    mainLayout->addWidget(m_threadsLabel, 0, Qt::AlignLeft);
+    m_threadsLabel->hide();
+
+    // cgroup 排行 (預設隱藏，顯示時才啟用收集執行緒的 cgroup 走訪)
+    m_cgroupsContainer = new QWidget(this);
+    m_cgroupsLayout = new QVBoxLayout(m_cgroupsContainer);
+    m_cgroupsLayout->setContentsMargins(10, 0, 0, 0);
+    m_cgroupsLayout->setSpacing(2);
+    mainLayout->addWidget(m_cgroupsContainer);
+    m_cgroupsContainer->hide();
+
     mainLayout->addWidget(m_ramLabel, 0, Qt::AlignLeft);
     mainLayout->addWidget(m_ramDetailLabel, 0, Qt::AlignLeft);
 
     // 預設隱藏詳細資訊
     m_ramDetailLabel->hide();
 
-    // 初始化 Windows CPU 計算變數
-#ifdef Q_OS_WIN
-    m_preIdleTime.dwLowDateTime = 0;
-    m_preIdleTime.dwHighDateTime = 0;
-    m_preKernelTime.dwLowDateTime = 0;
-    m_preKernelTime.dwHighDateTime = 0;
-    m_preUserTime.dwLowDateTime = 0;
-    m_preUserTime.dwHighDateTime = 0;
+    // 記憶體用量排行 (預設隱藏，顯示時才啟用收集執行緒的 smaps_rollup 讀取)
+    mainLayout->addWidget(m_memoryTopLabel, 0, Qt::AlignLeft);
+    m_memoryTopLabel->hide();
+    m_memoryTopContainer = new QWidget(this);
+    m_memoryTopLayout = new QVBoxLayout(m_memoryTopContainer);
+    m_memoryTopLayout->setContentsMargins(10, 0, 0, 0);
+    m_memoryTopLayout->setSpacing(2);
+    mainLayout->addWidget(m_memoryTopContainer);
+    m_memoryTopContainer->hide();
 
-    initPdh();
-#endif
+    // 歷史統計只在滑鼠停留時查詢
+    m_cpuLabel->installEventFilter(this);
+    m_ramLabel->installEventFilter(this);
+    m_schedLabel->setProperty("historyKey", MetricHistory::seriesKey(MetricPoint::RunDelayAvg));
+    m_schedLabel->setProperty("historyTitle", "Run-queue wait (avg per CPU)");
+    m_schedLabel->setProperty("historyUnit", " ms/s");
+    m_schedLabel->installEventFilter(this);
+    m_powerLabel->setProperty("historyKey", MetricHistory::seriesKey(MetricPoint::PowerPackage));
+    m_powerLabel->setProperty("historyTitle", "Package power");
+    m_powerLabel->setProperty("historyUnit", " W");
+    m_powerLabel->installEventFilter(this);
+    m_throttleLabel->setProperty("historyKey", MetricHistory::seriesKey(MetricPoint::ThrottlePackage));
+    m_throttleLabel->setProperty("historyTitle", "Package throttle events (first socket)");
+    m_throttleLabel->setProperty("historyUnit", "");
+    m_throttleLabel->installEventFilter(this);
 
-    // 定時器 (1秒更新一次)
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &CpuWidget::updateData);
-    m_updateTimer->start(1000);
+    // PSI trigger 觸發時立即更新，不等下一個計時週期
+    connect(SystemCollector::instance(), &SystemCollector::pressureStall, this, [this]() {
+        if (m_showPressure) updateData();
+    });
+
+    // 取樣在收集執行緒進行，這裡只負責顯示 (1秒更新一次)
+    SystemCollector::instance()->setInterval(kCollectorDomains, 1000);
+    startSampling(1000);
 
     initStyle();
     updateData();
 }
 
-CpuWidget::~CpuWidget() {
-#ifdef Q_OS_WIN
-    if (m_pdhQuery) {
-        PdhCloseQuery(m_pdhQuery);
-    }
-    if (m_pdhFreqQuery) {
-        PdhCloseQuery(m_pdhFreqQuery);
-    }
-#endif
-}
-
 void CpuWidget::initStyle() {
     BaseComponent::initStyle();
 
@@ -91,13 +202,23 @@ void CpuWidget::initStyle() {
                         "QLabel { color: white; background: transparent; font-family: 'Segoe UI', 'Microsoft JhengHei'; }"
                         "#titleLabel { font-size: 14px; font-weight: bold; color: rgba(255, 255, 255, 220); margin-bottom: 2px; }"
                         "#cpuLabel, #ramLabel { font-size: 12px; color: rgba(255, 255, 255, 190); }"
-                        "#ramDetailLabel { font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 5px; }"
+                        "#ramDetailLabel, #breakdownLabel, #pressureLabel, #interruptsLabel, #topologyLabel, #schedLabel, #idleLabel, #freqResidencyLabel, #powerLabel, #throttleLabel, #memoryTopLabel { font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 5px; }"
                         );
 
     m_titleLabel->setObjectName("titleLabel");
     m_cpuLabel->setObjectName("cpuLabel");
     m_ramLabel->setObjectName("ramLabel");
     m_ramDetailLabel->setObjectName("ramDetailLabel");
+    m_breakdownLabel->setObjectName("breakdownLabel");
+    m_pressureLabel->setObjectName("pressureLabel");
+    m_interruptsLabel->setObjectName("interruptsLabel");
+    m_topologyLabel->setObjectName("topologyLabel");
+    m_schedLabel->setObjectName("schedLabel");
+    m_idleLabel->setObjectName("idleLabel");
+    m_freqResidencyLabel->setObjectName("freqResidencyLabel");
+    m_powerLabel->setObjectName("powerLabel");
+    m_throttleLabel->setObjectName("throttleLabel");
+    m_memoryTopLabel->setObjectName("memoryTopLabel");
 
     this->style()->unpolish(this);
     this->style()->polish(this);
@@ -105,16 +226,57 @@ void CpuWidget::initStyle() {
 
 void CpuWidget::setUpdateInterval(int ms) {
     BaseComponent::setUpdateInterval(ms);
-    if (m_updateTimer) {
-        m_updateTimer->setInterval(ms);
-    }
+    SystemCollector::instance()->setInterval(kCollectorDomains, ms);
 }
 
 void CpuWidget::setCustomSetting(const QString &key, const QVariant &value) {
     if (key == "showCores") {
         m_showCores = value.toBool();
-        m_coresContainer->setVisible(m_showCores);
-        this->adjustSize(); // 調整視窗大小以適應內容
+        updateCoreViews();
+    } else if (key == "coreHeatmap") {
+        m_coreHeatmap = value.toBool();
+        updateCoreViews();
+    } else if (key == "showSched") {
+        m_showSched = value.toBool();
+        m_schedLabel->setVisible(m_showSched);
+        SystemCollector::instance()->setEnabled(this, SystemCollector::Scheduler, m_showSched);
+        updateData();
+        this->adjustSize();
+    } else if (key == "showCpuIdle") {
+        m_showCpuIdle = value.toBool();
+        m_idleLabel->setVisible(m_showCpuIdle);
+        SystemCollector::instance()->setEnabled(this, SystemCollector::CpuIdle, m_showCpuIdle);
+        updateData();
+        this->adjustSize();
+    } else if (key == "showFreqResidency") {
+        m_showFreqResidency = value.toBool();
+        m_freqResidencyLabel->setVisible(m_showFreqResidency);
+        m_freqStrip->setVisible(m_showFreqResidency);
+        SystemCollector::instance()->setEnabled(this, SystemCollector::FreqResidency, m_showFreqResidency);
+        updateData();
+        this->adjustSize();
+    } else if (key == "freqWindow") {
+        m_freqWindow = qBound(5, value.toInt(), 3600);
+        SystemCollector::instance()->setFreqResidencyWindow(m_freqWindow);
+    } else if (key == "showPower") {
+        m_showPower = value.toBool();
+        m_powerLabel->setVisible(m_showPower);
+        SystemCollector::instance()->setEnabled(this, SystemCollector::Power, m_showPower);
+        updateData();
+        this->adjustSize();
+    } else if (key == "powercapRoot") {
+        m_powercapRoot = value.toString().trimmed();
+        SystemCollector::instance()->setPowercapRoot(m_powercapRoot);
+    } else if (key == "showThrottle") {
+        m_showThrottle = value.toBool();
+        m_throttleLabel->setVisible(m_showThrottle);
+        SystemCollector::instance()->setEnabled(this, SystemCollector::Throttle, m_showThrottle);
+        updateData();
+        this->adjustSize();
+    } else if (key == "groupTopology") {
+        m_groupTopology = value.toBool();
+        m_topologyLabel->setVisible(m_groupTopology);
+        updateCoreViews(); // 核心列表的行數改為實體核心數
     } else if (key == "showRamDetail") {
         m_showRamDetail = value.toBool();
         m_ramDetailLabel->setVisible(m_showRamDetail);
@@ -124,172 +286,551 @@ void CpuWidget::setCustomSetting(const QString &key, const QVariant &value) {
         // 這裡不需要 adjustSize，因為是在 updateCoreUsage 內動態改變文字長度
     } else if (key == "freqAlgo") {
         m_freqMode = static_cast<FrequencyMode>(value.toInt());
+    } else if (key == "showBreakdown") {
+        m_showBreakdown = value.toBool();
+        m_breakdownLabel->setVisible(m_showBreakdown);
+        updateData();
+        this->adjustSize();
+    } else if (key == "showGraph") {
+        m_showGraph = value.toBool();
+        m_cpuGraph->setVisible(m_showGraph);
+        if (m_showGraph) m_cpuGraph->sync(); // 從歷史資料補齊隱藏期間的曲線
+        this->adjustSize();
+    } else if (key == "showSensors") {
+        m_showSensors = value.toBool();
+        m_sensorsContainer->setVisible(m_showSensors);
+        // 不顯示時完全不讀取 hwmon，也不累積感測器歷史
+        SystemCollector::instance()->setEnabled(this, SystemCollector::Sensors, m_showSensors);
+        updateData();
+        this->adjustSize();
+    } else if (key == "showTopProcesses") {
+        m_showTopProcesses = value.toBool();
+        m_processesContainer->setVisible(m_showTopProcesses);
+        // 行程多的主機上掃描 /proc 並不便宜，只在顯示時進行
+        SystemCollector::instance()->setEnabled(this, SystemCollector::Processes, m_showTopProcesses);
+        if (!m_showTopProcesses) setDrillDown(0);
+        updateData();
+        this->adjustSize();
+    } else if (key == "showPressure") {
+        m_showPressure = value.toBool();
+        m_pressureLabel->setVisible(m_showPressure);
+        SystemCollector::instance()->setEnabled(this, SystemCollector::Pressure, m_showPressure);
+        updateData();
+        this->adjustSize();
+    } else if (key == "showMemoryTop") {
+        m_showMemoryTop = value.toBool();
+        m_memoryTopLabel->setVisible(m_showMemoryTop);
+        m_memoryTopContainer->setVisible(m_showMemoryTop);
+        // smaps_rollup 需要走訪每個行程的 VMA，只在顯示時讀取
+        SystemCollector::instance()->setEnabled(this, SystemCollector::ProcessMemory, m_showMemoryTop);
+        updateData();
+        this->adjustSize();
+    } else if (key == "topProcessCount") {
+        m_topProcessCount = qBound(1, value.toInt(), SnapshotLimits::kMaxTopProcesses);
+        updateData();
+        this->adjustSize();
+    } else if (key == "showCgroups") {
+        m_showCgroups = value.toBool();
+        m_cgroupsContainer->setVisible(m_showCgroups);
+        SystemCollector::instance()->setEnabled(this, SystemCollector::Cgroups, m_showCgroups);
+        updateData();
+        this->adjustSize();
+    } else if (key == "cgroupRoot") {
+        m_cgroupRoot = value.toString().trimmed();
+        SystemCollector::instance()->setCgroupView(m_cgroupRoot, m_cgroupSortBy);
+    } else if (key == "cgroupSortBy") {
+        m_cgroupSortBy = qBound(0, value.toInt(), int(CgroupTopSample::ByIo));
+        SystemCollector::instance()->setCgroupView(m_cgroupRoot, m_cgroupSortBy);
+    } else if (key == "showInterrupts") {
+        m_showInterrupts = value.toBool();
+        m_interruptsLabel->setVisible(m_showInterrupts);
+        m_irqContainer->setVisible(m_showInterrupts);
+        // /proc/interrupts 在多核心主機上是很寬的矩陣，只在顯示時讀取
+        SystemCollector::instance()->setEnabled(this, SystemCollector::Interrupts, m_showInterrupts);
+        updateData();
+        this->adjustSize();
+    } else if (key == "topIrqCount") {
+        m_topIrqCount = qBound(1, value.toInt(), SnapshotLimits::kMaxTopIrqs);
+        updateData();
+        this->adjustSize();
+    } else if (key == "cgroupCount") {
+        m_cgroupCount = qBound(1, value.toInt(), SnapshotLimits::kMaxTopCgroups);
+        updateData();
+        this->adjustSize();
     }
 }
 
 void CpuWidget::updateData() {
-#ifdef Q_OS_WIN
-    double cpu = getCpuUsage();
-    int ramPercent = getMemoryUsage();
+    const SystemSnapshot *snap = SystemCollector::instance()->snapshot();
+    if (!snap || !snap->cpu.valid) {
+        m_cpuLabel->setText("CPU: N/A");
+        m_ramLabel->setText("RAM: N/A");
+        return;
+    }
 
     // 預設文字，稍後若有計算頻率會再更新
-    QString cpuText = QString("CPU Usage: %1%").arg(QString::number(cpu, 'f', 1));
-    
+    QString cpuText = QString("CPU Usage: %1%").arg(QString::number(snap->cpu.totalUsage, 'f', 1));
+
     // 無論是否顯示核心列表，都計算頻率
-    // updateCoreUsage 現在會回傳最大頻率字串，並更新核心列表(如果顯示的話)
-    QString freqStr = updateCoreUsage();
-    
+    // updateCoreUsage 會回傳依演算法選出的頻率字串，並更新核心列表(如果顯示的話)
+    m_sched = (m_showSched && snap->sched.hasRunDelay) ? &snap->sched : nullptr;
+    m_throttle = (m_showThrottle && snap->throttle.valid) ? &snap->throttle : nullptr;
+    QString freqStr = updateCoreUsage(snap->cpu);
+    m_sched = nullptr;
+    m_throttle = nullptr;
+
     // 只有在啟用頻率顯示時才附加到主標籤
     if (m_showCoreFreq && !freqStr.isEmpty()) {
         cpuText += QString(" @ %1").arg(freqStr);
     }
 
     m_cpuLabel->setText(cpuText);
-    m_ramLabel->setText(QString("RAM Usage: %1%").arg(ramPercent));
+    if (m_showGraph) m_cpuGraph->sync();
+
+    // 時間分類：steal 偏高代表虛擬機正在被其他租戶搶佔
+    if (m_showBreakdown) {
+        const CpuSample &cpu = snap->cpu;
+        if (cpu.hasBreakdown) {
+            auto pct = [](float value) { return QString::number(value, 'f', 1); };
+            m_breakdownLabel->setText(QString("usr %1  sys %2  io %3  irq %4  st %5")
+                                          .arg(pct(cpu.userPercent), pct(cpu.systemPercent), pct(cpu.iowaitPercent),
+                                               pct(cpu.irqPercent), pct(cpu.stealPercent)));
+        } else {
+            m_breakdownLabel->setText("usr/sys/io/irq/st: N/A");
+        }
+    }
+
+    // PSI：使用率高不一定代表有工作在等待，停滯時間才是實際的延遲
+    if (m_showPressure) {
+        const PressureSample &cpuPressure = snap->pressure[PressureSample::Cpu];
+        const PressureSample &memPressure = snap->pressure[PressureSample::Memory];
+        if (cpuPressure.valid || memPressure.valid) {
+            m_pressureLabel->setText(formatPressure("cpu", cpuPressure) + "\n" + formatPressure("mem", memPressure));
+        } else {
+            m_pressureLabel->setText("PSI: N/A");
+        }
+    }
+
+    if (m_showSensors) updateSensors(*snap);
+    if (m_showTopProcesses) updateTopProcesses(snap->processes);
+    if (m_showMemoryTop) updateMemoryTop(snap->memoryTop);
+    if (m_drillPid > 0) updateThreads(snap->threads);
+    if (m_showCgroups) updateCgroups(snap->cgroups);
+    if (m_showSched) updateSched(*snap);
+    if (m_showCpuIdle) updateCpuIdle(snap->cpuIdle);
+    if (m_showFreqResidency) updateFreqResidency(snap->freqResidency);
+    if (m_showPower) updatePower(*snap);
+    if (m_showThrottle) updateThrottle(snap->throttle);
+    if (m_showInterrupts) updateInterrupts(*snap);
+
+    const MemorySample &mem = snap->memory;
+    if (!mem.valid) {
+        m_ramLabel->setText("RAM: N/A");
+        return;
+    }
+    m_ramLabel->setText(QString("RAM Usage: %1%").arg(mem.loadPercent));
 
     if (m_showRamDetail) {
-        MEMORYSTATUSEX memInfo;
-        memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+        double totalGB = mem.totalBytes / (1024.0 * 1024.0 * 1024.0);
+        double usedGB = (mem.totalBytes - mem.availableBytes) / (1024.0 * 1024.0 * 1024.0);
+        QString detail = QString("Used: %1 / %2 GB").arg(QString::number(usedGB, 'f', 1)).arg(QString::number(totalGB, 'f', 1));
+        if (mem.hasBreakdown) detail += "\n" + formatMemoryBreakdown(mem);
+        m_ramDetailLabel->setText(detail);
+    }
+}
 
-        if (GlobalMemoryStatusEx(&memInfo)) {
-            double totalGB = memInfo.ullTotalPhys / (1024.0 * 1024.0 * 1024.0);
-            double usedGB = (memInfo.ullTotalPhys - memInfo.ullAvailPhys) / (1024.0 * 1024.0 * 1024.0);
-            m_ramDetailLabel->setText(QString("Used: %1 / %2 GB").arg(QString::number(usedGB, 'f', 1)).arg(QString::number(totalGB, 'f', 1)));
+bool CpuWidget::eventFilter(QObject *watched, QEvent *event) {
+    if (event->type() == QEvent::MouseButtonRelease) {
+        // 點選行程：展開 (或收合) 執行緒排行；點選執行緒排行本身也收合
+        if (watched == m_threadsLabel) {
+            setDrillDown(0);
+            return true;
         }
+        const int pid = watched->property("pid").toInt();
+        if (pid > 0) {
+            setDrillDown(pid == m_drillPid ? 0 : pid);
+            return true;
+        }
+    }
+    if (event->type() != QEvent::ToolTip) return BaseComponent::eventFilter(watched, event);
+
+    QString text;
+    if (watched == m_cpuLabel) {
+        text = historyTooltip(MetricHistory::seriesKey(MetricPoint::CpuTotal), "CPU Usage");
+    } else if (watched == m_ramLabel) {
+        text = historyTooltip(MetricHistory::seriesKey(MetricPoint::MemoryLoad), "RAM Usage");
+    } else if (watched->property("historyKey").isValid()) {
+        // 感測器標籤：建立時記錄對應的歷史序列
+        text = historyTooltip(watched->property("historyKey").toUInt(), watched->property("historyTitle").toString(),
+                              watched->property("historyUnit").toString());
+    } else {
+        return BaseComponent::eventFilter(watched, event);
+    }
+    QToolTip::showText(static_cast<QHelpEvent *>(event)->globalPos(), text, static_cast<QWidget *>(watched));
+    return true;
+}
+
+QString CpuWidget::historyTooltip(quint32 seriesKey, const QString &title, const QString &unit) {
+    static const struct { qint64 spanMs; const char *label; } kWindows[] = {
+        {60 * 1000, "1 min"},
+        {10 * 60 * 1000, "10 min"},
+        {60 * 60 * 1000, "1 h"},
+        {24 * 60 * 60 * 1000, "24 h"},
+    };
+
+    MetricHistory *history = MetricHistory::instance();
+    history->ingest();
+    const qint64 now = history->lastTimestamp(seriesKey);
+    if (now < 0) return title + ": no history";
+
+    QStringList lines{title};
+    for (const auto &window : kWindows) {
+        HistoryPoint stats;
+        if (!history->summarize(seriesKey, now - window.spanMs, now, stats)) continue;
+        lines << QString("%1: avg %2%5 (min %3%5, max %4%5)")
+                     .arg(window.label)
+                     .arg(QString::number(stats.avg, 'f', 1))
+                     .arg(QString::number(stats.min, 'f', 1))
+                     .arg(QString::number(stats.max, 'f', 1))
+                     .arg(unit);
     }
-#else
-    m_cpuLabel->setText("CPU: N/A");
-    m_ramLabel->setText("RAM: N/A");
-#endif
+    return lines.join('\n');
 }
 
-#ifdef Q_OS_WIN
-// 輔助函式：將 FILETIME 轉換為 unsigned long long
-unsigned long long fileTimeToInt64(const FILETIME &ft) {
-    return (((unsigned long long)(ft.dwHighDateTime)) << 32) | ((unsigned long long)ft.dwLowDateTime);
+void CpuWidget::updateCoreViews() {
+    const bool showList = m_showCores && !m_coreHeatmap;
+    m_coresContainer->setVisible(showList);
+    m_coresHeatmap->setVisible(m_showCores && m_coreHeatmap);
+
+    // 改用熱圖時釋放核心標籤，256 執行緒的主機上就不必保留 256 個 QLabel
+    if (!showList && !m_coreLabels.empty()) {
+        for (QLabel *lbl : m_coreLabels) delete lbl;
+        m_coreLabels.clear();
+    }
+    updateData(); // 隱藏期間不更新核心文字，重新顯示時立即補上
+    this->adjustSize(); // 調整視窗大小以適應內容
 }
 
-double CpuWidget::getCpuUsage() {
-    FILETIME idleTime, kernelTime, userTime;
-    if (!GetSystemTimes(&idleTime, &kernelTime, &userTime)) {
-        return 0.0;
+void CpuWidget::ensureCoreLabels(int coreCount) {
+    if ((int)m_coreLabels.size() == coreCount) return;
+
+    // 核心數量改變 (通常只在第一次取樣時發生)，重建標籤
+    for (QLabel *lbl : m_coreLabels) delete lbl;
+    m_coreLabels.assign(coreCount, nullptr);
+
+    for (int i = 0; i < coreCount; ++i) {
+        QLabel *lbl = new QLabel(QString("Core %1: --%").arg(i), m_coresContainer);
+        lbl->setStyleSheet("font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 10px;");
+        m_coresLayout->addWidget(lbl);
+        m_coreLabels[i] = lbl;
     }
+    if (m_showCores) this->adjustSize();
+}
 
-    unsigned long long idle = fileTimeToInt64(idleTime);
-    unsigned long long kernel = fileTimeToInt64(kernelTime);
-    unsigned long long user = fileTimeToInt64(userTime);
+void CpuWidget::updateSensors(const SystemSnapshot &snap) {
+    const int count = snap.sensorCount;
+    if ((int)m_sensorLabels.size() != count) {
+        // 感測器清單只在第一次探索後改變一次，之後重複使用標籤
+        for (QLabel *lbl : m_sensorLabels) delete lbl;
+        m_sensorLabels.assign(count, nullptr);
 
-    unsigned long long preIdle = fileTimeToInt64(m_preIdleTime);
-    unsigned long long preKernel = fileTimeToInt64(m_preKernelTime);
-    unsigned long long preUser = fileTimeToInt64(m_preUserTime);
+        for (int i = 0; i < count; ++i) {
+            const SensorSample &sensor = snap.sensors[i];
+            const bool fan = sensor.type == SensorSample::Fan;
+            QLabel *lbl = new QLabel(m_sensorsContainer);
+            lbl->setStyleSheet("font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 10px;");
+            lbl->setProperty("historyKey", MetricHistory::seriesKey(fan ? MetricPoint::SensorFan : MetricPoint::SensorTemp, i));
+            lbl->setProperty("historyTitle", sensor.label.toString());
+            lbl->setProperty("historyUnit", fan ? " RPM" : "°C");
+            lbl->installEventFilter(this);
+            m_sensorsLayout->addWidget(lbl);
+            m_sensorLabels[i] = lbl;
+        }
+        this->adjustSize();
+    }
 
-    unsigned long long idleDiff = idle - preIdle;
-    unsigned long long kernelDiff = kernel - preKernel;
-    unsigned long long userDiff = user - preUser;
+    for (int i = 0; i < count; ++i) {
+        const SensorSample &sensor = snap.sensors[i];
+        QString value = "N/A";
+        if (sensor.present) {
+            value = (sensor.type == SensorSample::Fan)
+                ? QString("%1 RPM").arg(QString::number(sensor.value, 'f', 0))
+                : QString("%1°C").arg(QString::number(sensor.value, 'f', 1));
+        }
+        m_sensorLabels[i]->setText(QString("%1: %2").arg(sensor.label.toString(), value));
+    }
+}
 
-    // KernelTime 包含 IdleTime，所以總系統時間 = Kernel + User
-    unsigned long long totalSys = kernelDiff + userDiff;
+void CpuWidget::updateTopProcesses(const ProcessTopSample &processes) {
+    if ((int)m_processLabels.size() != m_topProcessCount) {
+        for (QLabel *lbl : m_processLabels) delete lbl;
+        m_processLabels.assign(m_topProcessCount, nullptr);
 
-    double cpuPercent = 0.0;
-    if (totalSys > 0) {
-        // (Total - Idle) / Total
-        cpuPercent = (double)(totalSys - idleDiff) * 100.0 / totalSys;
+        for (int i = 0; i < m_topProcessCount; ++i) {
+            QLabel *lbl = new QLabel("--", m_processesContainer);
+            lbl->setStyleSheet("font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 10px;");
+            lbl->setToolTip("點選以展開執行緒");
+            lbl->setCursor(Qt::PointingHandCursor);
+            lbl->installEventFilter(this);
+            m_processesLayout->addWidget(lbl);
+            m_processLabels[i] = lbl;
+        }
+        this->adjustSize();
     }
 
-    // 儲存目前時間供下次計算
-    m_preIdleTime = idleTime;
-    m_preKernelTime = kernelTime;
-    m_preUserTime = userTime;
+    if (!processes.valid) {
+        for (QLabel *lbl : m_processLabels) {
+            lbl->setText("--");
+            lbl->setProperty("pid", 0);
+        }
+        return;
+    }
 
-    // 限制範圍 0-100
-    if (cpuPercent < 0) cpuPercent = 0;
-    if (cpuPercent > 100) cpuPercent = 100;
+    qCDebug(lcScan) << "process scan" << processes.scanMicros << "us for" << processes.processCount << "processes";
 
-    return cpuPercent;
+    for (int i = 0; i < m_topProcessCount; ++i) {
+        if (i >= processes.count) {
+            m_processLabels[i]->setText("--");
+            m_processLabels[i]->setProperty("pid", 0);
+            continue;
+        }
+        const ProcessSample &process = processes.top[i];
+        m_processLabels[i]->setProperty("pid", process.pid); // 點選時展開該行程的執行緒
+        m_processLabels[i]->setText(QString("%1 (%2): %3%  %4 MB")
+                                        .arg(process.name.toString())
+                                        .arg(process.pid)
+                                        .arg(QString::number(process.cpuPercent, 'f', 1))
+                                        .arg(QString::number(process.rssBytes / (1024.0 * 1024.0), 'f', 0)));
+    }
 }
 
-int CpuWidget::getMemoryUsage() {
-    MEMORYSTATUSEX memInfo;
-    memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-    if (GlobalMemoryStatusEx(&memInfo)) {
-        return (int)memInfo.dwMemoryLoad;
+void CpuWidget::updateMemoryTop(const MemoryTopSample &memoryTop) {
+    if ((int)m_memoryTopLabels.size() != m_topProcessCount) {
+        for (QLabel *lbl : m_memoryTopLabels) delete lbl;
+        m_memoryTopLabels.assign(m_topProcessCount, nullptr);
+
+        for (int i = 0; i < m_topProcessCount; ++i) {
+            QLabel *lbl = new QLabel("--", m_memoryTopContainer);
+            lbl->setStyleSheet("font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 10px;");
+            lbl->setToolTip("點選以展開執行緒");
+            lbl->setCursor(Qt::PointingHandCursor);
+            lbl->installEventFilter(this);
+            m_memoryTopLayout->addWidget(lbl);
+            m_memoryTopLabels[i] = lbl;
+        }
+        this->adjustSize();
+    }
+
+    if (!memoryTop.valid) {
+        m_memoryTopLabel->setText("PSS: N/A");
+        for (QLabel *lbl : m_memoryTopLabels) {
+            lbl->setText("--");
+            lbl->setProperty("pid", 0);
+        }
+        return;
+    }
+
+    qCDebug(lcScan) << "smaps_rollup scan" << memoryTop.scanMicros << "us," << memoryTop.readCount << "read,"
+                    << memoryTop.pendingCount << "deferred";
+
+    // 無法讀取的行程 (其他使用者) 不在合計內，第一次掃描超出時間預算時會分數輪完成
+    auto mb = [](quint64 bytes) { return QString::number(bytes / (1024.0 * 1024.0), 'f', 0); };
+    QString summary = QString("PSS %1 MB  swap %2 MB (%3 / %4 processes")
+                          .arg(mb(memoryTop.totalPssBytes), mb(memoryTop.totalSwapBytes))
+                          .arg(memoryTop.measuredCount)
+                          .arg(memoryTop.processCount);
+    if (memoryTop.deniedCount > 0) summary += QString(", %1 denied").arg(memoryTop.deniedCount);
+    if (memoryTop.pendingCount > 0) summary += QString(", %1 queued").arg(memoryTop.pendingCount);
+    m_memoryTopLabel->setText(summary + ")");
+
+    for (int i = 0; i < m_topProcessCount; ++i) {
+        if (i >= memoryTop.count) {
+            m_memoryTopLabels[i]->setText("--");
+            m_memoryTopLabels[i]->setProperty("pid", 0);
+            continue;
+        }
+        const MemoryProcessSample &process = memoryTop.top[i];
+        m_memoryTopLabels[i]->setProperty("pid", process.pid);
+        m_memoryTopLabels[i]->setText(QString("%1 (%2): PSS %3 MB  swap %4 MB  RSS %5 MB")
+                                          .arg(process.name.toString())
+                                          .arg(process.pid)
+                                          .arg(mb(process.pssBytes), mb(process.swapBytes), mb(process.rssBytes)));
     }
-    return 0;
 }
 
-void CpuWidget::initPdh() {
-    PDH_STATUS status = PdhOpenQuery(NULL, 0, &m_pdhQuery);
-    if (status != ERROR_SUCCESS) {
-        qWarning() << "PdhOpenQuery failed:" << status;
+void CpuWidget::updateCgroups(const CgroupTopSample &cgroups) {
+    if ((int)m_cgroupLabels.size() != m_cgroupCount) {
+        for (QLabel *lbl : m_cgroupLabels) delete lbl;
+        m_cgroupLabels.assign(m_cgroupCount, nullptr);
+
+        for (int i = 0; i < m_cgroupCount; ++i) {
+            QLabel *lbl = new QLabel("--", m_cgroupsContainer);
+            lbl->setStyleSheet("font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 10px;");
+            m_cgroupsLayout->addWidget(lbl);
+            m_cgroupLabels[i] = lbl;
+        }
+        this->adjustSize();
+    }
+
+    if (!cgroups.valid) {
+        for (QLabel *lbl : m_cgroupLabels) lbl->setText("--");
         return;
     }
 
-    // 取得邏輯核心數
-    int coreCount = QThread::idealThreadCount();
-    m_coreCounters.resize(coreCount);
-    m_coreLabels.resize(coreCount);
+    qCDebug(lcScan) << "cgroup scan" << cgroups.scanMicros << "us for" << cgroups.populatedCount << "of"
+                    << cgroups.cgroupCount << "cgroups";
 
-    for (int i = 0; i < coreCount; ++i) {
-        // 建立計數器路徑: \Processor(i)\% Processor Time
-        QString path = QString("\\Processor(%1)\\% Processor Time").arg(i);
-        status = PdhAddCounter(m_pdhQuery, path.toStdWString().c_str(), 0, &m_coreCounters[i]);
-        if (status != ERROR_SUCCESS) {
-            qWarning() << "PdhAddCounter failed for core" << i << ":" << status;
+    auto mb = [](quint64 bytes) { return QString::number(bytes / (1024.0 * 1024.0), 'f', 0); };
+    for (int i = 0; i < m_cgroupCount; ++i) {
+        if (i >= cgroups.count) {
+            m_cgroupLabels[i]->setText("--");
+            continue;
         }
+        const CgroupSample &cgroup = cgroups.top[i];
+        m_cgroupLabels[i]->setText(QString("%1: %2%  %3 MB (anon %4 / file %5)  io %6 KB/s")
+                                       .arg(cgroup.path.toString())
+                                       .arg(QString::number(cgroup.cpuPercent, 'f', 1))
+                                       .arg(mb(cgroup.memoryBytes), mb(cgroup.anonBytes), mb(cgroup.fileBytes))
+                                       .arg(QString::number(cgroup.ioBytesPerSec / 1024.0, 'f', 0)));
+    }
+}
 
-        // 預先建立 Label
-        QLabel *lbl = new QLabel(QString("Core %1: --%").arg(i), m_coresContainer);
-        lbl->setStyleSheet("font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 10px;");
-        m_coresLayout->addWidget(lbl);
-        m_coreLabels[i] = lbl;
+void CpuWidget::updateInterrupts(const SystemSnapshot &snap) {
+    if ((int)m_irqLabels.size() != m_topIrqCount) {
+        for (QLabel *lbl : m_irqLabels) delete lbl;
+        m_irqLabels.assign(m_topIrqCount, nullptr);
+
+        for (int i = 0; i < m_topIrqCount; ++i) {
+            QLabel *lbl = new QLabel("--", m_irqContainer);
+            lbl->setStyleSheet("font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 10px;");
+            m_irqLayout->addWidget(lbl);
+            m_irqLabels[i] = lbl;
+        }
+        this->adjustSize();
+    }
+
+    const CpuSample &cpu = snap.cpu;
+    const InterruptSample &irq = snap.interrupts;
+    QStringList lines;
+    lines << QString("ctxt %1/s  fork %2/s  irq %3/s  softirq %4/s")
+                 .arg(cpu.hasActivity ? formatRate(cpu.contextSwitchesPerSec) : "--")
+                 .arg(cpu.hasActivity ? formatRate(cpu.forksPerSec) : "--")
+                 .arg(irq.valid ? formatRate(irq.totalIrqPerSec) : "--")
+                 .arg(irq.valid ? formatRate(irq.totalSoftirqPerSec) : "--");
+
+    if (!irq.valid) {
+        m_interruptsLabel->setText(lines.join('\n'));
+        for (QLabel *lbl : m_irqLabels) lbl->setText("--");
+        return;
     }
-    
-    // 第一次收集數據 (通常第一次會失敗或無數據)
-    PdhCollectQueryData(m_pdhQuery);
-
-    // --- 初始化頻率查詢 (Processor Performance) ---
-    status = PdhOpenQuery(NULL, 0, &m_pdhFreqQuery);
-    if (status == ERROR_SUCCESS) {
-        m_freqCounters.resize(coreCount);
-        for (int i = 0; i < coreCount; ++i) {
-            // 嘗試使用 "\Processor Information(0,i)\% Processor Performance" (假設單插槽系統)
-            // 格式: \Processor Information(NUMA,Index)\% Processor Performance
-            QString path = QString("\\Processor Information(0,%1)\\% Processor Performance").arg(i);
-            status = PdhAddCounter(m_pdhFreqQuery, path.toStdWString().c_str(), 0, &m_freqCounters[i]);
-            
-            if (status != ERROR_SUCCESS) {
-                 // Fallback: 嘗試舊版 "\Processor Performance(i)\% Processor Performance"
-                 path = QString("\\Processor Performance(%1)\\% Processor Performance").arg(i);
-                 status = PdhAddCounter(m_pdhFreqQuery, path.toStdWString().c_str(), 0, &m_freqCounters[i]);
-                 if (status != ERROR_SUCCESS) {
-                     qWarning() << "Failed to add freq counter for core" << i;
-                     m_freqCounters[i] = NULL;
-                 }
-            }
+
+    qCDebug(lcScan) << "interrupt scan" << irq.scanMicros << "us for" << irq.irqSourceCount << "sources";
+
+    // softirq 依種類 (只列出有發生的)
+    QStringList softirqs;
+    for (int i = 0; i < irq.softirqTypeCount; ++i) {
+        if (irq.softirqTypePerSec[i] < 1.0) continue;
+        softirqs << QString("%1 %2").arg(irq.softirqNames[i].toString(), formatRate(irq.softirqTypePerSec[i]));
+    }
+    if (!softirqs.isEmpty()) lines << "softirq: " + softirqs.join("  ");
+
+    // 各 CPU：核心數多時只列出中斷最多的幾顆，中斷風暴通常集中在少數 CPU
+    constexpr int kShownCpus = 8;
+    QVector<int> cpus;
+    for (int i = 0; i < irq.cpuCount; ++i) {
+        if (irq.irqPerSec[i] + irq.softirqPerSec[i] > 0.0f) cpus.append(i);
+    }
+    const int shown = qMin<int>(cpus.size(), kShownCpus);
+    std::partial_sort(cpus.begin(), cpus.begin() + shown, cpus.end(), [&irq](int a, int b) {
+        return irq.irqPerSec[a] + irq.softirqPerSec[a] > irq.irqPerSec[b] + irq.softirqPerSec[b];
+    });
+    for (int i = 0; i < shown; i += 4) {
+        QStringList row;
+        for (int j = i; j < qMin(i + 4, shown); ++j) {
+            row << QString("CPU%1 %2/%3").arg(cpus[j]).arg(formatRate(irq.irqPerSec[cpus[j]]), formatRate(irq.softirqPerSec[cpus[j]]));
         }
-        PdhCollectQueryData(m_pdhFreqQuery);
+        lines << row.join("  ");
     }
+    m_interruptsLabel->setText(lines.join('\n'));
 
-    // --- 初始化溫度查詢 (Thermal Zone) ---
-    // 注意：這在許多系統上可能無效，因為需要 ACPI 驅動支援
+    for (int i = 0; i < m_topIrqCount; ++i) {
+        if (i >= irq.topCount) {
+            m_irqLabels[i]->setText("--");
+            continue;
+        }
+        const IrqSample &source = irq.top[i];
+        m_irqLabels[i]->setText(QString("%1: %2/s").arg(source.name.toString(), formatRate(source.perSec)));
+    }
+}
 
+QString CpuWidget::formatPressure(const QString &name, const PressureSample &pressure) {
+    if (!pressure.valid) return QString("PSI %1: N/A").arg(name);
+
+    // avg10 / avg60，以及本次取樣期間新增的停滯時間
+    QString text = QString("PSI %1: some %2% / %3%")
+                       .arg(name)
+                       .arg(QString::number(pressure.someAvg10, 'f', 2))
+                       .arg(QString::number(pressure.someAvg60, 'f', 2));
+    if (pressure.hasFull) {
+        text += QString("  full %1% / %2%")
+                    .arg(QString::number(pressure.fullAvg10, 'f', 2))
+                    .arg(QString::number(pressure.fullAvg60, 'f', 2));
+    }
+    text += QString("  +%1 ms").arg(QString::number(pressure.someDeltaUs / 1000.0, 'f', 1));
+    return text;
 }
 
-QString CpuWidget::updateCoreUsage() {
-    if (!m_pdhQuery) return "";
+QString CpuWidget::formatMemoryBreakdown(const MemorySample &mem) {
+    auto mb = [](quint64 bytes) { return QString::number(bytes / (1024.0 * 1024.0), 'f', 0); };
 
-    // 1. 取得 CPU 使用率 (PDH)
-    PDH_STATUS status = PdhCollectQueryData(m_pdhQuery);
-    if (status != ERROR_SUCCESS) return "";
+    QStringList lines;
+    lines << QString("Avail %1  Cached %2  Buffers %3 MB")
+                 .arg(mb(mem.availableBytes), mb(mem.cachedBytes), mb(mem.buffersBytes));
+    lines << QString("Dirty %1  Writeback %2  Slab %3  Shmem %4 MB")
+                 .arg(mb(mem.dirtyBytes), mb(mem.writebackBytes), mb(mem.slabBytes), mb(mem.shmemBytes));
 
-    // 2. 取得 CPU 基礎頻率 (CallNtPowerInformation)
-    int coreCount = m_coreCounters.size();
-    std::vector<PROCESSOR_POWER_INFORMATION> ppi(coreCount);
-    long pwrStatus = CallNtPowerInformation(ProcessorInformation, NULL, 0, &ppi[0], coreCount * sizeof(PROCESSOR_POWER_INFORMATION));
-    
-    // 3. 收集頻率效能數據
-    if (m_pdhFreqQuery) {
-        PdhCollectQueryData(m_pdhFreqQuery);
+    QString swap = mem.swapTotalBytes > 0
+        ? QString("Swap %1 / %2 MB").arg(mb(mem.swapUsedBytes), mb(mem.swapTotalBytes))
+        : QString("Swap: off");
+    // 壓縮 swap：顯示原始資料量與實際佔用的記憶體
+    if (mem.zswappedBytes > 0) swap += QString("  zswap %1 -> %2 MB").arg(mb(mem.zswappedBytes), mb(mem.zswapBytes));
+    if (mem.zramDataBytes > 0) swap += QString("  zram %1 -> %2 MB").arg(mb(mem.zramDataBytes), mb(mem.zramBytes));
+    lines << swap;
+
+    // 主要分頁錯誤與 swap in/out 持續偏高代表記憶體不足，而不只是快取用量大
+    if (mem.hasVmstat) {
+        lines << QString("Faults %1/s (major %2/s)  Swap in %3/s  out %4/s")
+                     .arg(QString::number(mem.pageFaultsPerSec, 'f', 0))
+                     .arg(QString::number(mem.majorFaultsPerSec, 'f', 0))
+                     .arg(QString::number(mem.swapInPerSec, 'f', 0))
+                     .arg(QString::number(mem.swapOutPerSec, 'f', 0));
+    }
+    return lines.join('\n');
+}
+
+QString CpuWidget::formatMhz(double mhz) {
+    if (mhz <= 0) {
+        return "N/A"; // 無法取得頻率 (例如離線核心或沒有 cpufreq 的虛擬機)
+    }
+    if (mhz >= 1000) {
+        return QString("%1 GHz").arg(QString::number(mhz / 1000.0, 'f', 2));
+    }
+    return QString("%1 MHz").arg(QString::number(mhz, 'f', 0));
+}
+
+QString CpuWidget::updateCoreUsage(const CpuSample &cpu) {
+    const int coreCount = cpu.coreCount;
+    if (coreCount == 0) return "";
+
+    if (m_groupTopology) updateTopology(cpu.topology);
+
+    // 核心列表只在顯示時建立標籤；熱圖模式一次更新整個陣列
+    const bool showList = m_showCores && !m_coreHeatmap;
+    const bool grouped = m_groupTopology && cpu.topology.valid;
+    if (showList) ensureCoreLabels(grouped ? cpu.topology.coreCount : coreCount);
+    if (m_showCores && m_coreHeatmap) {
+        // 降頻標記與列表模式相同，只在啟用降頻顯示時加上
+        m_coresHeatmap->setCores(cpu.coreUsage, cpu.coreMhz, coreCount, m_throttle ? m_throttle->coreEvents : nullptr);
     }
 
     double maxFreq = 0.0;
@@ -297,36 +838,8 @@ QString CpuWidget::updateCoreUsage() {
     int validCoreCount = 0;
 
     for (int i = 0; i < coreCount; ++i) {
-        // --- A. 取得使用率 ---
-        PDH_FMT_COUNTERVALUE value;
-        status = PdhGetFormattedCounterValue(m_coreCounters[i], PDH_FMT_DOUBLE, NULL, &value);
-        
-        double usage = 0.0;
-        if (status == ERROR_SUCCESS) {
-            usage = value.doubleValue;
-        }
-
-        // --- B. 計算個別核心頻率 ---
-        double currentRealMhz = 0.0;
-        double baseMhz = 0.0;
-        
-        // 取得該核心的基礎頻率
-        if (pwrStatus == 0) {
-            baseMhz = ppi[i].MaxMhz;
-        }
-
-        // 取得該核心的效能百分比
-        double perfPercent = 100.0;
-        if (m_pdhFreqQuery && i < m_freqCounters.size() && m_freqCounters[i]) {
-            PDH_FMT_COUNTERVALUE freqVal;
-            if (PdhGetFormattedCounterValue(m_freqCounters[i], PDH_FMT_DOUBLE, NULL, &freqVal) == ERROR_SUCCESS) {
-                perfPercent = freqVal.doubleValue;
-            }
-        }
+        double currentRealMhz = cpu.coreMhz[i];
 
-        // 計算真實頻率
-        currentRealMhz = baseMhz * (perfPercent / 100.0);
-        
         // 統計數據
         if (currentRealMhz > maxFreq) {
             maxFreq = currentRealMhz;
@@ -336,22 +849,25 @@ QString CpuWidget::updateCoreUsage() {
             validCoreCount++;
         }
 
-        // 僅更新使用率文字，不顯示頻率
-        QString coreText = QString("Core %1: %2%").arg(i).arg(QString::number(usage, 'f', 1));
-        
+        // 核心列表隱藏 (或改用熱圖、依拓撲分組) 時不必逐一更新文字
+        if (!showList || grouped) continue;
+
+        QString coreText = QString("Core %1: %2%").arg(i).arg(QString::number(cpu.coreUsage[i], 'f', 1));
+
         // 若啟用個別核心頻率顯示
         if (m_showCoreFreq) {
-            QString coreFreqStr;
-            if (currentRealMhz >= 1000) {
-                coreFreqStr = QString("%1 GHz").arg(QString::number(currentRealMhz / 1000.0, 'f', 2));
-            } else {
-                coreFreqStr = QString("%1 MHz").arg(QString::number(currentRealMhz, 'f', 0));
-            }
-            coreText += QString(" @ %1").arg(coreFreqStr);
+            coreText += QString(" @ %1").arg(formatMhz(currentRealMhz));
+        }
+        if (m_sched && i < m_sched->cpuCount) {
+            coreText += QString("  wait %1 ms/s").arg(QString::number(m_sched->runDelayMsPerSec[i], 'f', 0));
+        }
+        if (m_throttle && i < m_throttle->coreCount && m_throttle->coreEvents[i] > 0) {
+            coreText += QString("  THROTTLED x%1").arg(m_throttle->coreEvents[i]);
         }
-        
+
         m_coreLabels[i]->setText(coreText);
     }
+    if (showList && grouped) updateGroupedCores(cpu);
 
     // 根據模式決定顯示數值
     double displayFreq = 0.0;
@@ -362,12 +878,325 @@ QString CpuWidget::updateCoreUsage() {
     }
 
     // 回傳頻率字串
-    QString freqStr;
-    if (displayFreq >= 1000) {
-        freqStr = QString("%1 GHz").arg(QString::number(displayFreq / 1000.0, 'f', 2));
+    return formatMhz(displayFreq);
+}
+
+void CpuWidget::updateSched(const SystemSnapshot &snap) {
+    const SchedSample &sched = snap.sched;
+    if (!sched.valid) {
+        m_schedLabel->setText("load: N/A");
+        return;
+    }
+
+    QStringList lines;
+    QString load = QString("load %1 %2 %3")
+                       .arg(QString::number(sched.load1, 'f', 2))
+                       .arg(QString::number(sched.load5, 'f', 2))
+                       .arg(QString::number(sched.load15, 'f', 2));
+    if (snap.cpu.hasActivity) {
+        load += QString("  running %1  blocked %2").arg(snap.cpu.procsRunning).arg(snap.cpu.procsBlocked);
+    }
+    load += QString("  (%1/%2 tasks)").arg(sched.runnable).arg(sched.threads);
+    lines << load;
+
+    if (!sched.hasRunDelay) {
+        lines << "run-queue wait: N/A";
+        m_schedLabel->setText(lines.join('\n'));
+        return;
+    }
+
+    // 平均每個 CPU 每秒都有超過 1 秒的等待，代表同時可執行的工作多於 CPU
+    QString wait = QString("run-queue wait %1 ms/s per CPU").arg(QString::number(sched.avgRunDelayMsPerSec, 'f', 0));
+    if (sched.avgRunDelayMsPerSec >= 1000.0f) wait += "  [oversubscribed]";
+    lines << wait;
+
+    // 等待最久的幾個 CPU：負載不平均 (例如 IRQ 或 cpuset 綁定) 時只有少數 CPU 排隊
+    constexpr int kShownCpus = 4;
+    QVector<int> cpus;
+    for (int i = 0; i < sched.cpuCount; ++i) {
+        if (sched.runDelayMsPerSec[i] >= 1.0f) cpus.append(i);
+    }
+    const int shown = qMin<int>(cpus.size(), kShownCpus);
+    std::partial_sort(cpus.begin(), cpus.begin() + shown, cpus.end(), [&sched](int a, int b) {
+        return sched.runDelayMsPerSec[a] > sched.runDelayMsPerSec[b];
+    });
+    QStringList busiest;
+    for (int i = 0; i < shown; ++i) {
+        busiest << QString("CPU%1 %2").arg(cpus[i]).arg(QString::number(sched.runDelayMsPerSec[cpus[i]], 'f', 0));
+    }
+    if (!busiest.isEmpty()) lines << busiest.join("  ");
+    m_schedLabel->setText(lines.join('\n'));
+}
+
+void CpuWidget::updateCpuIdle(const CpuIdleSample &idle) {
+    if (idle.hasCurrentState) {
+        // Windows：只有瞬間的 idle state (0 代表 C0)
+        // 依狀態統計 CPU 數，行數不隨核心數增加
+        int counts[256] = {};
+        for (int i = 0; i < idle.coreCount; ++i) ++counts[idle.currentState[i]];
+        QStringList parts;
+        for (int state = 0; state < 256; ++state) {
+            if (counts[state] > 0) parts << QString("C%1 x%2").arg(state).arg(counts[state]);
+        }
+        m_idleLabel->setText(QString("C-state now (max C%1): %2").arg(idle.maxState).arg(parts.join("  ")));
+        return;
+    }
+    if (!idle.valid) {
+        m_idleLabel->setText("C-state: N/A");
+        return;
+    }
+
+    qCDebug(lcScan) << "cpuidle scan" << idle.scanMicros << "us for" << idle.coreCount << "cores x" << idle.stateCount
+                    << "states";
+
+    // C0 = 不在任何 idle state 的時間 (執行工作，或 idle=poll 時忙碌輪詢)
+    auto formatStates = [&idle](const float *residency) {
+        float idleSum = 0.0f;
+        for (int i = 0; i < idle.stateCount; ++i) idleSum += residency[i];
+        QStringList parts;
+        parts << QString("C0 %1").arg(QString::number(qMax(0.0f, 100.0f - idleSum), 'f', 0));
+        for (int i = 0; i < idle.stateCount; ++i) {
+            parts << QString("%1 %2").arg(idle.stateNames[i].toString(), QString::number(residency[i], 'f', 0));
+        }
+        return parts.join("  ");
+    };
+
+    double wakeups = 0.0;
+    for (int i = 0; i < idle.coreCount; ++i) wakeups += idle.wakeupsPerSec[i];
+
+    QStringList lines;
+    lines << QString("C-state %: %1  (wakeups %2/s)").arg(formatStates(idle.avgResidency), formatRate(wakeups));
+
+    // 只列出與平均差異最大的幾個 CPU (各狀態差值的絕對值合計)，256 CPU 的主機也維持固定行數：
+    // 例如被 IRQ 或綁定工作占住而無法進入深層 C-state 的 CPU
+    constexpr int kShownCpus = 4;
+    constexpr float kMinDeviation = 10.0f;
+    QVector<int> cpus;
+    QVector<float> deviation(idle.coreCount, 0.0f);
+    for (int i = 0; i < idle.coreCount; ++i) {
+        for (int j = 0; j < idle.stateCount; ++j) deviation[i] += qAbs(idle.residency[i][j] - idle.avgResidency[j]);
+        if (deviation[i] >= kMinDeviation) cpus.append(i);
+    }
+    const int shown = qMin<int>(cpus.size(), kShownCpus);
+    std::partial_sort(cpus.begin(), cpus.begin() + shown, cpus.end(),
+                      [&deviation](int a, int b) { return deviation[a] > deviation[b]; });
+    for (int i = 0; i < shown; ++i) {
+        lines << QString("CPU%1  %2  (%3/s)")
+                     .arg(cpus[i])
+                     .arg(formatStates(idle.residency[cpus[i]]), formatRate(idle.wakeupsPerSec[cpus[i]]));
+    }
+    if (cpus.size() > shown) lines << QString("+%1 more CPUs differ from the average").arg(cpus.size() - shown);
+    m_idleLabel->setText(lines.join('\n'));
+}
+
+void CpuWidget::updateFreqResidency(const FreqResidencySample &freq) {
+    m_freqStrip->setSample(freq);
+    if (!freq.valid) {
+        // 尚無第二次取樣，或驅動 (例如 intel_pstate) 不提供 time_in_state
+        m_freqResidencyLabel->setText(freq.policyCount > 0 ? "Freq residency: --" : "Freq residency: N/A");
+        return;
+    }
+
+    // 各 policy 停留在最高檔位的比例：boost 能否持續的摘要
+    double topShare = 0.0;
+    int counted = 0;
+    for (int i = 0; i < freq.policyCount; ++i) {
+        const FreqPolicySample &policy = freq.policies[i];
+        if (policy.stepCount == 0) continue;
+        topShare += policy.residency[policy.stepCount - 1];
+        ++counted;
+    }
+    m_freqResidencyLabel->setText(QString("Freq residency (%1 s): top step %2%")
+                                      .arg(QString::number(freq.coveredSec, 'f', 0))
+                                      .arg(QString::number(counted > 0 ? topShare / counted : 0.0, 'f', 0)));
+}
+
+void CpuWidget::updatePower(const SystemSnapshot &snap) {
+    const PowerSample &power = snap.power;
+    if (power.zoneCount == 0) {
+        m_powerLabel->setText(power.permissionDenied ? "Power: energy_uj not readable (root only)" : "Power: N/A (no RAPL)");
+        return;
+    }
+    if (!power.valid) {
+        m_powerLabel->setText("Power: -- W");
+        return;
+    }
+
+    // 依種類合計 (多插槽時 core / dram 為各插槽之和)
+    float byKind[PowerZoneSample::Other + 1] = {};
+    int packages = 0;
+    for (int i = 0; i < power.zoneCount; ++i) {
+        const PowerZoneSample &zone = power.zones[i];
+        byKind[qMin<int>(zone.kind, PowerZoneSample::Other)] += zone.watts;
+        if (zone.kind == PowerZoneSample::Package) ++packages;
+    }
+
+    auto watts = [](float value) { return QString("%1 W").arg(QString::number(value, 'f', 1)); };
+    QStringList parts;
+    parts << "pkg " + watts(power.packageWatts);
+    if (byKind[PowerZoneSample::Core] > 0.0f) parts << "core " + watts(byKind[PowerZoneSample::Core]);
+    if (byKind[PowerZoneSample::Uncore] > 0.0f) parts << "uncore " + watts(byKind[PowerZoneSample::Uncore]);
+    if (byKind[PowerZoneSample::Dram] > 0.0f) parts << "dram " + watts(byKind[PowerZoneSample::Dram]);
+    if (byKind[PowerZoneSample::Psys] > 0.0f) parts << "psys " + watts(byKind[PowerZoneSample::Psys]);
+
+    QStringList lines;
+    lines << "Power: " + parts.join("  ");
+    if (packages > 1) {
+        QStringList perPackage;
+        for (int i = 0; i < power.zoneCount; ++i) {
+            const PowerZoneSample &zone = power.zones[i];
+            if (zone.kind == PowerZoneSample::Package) perPackage << zone.name.toString() + " " + watts(zone.watts);
+        }
+        lines << perPackage.join("  ");
+    }
+    // 每瓦的 CPU 使用率：相同工作量下越高越省電
+    if (snap.cpu.valid && power.packageWatts > 0.1f) {
+        lines << QString("CPU %1% / %2 = %3 %/W")
+                     .arg(QString::number(snap.cpu.totalUsage, 'f', 0), watts(power.packageWatts),
+                          QString::number(snap.cpu.totalUsage / power.packageWatts, 'f', 2));
+    }
+    m_powerLabel->setText(lines.join('\n'));
+}
+
+void CpuWidget::updateThrottle(const ThrottleSample &throttle) {
+    if (throttle.coreCount == 0) {
+        // 虛擬機與非 x86 平台沒有 thermal_throttle
+        m_throttleLabel->setText("Throttle: N/A");
+        return;
+    }
+    if (!throttle.valid) {
+        m_throttleLabel->setText("Throttle: --");
+        return;
+    }
+
+    QStringList lines;
+    quint32 packageEvents = 0;
+    QStringList packages;
+    for (int i = 0; i < throttle.packageCount; ++i) {
+        packageEvents += throttle.packageEvents[i];
+        if (throttle.packageEvents[i] > 0) {
+            packages << QString("pkg%1 x%2 (%3 ms)").arg(throttle.packageIds[i]).arg(throttle.packageEvents[i])
+                            .arg(throttle.packageThrottleMs[i]);
+        }
+    }
+
+    if (throttle.throttledCores == 0 && packageEvents == 0) {
+        lines << "Throttle: none";
     } else {
-        freqStr = QString("%1 MHz").arg(QString::number(displayFreq, 'f', 0));
+        QString line = QString("Throttle: %1 core(s)").arg(throttle.throttledCores);
+        if (!packages.isEmpty()) line += "  " + packages.join("  ");
+        lines << line;
+
+        // 事件最多的幾個核心
+        constexpr int kShownCpus = 8;
+        QVector<int> cpus;
+        for (int i = 0; i < throttle.coreCount; ++i) {
+            if (throttle.coreEvents[i] > 0) cpus.append(i);
+        }
+        const int shown = qMin<int>(cpus.size(), kShownCpus);
+        std::partial_sort(cpus.begin(), cpus.begin() + shown, cpus.end(), [&throttle](int a, int b) {
+            return throttle.coreEvents[a] > throttle.coreEvents[b];
+        });
+        QStringList row;
+        for (int i = 0; i < shown; ++i) {
+            row << QString("CPU%1 x%2 (%3 ms)").arg(cpus[i]).arg(throttle.coreEvents[cpus[i]]).arg(throttle.coreThrottleMs[cpus[i]]);
+        }
+        if (!row.isEmpty()) lines << row.join("  ");
+    }
+    lines << QString("since boot: core %1  package %2").arg(throttle.totalCoreEvents).arg(throttle.totalPackageEvents);
+    m_throttleLabel->setText(lines.join('\n'));
+}
+
+void CpuWidget::setDrillDown(int pid) {
+    if (pid == m_drillPid) return;
+    m_drillPid = pid;
+    // 只在展開時掃描該行程的 task 目錄
+    SystemCollector::instance()->setThreadTarget(pid);
+    SystemCollector::instance()->setEnabled(this, SystemCollector::Threads, pid > 0);
+    m_threadsLabel->setText(pid > 0 ? QString("threads of %1: --").arg(pid) : QString());
+    m_threadsLabel->setVisible(pid > 0);
+    this->adjustSize();
+}
+
+void CpuWidget::updateThreads(const ThreadTopSample &threads) {
+    // 收集執行緒可能還在使用前一個 pid 的快照
+    if (threads.pid != m_drillPid) return;
+    if (threads.exited) {
+        m_threadsLabel->setText(QString("process %1 exited (click to close)").arg(m_drillPid));
+        return;
+    }
+    if (!threads.valid) return;
+
+    qCDebug(lcScan) << "thread scan" << threads.scanMicros << "us for" << threads.threadCount << "threads";
+
+    constexpr int kShownThreads = 10;
+    QStringList lines;
+    lines << QString("%1 (%2): %3 threads").arg(threads.processName.toString()).arg(threads.pid).arg(threads.threadCount);
+    for (int i = 0; i < qMin(threads.count, kShownThreads); ++i) {
+        const ThreadSample &thread = threads.top[i];
+        QString line = QString("%1 %2: %3%  %4  CPU%5")
+                           .arg(thread.tid)
+                           .arg(thread.name.toString())
+                           .arg(QString::number(thread.cpuPercent, 'f', 1))
+                           .arg(QChar(thread.state))
+                           .arg(thread.lastCpu);
+        if (thread.runDelayMsPerSec >= 0.0f) {
+            line += QString("  wait %1 ms/s").arg(QString::number(thread.runDelayMsPerSec, 'f', 1));
+        }
+        lines << line;
+    }
+    m_threadsLabel->setText(lines.join('\n'));
+}
+
+QString CpuWidget::formatGroup(const QString &name, const CpuGroupSample &group) {
+    return QString("%1: %2% @ %3 (%4C/%5T)")
+        .arg(name)
+        .arg(QString::number(group.usage, 'f', 1))
+        .arg(formatMhz(group.mhz))
+        .arg(group.cores)
+        .arg(group.threads);
+}
+
+void CpuWidget::updateTopology(const CpuTopologySample &topology) {
+    if (!topology.valid) {
+        m_topologyLabel->setText("Topology: N/A");
+        return;
+    }
+
+    QStringList lines;
+    for (int i = 0; i < topology.packageCount; ++i) {
+        lines << formatGroup(QString("Socket %1").arg(i), topology.packages[i]);
+    }
+    // 混合架構：P-core 與 E-core 分開顯示，E-core 滿載時整體使用率容易被 P-core 稀釋
+    if (topology.hybrid) {
+        lines << formatGroup("P-cores", topology.types[CpuTopologySample::Performance]);
+        lines << formatGroup("E-cores", topology.types[CpuTopologySample::Efficiency]);
+    }
+    m_topologyLabel->setText(lines.join('\n'));
+}
+
+void CpuWidget::updateGroupedCores(const CpuSample &cpu) {
+    const CpuTopologySample &topology = cpu.topology;
+
+    // 依 threadCore 走訪一次，收集每個實體核心的 SMT 執行緒使用率
+    QVector<QStringList> threads(topology.coreCount);
+    QVector<quint32> throttleEvents(topology.coreCount, 0);
+    for (int i = 0; i < cpu.coreCount; ++i) {
+        const int core = topology.threadCore[i];
+        if (core < 0 || core >= topology.coreCount) continue;
+        threads[core] << QString::number(cpu.coreUsage[i], 'f', 0);
+        if (m_throttle && i < m_throttle->coreCount) throttleEvents[core] += m_throttle->coreEvents[i];
+    }
+
+    const int count = qMin<int>(topology.coreCount, int(m_coreLabels.size()));
+    for (int i = 0; i < count; ++i) {
+        const CpuGroupSample &core = topology.cores[i];
+        const char *type = !topology.hybrid ? "C" : (topology.coreType[i] == CpuTopologySample::Efficiency ? "E" : "P");
+        QString text = QString("S%1 %2%3: %4%").arg(topology.corePackage[i]).arg(type).arg(i)
+                           .arg(QString::number(core.usage, 'f', 1));
+        if (threads[i].size() > 1) text += QString(" (%1)").arg(threads[i].join('/'));
+        if (m_showCoreFreq) text += QString(" @ %1").arg(formatMhz(core.mhz));
+        if (throttleEvents[i] > 0) text += QString("  THROTTLED x%1").arg(throttleEvents[i]);
+        m_coreLabels[i]->setText(text);
     }
-    return freqStr;
 }
-#endif
@@ -2,17 +2,14 @@
 #define CPUWIDGET_H
 
 #include "Core/BaseComponent.h"
+#include "Core/SystemSnapshot.h"
+#include "SparklineGraph.h"
+#include "CoreHeatmap.h"
+#include "FreqResidencyStrip.h"
 #include <QLabel>
-#include <QTimer>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-
-#ifdef Q_OS_WIN
-#include <windows.h>
-#include <pdh.h>
-#include <powrprof.h>
 #include <vector>
-#endif
 
 class CpuWidget : public BaseComponent {
     Q_OBJECT
@@ -24,14 +21,38 @@ public:
     Q_ENUM(FrequencyMode)
 
     explicit CpuWidget(QWidget *parent = nullptr);
-    ~CpuWidget(); // Add destructor to close Pdh
 
     void initStyle() override;
     void updateData() override;
     void setCustomSetting(const QString &key, const QVariant &value) override;
-    void setUpdateInterval(int ms) override; // 新增
+    void setUpdateInterval(int ms) override; // 同步收集執行緒的取樣週期
 
     FrequencyMode frequencyMode() const { return m_freqMode; }
+    bool isShowGraph() const { return m_showGraph; }
+    bool isShowBreakdown() const { return m_showBreakdown; }
+    bool isCoreHeatmap() const { return m_coreHeatmap; }
+    bool isGroupTopology() const { return m_groupTopology; }
+    bool isShowSched() const { return m_showSched; }
+    bool isShowCpuIdle() const { return m_showCpuIdle; }
+    bool isShowFreqResidency() const { return m_showFreqResidency; }
+    int freqWindow() const { return m_freqWindow; }
+    bool isShowPower() const { return m_showPower; }
+    QString powercapRoot() const { return m_powercapRoot; }
+    bool isShowThrottle() const { return m_showThrottle; }
+    bool isShowSensors() const { return m_showSensors; }
+    bool isShowTopProcesses() const { return m_showTopProcesses; }
+    int topProcessCount() const { return m_topProcessCount; }
+    bool isShowMemoryTop() const { return m_showMemoryTop; }
+    bool isShowPressure() const { return m_showPressure; }
+    bool isShowCgroups() const { return m_showCgroups; }
+    QString cgroupRoot() const { return m_cgroupRoot; }
+    int cgroupSortBy() const { return m_cgroupSortBy; }
+    int cgroupCount() const { return m_cgroupCount; }
+    bool isShowInterrupts() const { return m_showInterrupts; }
+    int topIrqCount() const { return m_topIrqCount; }
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override; // 滑鼠停留時顯示歷史統計
 
 private:
     QLabel *m_titleLabel;
@@ -40,34 +61,93 @@ private:
     // QLabel *m_coreLabel; // Removed single label
     QWidget *m_coresContainer; // Container for core labels
     QVBoxLayout *m_coresLayout; // Layout for core labels
+    CoreHeatmap *m_coresHeatmap; // 核心熱圖 (取代核心列表，適合多核心主機)
+    QLabel *m_topologyLabel;    // 各插槽與 P/E 核心的彙總
+    QLabel *m_schedLabel;       // 負載與 run queue 等待時間
+    QLabel *m_idleLabel;        // 各核心 C-state 停留比例
+    QLabel *m_freqResidencyLabel;
+    FreqResidencyStrip *m_freqStrip; // 各 cpufreq policy 的頻率停留分佈
+    QLabel *m_powerLabel;       // RAPL 功耗與每瓦使用率
+    QLabel *m_throttleLabel;    // 過熱降頻事件
+    QLabel *m_threadsLabel;     // 點選行程後展開的執行緒排行
     QLabel *m_ramDetailLabel;
-    QTimer *m_updateTimer;
+    QLabel *m_memoryTopLabel;   // PSS 排行的彙總 (已量測行程數、合計)
+    QWidget *m_memoryTopContainer; // PSS 最高的行程
+    QVBoxLayout *m_memoryTopLayout;
+    SparklineGraph *m_cpuGraph; // CPU 使用率歷史曲線
+    QLabel *m_breakdownLabel;   // user/system/iowait/irq/steal 時間分類
+    QWidget *m_sensorsContainer; // 溫度與風扇
+    QVBoxLayout *m_sensorsLayout;
+    QWidget *m_processesContainer; // CPU 使用率前幾名的行程
+    QVBoxLayout *m_processesLayout;
+    QLabel *m_pressureLabel;    // PSI (cpu / memory)
+    QWidget *m_cgroupsContainer; // 用量最高的 cgroup (容器、systemd 服務)
+    QVBoxLayout *m_cgroupsLayout;
+    QLabel *m_interruptsLabel;  // context switch / fork / irq / softirq 速率與各 CPU 分佈
+    QWidget *m_irqContainer;    // 速率最高的中斷來源
+    QVBoxLayout *m_irqLayout;
 
     bool m_showCores = false;
     bool m_showRamDetail = false;
     bool m_showCoreFreq = false; // 新增：是否顯示個別核心頻率
+    bool m_coreHeatmap = false;  // 核心以熱圖顯示，不建立個別標籤
+    bool m_groupTopology = false; // 依插槽 -> 實體核心 -> SMT 執行緒分組
+    bool m_showSched = false;
+    bool m_showCpuIdle = false;
+    bool m_showFreqResidency = false;
+    int m_freqWindow = 60;       // 頻率停留分佈的時間窗 (秒)
+    bool m_showPower = false;
+    QString m_powercapRoot;      // 空字串代表 /sys/class/powercap
+    bool m_showThrottle = false;
+    const ThrottleSample *m_throttle = nullptr; // updateData 期間有效，核心列表標示降頻中的核心
+    int m_drillPid = 0;          // 展開執行緒的行程，0 代表未展開
+    const SchedSample *m_sched = nullptr; // updateData 期間有效，核心列表附加各 CPU 的等待時間
     FrequencyMode m_freqMode = FreqMax;
+    bool m_showGraph = false;
+    bool m_showBreakdown = false;
+    bool m_showSensors = false;
+    bool m_showTopProcesses = false;
+    int m_topProcessCount = 5;   // CPU 與記憶體排行共用
+    bool m_showMemoryTop = false;
+    bool m_showPressure = false;
+    bool m_showCgroups = false;
+    QString m_cgroupRoot;       // 相對於 cgroup2 掛載點的子樹，空字串代表整個階層
+    int m_cgroupSortBy = CgroupTopSample::ByCpu;
+    int m_cgroupCount = 5;
+    bool m_showInterrupts = false;
+    int m_topIrqCount = 5;
 
-    // Windows specific members for CPU calculation
-#ifdef Q_OS_WIN
-    FILETIME m_preIdleTime;
-    FILETIME m_preKernelTime;
-    FILETIME m_preUserTime;
-
-    // Pdh for per-core usage
-    PDH_HQUERY m_pdhQuery;
-    std::vector<PDH_HCOUNTER> m_coreCounters;
+    // 各核心標籤，依快照中的核心數量延遲建立
     std::vector<QLabel*> m_coreLabels;
-    
-    // Pdh for Processor Performance (Frequency)
-    PDH_HQUERY m_pdhFreqQuery;
-    std::vector<PDH_HCOUNTER> m_freqCounters;
+    // 各感測器標籤，感測器清單在收集執行緒第一次探索後固定
+    std::vector<QLabel*> m_sensorLabels;
+    std::vector<QLabel*> m_processLabels;
+    std::vector<QLabel*> m_memoryTopLabels;
+    std::vector<QLabel*> m_cgroupLabels;
+    std::vector<QLabel*> m_irqLabels;
 
-    double getCpuUsage();
-    int getMemoryUsage();
-    void initPdh();
-    QString updateCoreUsage(); // 修改回傳型別為 QString
-#endif
+    void ensureCoreLabels(int coreCount);
+    void updateCoreViews();     // 依 showCores / coreHeatmap 切換列表與熱圖
+    void updateSensors(const SystemSnapshot &snap);
+    void updateTopProcesses(const ProcessTopSample &processes);
+    void updateMemoryTop(const MemoryTopSample &memoryTop);
+    void updateCgroups(const CgroupTopSample &cgroups);
+    void updateInterrupts(const SystemSnapshot &snap);
+    QString updateCoreUsage(const CpuSample &cpu); // 回傳主標籤使用的頻率字串
+    void updateGroupedCores(const CpuSample &cpu);  // 核心列表改為每個實體核心一行
+    void updateTopology(const CpuTopologySample &topology);
+    void updateSched(const SystemSnapshot &snap);
+    void updateCpuIdle(const CpuIdleSample &idle);
+    void updateFreqResidency(const FreqResidencySample &freq);
+    void updatePower(const SystemSnapshot &snap);
+    void updateThrottle(const ThrottleSample &throttle);
+    void updateThreads(const ThreadTopSample &threads);
+    void setDrillDown(int pid);
+    static QString formatGroup(const QString &name, const CpuGroupSample &group);
+    static QString formatMhz(double mhz);
+    static QString formatMemoryBreakdown(const MemorySample &mem); // Linux /proc/meminfo 與 vmstat 詳細分類
+    static QString formatPressure(const QString &name, const PressureSample &pressure);
+    static QString historyTooltip(quint32 seriesKey, const QString &title, const QString &unit = "%");
 };
 
 #endif // CPUWIDGET_H
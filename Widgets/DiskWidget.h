@@ -2,25 +2,19 @@
 #define DISKWIDGET_H
 
 #include "Core/BaseComponent.h"
+#include "Core/SystemSnapshot.h"
+#include "SparklineGraph.h"
 #include <QLabel>
-#include <QTimer>
 #include <QVBoxLayout>
-#include <QStorageInfo>
 #include <QMap>
 #include <QProgressBar>
 #include <QDesktopServices>
 #include <QUrl>
 
-#ifdef Q_OS_WIN
-#include <windows.h>
-#include <pdh.h>
-#endif
-
 class DiskWidget : public BaseComponent {
     Q_OBJECT
 public:
     explicit DiskWidget(QWidget *parent = nullptr);
-    ~DiskWidget();
 
     void initStyle() override;
     void updateData() override;
@@ -30,6 +24,8 @@ public:
     bool isShowUsagePercent() const { return m_showUsagePercent; }
     bool isShowTransferSpeed() const { return m_showTransferSpeed; }
     bool isShowActiveTime() const { return m_showActiveTime; }
+    bool isShowGraph() const { return m_showGraph; }
+    bool isShowPressure() const { return m_showPressure; }
 
 protected:
     bool eventFilter(QObject *watched, QEvent *event) override;
@@ -38,11 +34,13 @@ private:
     QLabel *m_titleLabel;
     QWidget *m_diskContainer;
     QVBoxLayout *m_diskLayout;
-    QTimer *m_updateTimer;
+    QLabel *m_pressureLabel;         // I/O PSI
 
     bool m_showUsagePercent = false; // 空間使用率文字
     bool m_showTransferSpeed = false;
     bool m_showActiveTime = false;   // 新增：硬碟活動時間 (Active Time)
+    bool m_showGraph = false;        // 活動時間歷史曲線
+    bool m_showPressure = false;     // I/O 停滯 (PSI)
 
     // 用於快取每個硬碟的 UI 元件，避免每次重建
     struct DiskUI {
@@ -50,25 +48,15 @@ private:
         QProgressBar *usageBar;
         QLabel *detailLabel;
         QLabel *speedLabel; // 讀寫速度 + 活動時間
+        SparklineGraph *activityGraph; // 活動時間曲線
         QWidget *container;
     };
     
     // Key: Root Path (e.g., "C:/")
     QMap<QString, DiskUI> m_diskUIs;
 
-    void refreshDiskList();
-
-#ifdef Q_OS_WIN
-    PDH_HQUERY m_pdhDiskQuery = NULL;
-    // Key: Drive Letter (e.g., "C:") -> Counter
-    QMap<QString, PDH_HCOUNTER> m_readCounters;
-    QMap<QString, PDH_HCOUNTER> m_writeCounters;
-    QMap<QString, PDH_HCOUNTER> m_idleCounters; // 新增：用於計算 Active Time
-    
-    void initPdh();
-    void addDiskCounter(const QString &driveLetter);
-    void removeDiskCounter(const QString &driveLetter);
-#endif
+    DiskUI createDiskUI(int slot);
+    void updatePressure(const SystemSnapshot &snap);
 };
 
 #endif // DISKWIDGET_H
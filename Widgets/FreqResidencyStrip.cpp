@@ -0,0 +1,143 @@
+#include "FreqResidencyStrip.h"
+#include <QPainter>
+#include <QHelpEvent>
+#include <QStringList>
+#include <QToolTip>
+
+namespace {
+constexpr int kRowHeight = 8;
+constexpr int kRowGap = 3;
+constexpr int kPitch = kRowHeight + kRowGap;
+constexpr int kLabelGap = 6;
+constexpr int kPreferredStripWidth = 160;
+
+QString formatMhz(double mhz) {
+    return mhz >= 1000 ? QString("%1 GHz").arg(QString::number(mhz / 1000.0, 'f', 2))
+                       : QString("%1 MHz").arg(QString::number(mhz, 'f', 0));
+}
+}
+
+FreqResidencyStrip::FreqResidencyStrip(QWidget *parent) : QWidget(parent) {
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+    setFixedHeight(kRowHeight);
+
+    QFont small = font();
+    small.setPixelSize(9);
+    setFont(small);
+}
+
+QSize FreqResidencyStrip::sizeHint() const {
+    const int rows = qMax<int>(1, int(m_rows.size()));
+    return QSize(m_labelWidth + kPreferredStripWidth, rows * kPitch - kRowGap);
+}
+
+/** --- 資料 --- **/
+
+void FreqResidencyStrip::setSample(const FreqResidencySample &sample) {
+    const int count = sample.valid ? sample.policyCount : 0;
+    bool changed = count != int(m_rows.size());
+    if (changed) {
+        // policy 數量改變 (通常只在第一次取樣時發生)：重新計算版面
+        m_rows.assign(count, Row());
+        m_labelWidth = 0;
+        for (int i = 0; i < count; ++i) {
+            m_labelWidth = qMax(m_labelWidth, fontMetrics().horizontalAdvance("CPU " + sample.policies[i].cpus.toString()));
+        }
+        setFixedHeight(qMax(1, count) * kPitch - kRowGap);
+        updateGeometry();
+    }
+
+    for (int i = 0; i < count; ++i) {
+        const FreqPolicySample &policy = sample.policies[i];
+        Row &row = m_rows[i];
+        row.cpus = policy.cpus.toString();
+        row.avgMhz = policy.avgMhz;
+        if (row.stepCount != policy.stepCount) {
+            row.stepCount = policy.stepCount;
+            changed = true;
+        }
+        for (int step = 0; step < policy.stepCount; ++step) {
+            const quint16 permille = quint16(qBound(0, qRound(policy.residency[step] * 10.0f), 1000));
+            if (permille != row.permille[step] || policy.stepMhz[step] != row.mhz[step]) {
+                row.permille[step] = permille;
+                row.mhz[step] = policy.stepMhz[step];
+                changed = true;
+            }
+        }
+    }
+    if (changed) update();
+}
+
+/** --- 版面 --- **/
+
+QRect FreqResidencyStrip::rowRect(int index) const {
+    const int left = m_labelWidth + kLabelGap;
+    return QRect(left, index * kPitch, qMax(1, width() - left), kRowHeight);
+}
+
+int FreqResidencyStrip::rowAt(const QPoint &pos) const {
+    if (pos.y() < 0 || pos.y() % kPitch >= kRowHeight) return -1;
+    const int index = pos.y() / kPitch;
+    return index < int(m_rows.size()) ? index : -1;
+}
+
+QColor FreqResidencyStrip::colorFor(const Row &row, int step) const {
+    // 依該 policy 自己的頻率範圍上色：P/E 核心的最高頻都顯示為紅色
+    const float low = row.mhz[0];
+    const float high = row.mhz[row.stepCount - 1];
+    const qreal t = high > low ? qreal(row.mhz[step] - low) / qreal(high - low) : 1.0;
+    return QColor::fromHsvF((1.0 - t) * 210.0 / 360.0, 0.75, 0.45 + 0.5 * t, 0.85);
+}
+
+/** --- 繪製 --- **/
+
+void FreqResidencyStrip::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    if (m_rows.empty()) return;
+
+    QPainter painter(this);
+    for (int i = 0; i < int(m_rows.size()); ++i) {
+        const Row &row = m_rows[i];
+        const QRect strip = rowRect(i);
+
+        painter.setPen(QColor(255, 255, 255, 150));
+        painter.drawText(QRect(0, strip.top(), m_labelWidth, kRowHeight).adjusted(0, -2, 0, 2),
+                         Qt::AlignLeft | Qt::AlignVCenter, "CPU " + row.cpus);
+        painter.fillRect(strip, QColor(255, 255, 255, 25));
+
+        // 累計到千分比再換算像素，避免每段各自取整造成總長度偏差
+        int accumulated = 0;
+        int x = strip.left();
+        for (int step = 0; step < row.stepCount; ++step) {
+            if (row.permille[step] == 0) continue;
+            accumulated += row.permille[step];
+            const int end = strip.left() + strip.width() * qMin(accumulated, 1000) / 1000;
+            if (end > x) painter.fillRect(QRect(x, strip.top(), end - x, kRowHeight), colorFor(row, step));
+            x = end;
+        }
+    }
+}
+
+/** --- 滑鼠 --- **/
+
+bool FreqResidencyStrip::event(QEvent *event) {
+    if (event->type() != QEvent::ToolTip) return QWidget::event(event);
+
+    QHelpEvent *help = static_cast<QHelpEvent *>(event);
+    const int index = rowAt(help->pos());
+    if (index < 0) {
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+
+    const Row &row = m_rows[index];
+    QStringList lines;
+    lines << QString("CPU %1  avg %2").arg(row.cpus, formatMhz(row.avgMhz));
+    for (int step = row.stepCount - 1; step >= 0; --step) {
+        if (row.permille[step] < 5) continue; // 低於 0.5% 不列出
+        lines << QString("%1  %2%").arg(formatMhz(row.mhz[step]), QString::number(row.permille[step] / 10.0, 'f', 1));
+    }
+    QToolTip::showText(help->globalPos(), lines.join('\n'), this, QRect(0, index * kPitch, width(), kRowHeight));
+    return true;
+}
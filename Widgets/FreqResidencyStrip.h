@@ -0,0 +1,46 @@
+#ifndef FREQRESIDENCYSTRIP_H
+#define FREQRESIDENCYSTRIP_H
+
+#include <QWidget>
+#include <QColor>
+#include <vector>
+#include "Core/SystemSnapshot.h"
+
+/**
+ * @brief 頻率停留分佈長條 (可重複使用的自繪元件)
+ * 每個 cpufreq policy 一列：左側為 CPU 範圍，右側為依頻率由低到高堆疊的長條，
+ * 每段寬度為該頻率的停留比例，顏色由藍 (最低頻) 到紅 (最高頻，通常為 boost)。
+ * 各檔位的實際頻率與比例只在滑鼠停留時以提示顯示。
+ */
+class FreqResidencyStrip : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit FreqResidencyStrip(QWidget *parent = nullptr);
+
+    void setSample(const FreqResidencySample &sample);
+
+    QSize sizeHint() const override;
+
+protected:
+    bool event(QEvent *event) override; // 滑鼠停留時顯示該列的分佈
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    struct Row {
+        QString cpus;
+        int stepCount = 0;
+        float mhz[SnapshotLimits::kMaxFreqSteps] = {};
+        quint16 permille[SnapshotLimits::kMaxFreqSteps] = {}; // 量化後的比例，未改變時不重繪
+        float avgMhz = 0.0f;
+    };
+
+    QRect rowRect(int index) const;
+    int rowAt(const QPoint &pos) const;
+    QColor colorFor(const Row &row, int step) const;
+
+    std::vector<Row> m_rows;
+    int m_labelWidth = 0;
+};
+
+#endif // FREQRESIDENCYSTRIP_H
@@ -0,0 +1,166 @@
+#include "LatencyWidget.h"
+#include "Core/MetricHistory.h"
+#include <QStyle>
+#include <QHelpEvent>
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QToolTip>
+
+LatencyWidget::LatencyWidget(QWidget *parent) : BaseComponent(parent) {
+    m_titleLabel = new QLabel("WAKEUP LATENCY", this);
+    m_intervalLabel = new QLabel("p50 -- · p99 -- · max --", this);
+    m_totalLabel = new QLabel(this);
+    m_probeLabel = new QLabel(this);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setContentsMargins(15, 10, 15, 10);
+    mainLayout->setSpacing(2);
+    mainLayout->addWidget(m_titleLabel, 0, Qt::AlignLeft);
+    mainLayout->addWidget(m_intervalLabel, 0, Qt::AlignLeft);
+    mainLayout->addWidget(m_totalLabel, 0, Qt::AlignLeft);
+    mainLayout->addWidget(m_probeLabel, 0, Qt::AlignLeft);
+
+    // 滑鼠停留在區間數值上時顯示歷史統計
+    m_intervalLabel->installEventFilter(this);
+
+    // 探針執行緒自行計時，這裡只負責每秒取出直方圖與顯示
+    startSampling(1000);
+
+    initStyle();
+}
+
+void LatencyWidget::initStyle() {
+    BaseComponent::initStyle();
+
+    this->setStyleSheet(this->styleSheet() +
+                        "LatencyWidget {"
+                        "  background-color: rgba(0, 0, 0, 150);"
+                        "  border: 1px solid rgba(255, 255, 255, 30);"
+                        "  border-radius: 8px;"
+                        "}"
+                        "QLabel { color: white; background: transparent; font-family: 'Segoe UI', 'Microsoft JhengHei'; }"
+                        "#titleLabel { font-size: 14px; font-weight: bold; color: rgba(255, 255, 255, 220); margin-bottom: 2px; }"
+                        "#intervalLabel { font-size: 12px; color: rgba(255, 255, 255, 190); }"
+                        "#totalLabel, #probeLabel { font-size: 10px; color: rgba(255, 255, 255, 150); margin-left: 5px; }"
+                        );
+
+    m_titleLabel->setObjectName("titleLabel");
+    m_intervalLabel->setObjectName("intervalLabel");
+    m_totalLabel->setObjectName("totalLabel");
+    m_probeLabel->setObjectName("probeLabel");
+
+    this->style()->unpolish(this);
+    this->style()->polish(this);
+}
+
+void LatencyWidget::setCustomSetting(const QString &key, const QVariant &value) {
+    if (key == "probePeriodUs") {
+        const int periodUs = qBound(100, value.toInt(), 100000);
+        if (periodUs == m_periodUs) return;
+        m_periodUs = periodUs;
+        if (m_probe.isRunning()) restartProbe();
+    }
+}
+
+/** --- 探針啟停 --- **/
+
+void LatencyWidget::showEvent(QShowEvent *event) {
+    BaseComponent::showEvent(event);
+    if (!m_probe.isRunning()) restartProbe();
+}
+
+void LatencyWidget::hideEvent(QHideEvent *event) {
+    BaseComponent::hideEvent(event);
+    // 最小化等系統觸發的隱藏不停止量測，只有關閉小工具時才停止
+    if (!event->spontaneous()) m_probe.stop();
+}
+
+void LatencyWidget::restartProbe() {
+    m_probe.start(m_periodUs);
+    m_total.clear();
+    m_startedMs = snapshotClockMs();
+    m_intervalLabel->setText("p50 -- · p99 -- · max --");
+    m_totalLabel->clear();
+    m_probeLabel->clear();
+}
+
+/** --- 顯示 --- **/
+
+void LatencyWidget::updateData() {
+    if (!m_probe.isRunning()) return;
+
+    LatencyHistogram interval;
+    const qint64 now = snapshotClockMs();
+    if (m_probe.takeInterval(interval) > 0) {
+        m_total.merge(interval);
+
+        const qint64 p50 = interval.percentileNs(0.50);
+        const qint64 p99 = interval.percentileNs(0.99);
+        m_intervalLabel->setText(QString("p50 %1 · p99 %2 · max %3")
+                                     .arg(formatLatency(p50), formatLatency(p99), formatLatency(interval.maxNs)));
+
+        MetricHistory *history = MetricHistory::instance();
+        history->append(MetricHistory::seriesKey(MetricPoint::WakeupLatencyP50), now, p50 / 1000.0f);
+        history->append(MetricHistory::seriesKey(MetricPoint::WakeupLatencyP99), now, p99 / 1000.0f);
+        history->append(MetricHistory::seriesKey(MetricPoint::WakeupLatencyMax), now, interval.maxNs / 1000.0f);
+    } else {
+        // 週期比更新間隔長，或探針執行緒整個區間都沒被排到
+        m_intervalLabel->setText("p50 -- · p99 -- · max --");
+    }
+
+    const qint64 elapsedMs = qMax<qint64>(1, now - m_startedMs);
+    if (m_total.total > 0) {
+        m_totalLabel->setText(QString("Since start (%1 s): p99 %2 · max %3 · %4 wakeups")
+                                  .arg(elapsedMs / 1000)
+                                  .arg(formatLatency(m_total.percentileNs(0.99)), formatLatency(m_total.maxNs))
+                                  .arg(m_total.total));
+    }
+
+    QString probe = QString("Period %1 · overruns %2").arg(formatLatency(qint64(m_periodUs) * 1000)).arg(m_probe.overruns());
+    const qint64 cpuNs = m_probe.cpuNs();
+    if (cpuNs >= 0) probe += QString(" · probe CPU %1%").arg(QString::number(cpuNs / (elapsedMs * 1e6) * 100.0, 'f', 3));
+    m_probeLabel->setText(probe);
+}
+
+QString LatencyWidget::formatLatency(qint64 ns) {
+    if (ns < 0) return "--";
+    if (ns < 1000) return QString("%1 ns").arg(ns);
+    if (ns < 1000000) return QString::number(ns / 1e3, 'f', ns < 100000 ? 1 : 0) + " µs";
+    if (ns < 1000000000) return QString::number(ns / 1e6, 'f', ns < 100000000 ? 2 : 0) + " ms";
+    return QString::number(ns / 1e9, 'f', 2) + " s";
+}
+
+bool LatencyWidget::eventFilter(QObject *watched, QEvent *event) {
+    if (watched != m_intervalLabel || event->type() != QEvent::ToolTip) return BaseComponent::eventFilter(watched, event);
+    QToolTip::showText(static_cast<QHelpEvent *>(event)->globalPos(), historyTooltip(), m_intervalLabel);
+    return true;
+}
+
+QString LatencyWidget::historyTooltip() {
+    static const struct { qint64 spanMs; const char *label; } kWindows[] = {
+        {60 * 1000, "1 min"},
+        {10 * 60 * 1000, "10 min"},
+        {60 * 60 * 1000, "1 h"},
+        {24 * 60 * 60 * 1000, "24 h"},
+    };
+
+    MetricHistory *history = MetricHistory::instance();
+    const quint32 p99Key = MetricHistory::seriesKey(MetricPoint::WakeupLatencyP99);
+    const quint32 maxKey = MetricHistory::seriesKey(MetricPoint::WakeupLatencyMax);
+    const qint64 now = history->lastTimestamp(p99Key);
+    if (now < 0) return "Wakeup latency: no history";
+
+    // 序列以 µs 儲存；p99 取各區間的平均與最差值，max 取最差值
+    QStringList lines{"Wakeup latency"};
+    for (const auto &window : kWindows) {
+        HistoryPoint p99, worst;
+        if (!history->summarize(p99Key, now - window.spanMs, now, p99)) continue;
+        if (!history->summarize(maxKey, now - window.spanMs, now, worst)) continue;
+        lines << QString("%1: p99 avg %2 (worst %3), max %4")
+                     .arg(window.label)
+                     .arg(formatLatency(qint64(p99.avg * 1000.0f)))
+                     .arg(formatLatency(qint64(p99.max * 1000.0f)))
+                     .arg(formatLatency(qint64(worst.max * 1000.0f)));
+    }
+    return lines.join('\n');
+}
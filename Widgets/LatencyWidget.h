@@ -0,0 +1,47 @@
+#ifndef LATENCYWIDGET_H
+#define LATENCYWIDGET_H
+
+#include "Core/BaseComponent.h"
+#include "Core/WakeupProbe.h"
+#include <QLabel>
+#include <QVBoxLayout>
+
+/**
+ * @brief 排程喚醒延遲小工具
+ * 顯示 WakeupProbe 在每個更新區間量到的 p50 / p99 / max，以及啟動以來的累計；
+ * 每個區間的結果同時寫入 MetricHistory，滑鼠停留時顯示 1 分鐘 ~ 24 小時的統計。
+ * 探針只在小工具顯示時執行。
+ */
+class LatencyWidget : public BaseComponent {
+    Q_OBJECT
+public:
+    explicit LatencyWidget(QWidget *parent = nullptr);
+
+    void initStyle() override;
+    void updateData() override;
+    void setCustomSetting(const QString &key, const QVariant &value) override;
+
+    int probePeriodUs() const { return m_periodUs; }
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override; // 滑鼠停留時顯示歷史統計
+
+private:
+    QLabel *m_titleLabel;
+    QLabel *m_intervalLabel;  // 本區間 p50 / p99 / max
+    QLabel *m_totalLabel;     // 啟動以來累計
+    QLabel *m_probeLabel;     // 週期、錯過次數與探針本身的 CPU 用量
+
+    WakeupProbe m_probe;
+    LatencyHistogram m_total;
+    int m_periodUs = 10000;
+    qint64 m_startedMs = 0;
+
+    void restartProbe();
+    static QString formatLatency(qint64 ns);
+    static QString historyTooltip();
+};
+
+#endif // LATENCYWIDGET_H
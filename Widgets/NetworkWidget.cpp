@@ -1,4 +1,6 @@
 #include "NetworkWidget.h"
+#include "Core/SystemCollector.h"
+#include "Core/MetricHistory.h"
 #include <QDateTime>
 #include <QDebug>
 #include <QRegularExpression>
@@ -21,10 +23,9 @@ NetworkWidget::NetworkWidget(QWidget *parent) : BaseComponent(parent) {
     m_containerLayout->setSpacing(8);
     mainLayout->addWidget(m_container);
 
-    // 初始化定時器
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &NetworkWidget::updateData);
-    m_updateTimer->start(1000); // 預設每秒更新一次
+    // 取樣在收集執行緒進行，這裡只負責顯示
+    SystemCollector::instance()->setInterval(SystemCollector::Network, 1000);
+    startSampling(1000); // 預設每秒更新一次
 
     // Ping Initialization
     m_pingTarget = "8.8.8.8";
@@ -41,24 +42,16 @@ NetworkWidget::NetworkWidget(QWidget *parent) : BaseComponent(parent) {
 #endif
     connect(m_pingProcess, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, &NetworkWidget::handlePingOutput);
 
-    m_pingTimer = new QTimer(this);
-    connect(m_pingTimer, &QTimer::timeout, this, &NetworkWidget::startPing);
-    m_pingTimer->start(3000); // Ping every 3 seconds
+    // Ping every 3 seconds
+    m_pingTaskId = SampleScheduler::instance()->addTask(this, 3000, [this]() { startPing(); });
     startPing(); // Initial ping
 
     initStyle();
-
-#ifdef Q_OS_WIN
-    initPdh();
-#endif
 }
 
-NetworkWidget::~NetworkWidget() {
-#ifdef Q_OS_WIN
-    if (m_pdhQuery) {
-        PdhCloseQuery(m_pdhQuery);
-    }
-#endif
+void NetworkWidget::setUpdateInterval(int ms) {
+    BaseComponent::setUpdateInterval(ms);
+    SystemCollector::instance()->setInterval(SystemCollector::Network, ms);
 }
 
 void NetworkWidget::initStyle() {
@@ -84,7 +77,7 @@ void NetworkWidget::initStyle() {
 
 }
 
-void NetworkWidget::createInterfaceRow(const QString &name) {
+void NetworkWidget::createInterfaceRow(const QString &name, int slot) {
     if (m_uiRows.contains(name)) return;
 
     QWidget *rowWidget = new QWidget(m_container);
@@ -101,9 +94,29 @@ void NetworkWidget::createInterfaceRow(const QString &name) {
     QLabel *downLabel = new QLabel("↓ 0 B/s", rowWidget);
     downLabel->setObjectName("downLabel");
 
+    // 速度曲線：Total 使用合計序列，其餘使用該介面的槽位；縱軸依最近的峰值自動縮放
+    auto createGraph = [&](MetricPoint::Kind totalKind, MetricPoint::Kind ifaceKind, const QColor &color) {
+        SparklineGraph *graph = new SparklineGraph(rowWidget);
+        graph->setFixedHeight(20);
+        graph->setCapacity(300);
+        graph->setAutoScale(true);
+        graph->setColor(color);
+        if (name == "Total") {
+            graph->setSeries(MetricHistory::seriesKey(totalKind));
+        } else if (slot >= 0) {
+            graph->setSeries(MetricHistory::seriesKey(ifaceKind, static_cast<quint16>(slot)));
+        }
+        graph->setVisible(m_showGraph);
+        return graph;
+    };
+    SparklineGraph *upGraph = createGraph(MetricPoint::NetSentTotal, MetricPoint::NetSent, QColor("#4CAF50"));
+    SparklineGraph *downGraph = createGraph(MetricPoint::NetRecvTotal, MetricPoint::NetRecv, QColor("#2196F3"));
+
     rowLayout->addWidget(nameLabel);
     rowLayout->addWidget(upLabel);
+    rowLayout->addWidget(upGraph);
     rowLayout->addWidget(downLabel);
+    rowLayout->addWidget(downGraph);
 
     m_containerLayout->addWidget(rowWidget);
 
@@ -112,6 +125,8 @@ void NetworkWidget::createInterfaceRow(const QString &name) {
     ui.nameLabel = nameLabel;
     ui.uploadLabel = upLabel;
     ui.downloadLabel = downLabel;
+    ui.uploadGraph = upGraph;
+    ui.downloadGraph = downGraph;
     
     m_uiRows.insert(name, ui);
     this->adjustSize();
@@ -130,13 +145,6 @@ void NetworkWidget::removeInterfaceRow(const QString &name) {
     this->adjustSize();
 }
 
-void NetworkWidget::setUpdateInterval(int ms) {
-    BaseComponent::setUpdateInterval(ms);
-    if (m_updateTimer) {
-        m_updateTimer->setInterval(ms);
-    }
-}
-
 QString NetworkWidget::formatSpeed(double bytesPerSec) {
     double value = bytesPerSec;
     QString unit = "B/s";
@@ -183,9 +191,18 @@ void NetworkWidget::setCustomSetting(const QString &key, const QVariant &value)
             startPing();
         } else {
             m_pingLabel->hide();
-            // Optionally stop the timer or process if you want to save resources completely
-            // But keeping timer running is fine, just don't execute ping in startPing
         }
+        // 關閉時一併停用排程工作，不再為 Ping 喚醒
+        SampleScheduler::instance()->setActive(m_pingTaskId, m_showPing);
+        this->resize(this->minimumSizeHint());
+        this->adjustSize();
+    } else if (key == "showGraph") {
+        m_showGraph = value.toBool();
+        for (auto &ui : m_uiRows) {
+            ui.uploadGraph->setVisible(m_showGraph);
+            ui.downloadGraph->setVisible(m_showGraph);
+        }
+        updateData(); // 從歷史資料補齊隱藏期間的曲線
         this->resize(this->minimumSizeHint());
         this->adjustSize();
     }
@@ -195,97 +212,17 @@ QStringList NetworkWidget::getAvailableInterfaces() const {
     return m_interfaceList;
 }
 
-#ifdef Q_OS_WIN
-void NetworkWidget::initPdh() {
-    if (PdhOpenQuery(NULL, 0, &m_pdhQuery) != ERROR_SUCCESS) {
-        qWarning() << "Failed to open PDH query for NetworkWidget";
-        m_pdhQuery = NULL;
-        return;
-    }
-
-    // 嘗試加入英文計數器 (Vista+)
-    // Network Interface(*)\Bytes Sent/sec
-    PDH_STATUS status = PdhAddEnglishCounterW(m_pdhQuery, L"\\Network Interface(*)\\Bytes Sent/sec", 0, &m_pdhCounterSent);
-    if (status != ERROR_SUCCESS) {
-        qWarning() << "Failed to add English counter for Sent (Status:" << status << "). Trying index-based...";
-        // Fallback: 使用索引路徑 \510(*)\506 (Network Interface / Bytes Sent/sec)
-        if (PdhAddCounterW(m_pdhQuery, L"\\510(*)\\506", 0, &m_pdhCounterSent) != ERROR_SUCCESS) {
-            qWarning() << "Failed to add index counter for Sent.";
-        }
-    }
-
-    status = PdhAddEnglishCounterW(m_pdhQuery, L"\\Network Interface(*)\\Bytes Received/sec", 0, &m_pdhCounterReceived);
-    if (status != ERROR_SUCCESS) {
-        qWarning() << "Failed to add English counter for Received (Status:" << status << "). Trying index-based...";
-        // Fallback: 使用索引路徑 \510(*)\264 (Network Interface / Bytes Received/sec)
-        if (PdhAddCounterW(m_pdhQuery, L"\\510(*)\\264", 0, &m_pdhCounterReceived) != ERROR_SUCCESS) {
-            qWarning() << "Failed to add index counter for Received.";
-        }
-    }
-
-    // 第一次收集數據 (初始化)
-    PdhCollectQueryData(m_pdhQuery);
-    qDebug() << "NetworkWidget PDH initialized. Query:" << m_pdhQuery << "Sent:" << m_pdhCounterSent << "Recv:" << m_pdhCounterReceived;
-}
-#endif
-
 void NetworkWidget::updateData() {
-#ifdef Q_OS_WIN
-    if (!m_pdhQuery) {
-        initPdh();
-        if (!m_pdhQuery) return;
-    }
-
-    // 收集數據
-    PDH_STATUS collectStatus = PdhCollectQueryData(m_pdhQuery);
-    if (collectStatus != ERROR_SUCCESS) {
-        qWarning() << "PdhCollectQueryData failed:" << collectStatus;
-        return;
-    }
-
-    // Temporary storage for per-interface data
-    QMap<QString, double> sentMap;
-    QMap<QString, double> recvMap;
-    QStringList currentInterfaces;
-
-    auto processCounter = [&](PDH_HCOUNTER counter, QMap<QString, double> &dataMap, bool isSent) {
-        if (!counter) return;
-
-        DWORD bufferSize = 0;
-        DWORD itemCount = 0;
-        
-        PDH_STATUS status = PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE, &bufferSize, &itemCount, NULL);
-        
-        if (status == PDH_MORE_DATA || (status == ERROR_SUCCESS && bufferSize > 0)) {
-            QVector<char> buffer(bufferSize);
-            PPDH_FMT_COUNTERVALUE_ITEM_W items = (PPDH_FMT_COUNTERVALUE_ITEM_W)buffer.data();
-            
-            if (PdhGetFormattedCounterArrayW(counter, PDH_FMT_DOUBLE, &bufferSize, &itemCount, items) == ERROR_SUCCESS) {
-                for (DWORD i = 0; i < itemCount; i++) {
-                    QString name = QString::fromWCharArray(items[i].szName);
-                    double val = items[i].FmtValue.doubleValue;
-                    
-                    if (name.contains("Loopback", Qt::CaseInsensitive)) continue;
-
-                    if (isSent) currentInterfaces.append(name);
-
-                    if (items[i].FmtValue.CStatus == PDH_CSTATUS_VALID_DATA || 
-                        items[i].FmtValue.CStatus == PDH_CSTATUS_NEW_DATA) {
-                        dataMap[name] = val;
-                    }
-                }
-            }
-        }
-    };
+    const SystemSnapshot *snap = SystemCollector::instance()->snapshot();
+    if (!snap) return;
 
-    processCounter(m_pdhCounterSent, sentMap, true);
-    processCounter(m_pdhCounterReceived, recvMap, false);
-    
     // Update member list
-    if (!currentInterfaces.isEmpty()) {
-        m_interfaceList = currentInterfaces;
-        m_interfaceList.removeDuplicates();
+    QStringList currentInterfaces;
+    for (int slot = 0; slot < snap->interfaceSlots; ++slot) {
+        if (snap->interfaces[slot].present) currentInterfaces.append(snap->interfaces[slot].name.toString());
     }
+    if (currentInterfaces.isEmpty()) return;
+    m_interfaceList = currentInterfaces;
 
     // Determine what to show
     QStringList interfacesToShow = m_selectedInterfaces;
@@ -303,28 +240,33 @@ void NetworkWidget::updateData() {
 
     // Update or create rows
     for (const QString &target : interfacesToShow) {
-        if (!m_uiRows.contains(target)) {
-            createInterfaceRow(target);
-        }
-
         double sent = 0;
         double recv = 0;
+        int targetSlot = -1;
+
+        for (int slot = 0; slot < snap->interfaceSlots; ++slot) {
+            const NetworkSample &iface = snap->interfaces[slot];
+            if (!iface.present) continue;
+            // "Total" sums all valid interfaces
+            if (target == "Total" || iface.name.equals(target)) {
+                sent += iface.sentBytesPerSec;
+                recv += iface.recvBytesPerSec;
+                targetSlot = slot;
+            }
+        }
 
-        if (target == "Total") {
-            // Sum all valid interfaces
-            for (auto it = sentMap.begin(); it != sentMap.end(); ++it) sent += it.value();
-            for (auto it = recvMap.begin(); it != recvMap.end(); ++it) recv += it.value();
-        } else {
-            // Specific interface
-            sent = sentMap.value(target, 0);
-            recv = recvMap.value(target, 0);
+        if (!m_uiRows.contains(target)) {
+            createInterfaceRow(target, targetSlot);
         }
 
         NetworkInterfaceUI &ui = m_uiRows[target];
         ui.uploadLabel->setText(QString("↑ %1").arg(formatSpeed(sent)));
         ui.downloadLabel->setText(QString("↓ %1").arg(formatSpeed(recv)));
+        if (m_showGraph) {
+            ui.uploadGraph->sync();
+            ui.downloadGraph->sync();
+        }
     }
-#endif
 }
 
 void NetworkWidget::startPing() {
@@ -2,39 +2,35 @@
 #define NETWORKWIDGET_H
 
 #include "Core/BaseComponent.h"
+#include "SparklineGraph.h"
 #include <QLabel>
 #include <QVBoxLayout>
-#include <QTimer>
 #include <QMap>
 #include <QProcess>
 
-#ifdef Q_OS_WIN
-#include <pdh.h>
-#include <pdhmsg.h>
-#pragma comment(lib, "pdh.lib")
-#endif
-
 struct NetworkInterfaceUI {
     QWidget *rowWidget;
     QLabel *nameLabel;
     QLabel *uploadLabel;
     QLabel *downloadLabel;
+    SparklineGraph *uploadGraph;   // 上傳/下載速度曲線 (依設定顯示)
+    SparklineGraph *downloadGraph;
 };
 
 class NetworkWidget : public BaseComponent {
     Q_OBJECT
 public:
     explicit NetworkWidget(QWidget *parent = nullptr);
-    ~NetworkWidget();
 
     void initStyle() override;
     void updateData() override;
-    void setUpdateInterval(int ms) override;
+    void setUpdateInterval(int ms) override; // 同步收集執行緒的取樣週期
     void setCustomSetting(const QString &key, const QVariant &value) override;
 
     QStringList getAvailableInterfaces() const;
     bool isShowInBits() const { return m_showInBits; }
     bool isShowPing() const { return m_showPing; }
+    bool isShowGraph() const { return m_showGraph; }
     QStringList getSelectedInterfaces() const { return m_selectedInterfaces; }
     QString getPingTarget() const { return m_pingTarget; }
 
@@ -42,12 +38,11 @@ private:
     QLabel *m_titleLabel;
     QWidget *m_container;
     QVBoxLayout *m_containerLayout;
-    QTimer *m_updateTimer;
 
     // Ping feature
     QLabel *m_pingLabel;
     QProcess *m_pingProcess;
-    QTimer *m_pingTimer;
+    int m_pingTaskId = -1; // Ping 週期工作 (登記於 SampleScheduler)
     QString m_pingTarget;
     bool m_showPing = true;
     void startPing();
@@ -55,8 +50,9 @@ private:
     void updatePingDisplay(int latency, bool isOnline);
 
     bool m_showInBits = false;
+    bool m_showGraph = false;
     QStringList m_selectedInterfaces; // List of names to show.
-    QStringList m_interfaceList; // All available interfaces found by PDH
+    QStringList m_interfaceList; // All available interfaces found by the collector
 
     // Map interface name to its UI elements
     QMap<QString, NetworkInterfaceUI> m_uiRows;
@@ -65,15 +61,8 @@ private:
     QString formatSpeed(double bytesPerSec);
     
     // Helper to create a new row
-    void createInterfaceRow(const QString &name);
+    void createInterfaceRow(const QString &name, int slot);
     void removeInterfaceRow(const QString &name);
-
-#ifdef Q_OS_WIN
-    PDH_HQUERY m_pdhQuery = NULL;
-    PDH_HCOUNTER m_pdhCounterSent = NULL;
-    PDH_HCOUNTER m_pdhCounterReceived = NULL;
-    void initPdh();
-#endif
 };
 
 #endif // NETWORKWIDGET_H
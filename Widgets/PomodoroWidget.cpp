@@ -5,6 +5,7 @@ PomodoroWidget::PomodoroWidget(QWidget *parent) : BaseComponent(parent) {
     m_currentMode = Work;
     m_isRunning = false;
     m_remainingTime = m_workDuration * 60;
+    m_remainingMs = m_remainingTime * 1000LL;
 
     QVBoxLayout *mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(15, 10, 15, 10);
@@ -50,9 +51,9 @@ PomodoroWidget::PomodoroWidget(QWidget *parent) : BaseComponent(parent) {
 
     mainLayout->addLayout(btnLayout);
 
-    // Timer
-    m_timer = new QTimer(this);
-    connect(m_timer, &QTimer::timeout, this, &PomodoroWidget::updateData);
+    // Timer：與其他小工具共用排程器的喚醒，只在計時中啟用
+    m_tickTaskId = SampleScheduler::instance()->addTask(this, 1000, [this]() { updateData(); });
+    SampleScheduler::instance()->setActive(m_tickTaskId, false);
 
     initStyle();
 }
@@ -86,39 +87,51 @@ void PomodoroWidget::initStyle() {
 }
 
 void PomodoroWidget::updateData() {
-    if (m_isRunning && m_remainingTime > 0) {
-        m_remainingTime--;
-        updateDisplay();
-        
-        if (m_remainingTime == 0) {
-            m_isRunning = false;
-            m_timer->stop();
-            m_toggleButton->setText("Start");
-            // Could play a sound here or flash window
-            m_statusLabel->setText("Time's Up!");
-        }
+    if (!m_isRunning) return;
+
+    // 依實際經過時間推算：排程器合併喚醒時，兩次執行的間隔不一定剛好 1 秒
+    const qint64 remainingMs = elapsedRemainingMs();
+    m_remainingTime = int((remainingMs + 999) / 1000);
+    updateDisplay();
+
+    if (remainingMs == 0) {
+        setRunning(false);
+        m_toggleButton->setText("Start");
+        // Could play a sound here or flash window
+        m_statusLabel->setText("Time's Up!");
     }
 }
 
+qint64 PomodoroWidget::elapsedRemainingMs() const {
+    return qMax<qint64>(0, m_remainingMs - m_runClock.elapsed());
+}
+
+void PomodoroWidget::setRunning(bool running) {
+    if (m_isRunning && !running) {
+        m_remainingMs = elapsedRemainingMs(); // 暫停時保留不足一秒的部分
+    }
+    m_isRunning = running;
+    if (running) m_runClock.start();
+    SampleScheduler::instance()->setActive(m_tickTaskId, running);
+}
+
 void PomodoroWidget::toggleTimer() {
     if (m_isRunning) {
-        m_isRunning = false;
-        m_timer->stop();
+        setRunning(false);
         m_toggleButton->setText("Resume");
     } else {
         if (m_remainingTime == 0) {
             resetTimer(); // Auto reset if starting from 0
         }
-        m_isRunning = true;
-        m_timer->start(1000);
+        setRunning(true);
         m_toggleButton->setText("Pause");
     }
 }
 
 void PomodoroWidget::resetTimer() {
-    m_isRunning = false;
-    m_timer->stop();
+    setRunning(false);
     m_remainingTime = getCurrentDuration() * 60;
+    m_remainingMs = m_remainingTime * 1000LL;
     m_toggleButton->setText("Start");
     updateDisplay();
     updateStatusText();
@@ -4,7 +4,7 @@
 #include "../Core/BaseComponent.h"
 #include <QLabel>
 #include <QPushButton>
-#include <QTimer>
+#include <QElapsedTimer>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 
@@ -36,7 +36,8 @@ private:
     };
 
     TimerMode m_currentMode;
-    int m_remainingTime; // in seconds
+    int m_remainingTime; // in seconds (顯示用，計時中由 m_remainingMs 與 m_runClock 推算)
+    qint64 m_remainingMs; // 開始 (或繼續) 計時當下的剩餘毫秒
     bool m_isRunning;
 
     // Settings (in minutes)
@@ -52,8 +53,12 @@ private:
     QPushButton *m_resetButton;
     QPushButton *m_modeButton;
 
-    QTimer *m_timer;
+    // 計時中每秒更新一次 (登記於 SampleScheduler，不受全域更新頻率影響)
+    int m_tickTaskId = -1;
+    QElapsedTimer m_runClock;
 
+    qint64 elapsedRemainingMs() const;
+    void setRunning(bool running);
     void updateDisplay();
     void updateStatusText();
     int getCurrentDuration() const;
@@ -0,0 +1,257 @@
+#include "SparklineGraph.h"
+#include "Core/MetricHistory.h"
+#include "Core/MinMaxDecimator.h"
+#include <QPainter>
+#include <QResizeEvent>
+
+SparklineGraph::SparklineGraph(QWidget *parent) : QWidget(parent) {
+    setMinimumHeight(16);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+QSize SparklineGraph::sizeHint() const {
+    return QSize(150, 30);
+}
+
+/** --- 設定 --- **/
+
+void SparklineGraph::setCapacity(int samples) {
+    m_capacity = qMax(2, samples);
+    m_cacheDirty = true;
+    update();
+}
+
+void SparklineGraph::setRange(float min, float max) {
+    m_rangeMin = min;
+    m_rangeMax = qMax(max, min + 1e-6f);
+    m_autoScale = false;
+    m_cacheDirty = true;
+    update();
+}
+
+void SparklineGraph::setAutoScale(bool enabled) {
+    m_autoScale = enabled;
+    m_cacheDirty = true;
+    update();
+}
+
+void SparklineGraph::setColor(const QColor &color) {
+    m_color = color;
+    m_cacheDirty = true;
+    update();
+}
+
+void SparklineGraph::setSeries(quint32 seriesKey) {
+    m_seriesKey = seriesKey;
+    m_hasSeries = true;
+    m_lastSyncedMs = -1;
+    clear();
+}
+
+/** --- 資料 --- **/
+
+void SparklineGraph::sync() {
+    if (!m_hasSeries) return;
+
+    MetricHistory *history = MetricHistory::instance();
+    history->ingest();
+    const qint64 last = history->lastTimestamp(m_seriesKey);
+    if (last < 0) return;
+
+    // 第一次同步或隱藏太久：整個視窗重新載入
+    const qint64 window = m_capacity * 1000LL;
+    qint64 from = m_lastSyncedMs;
+    if (m_lastSyncedMs < 0 || m_lastSyncedMs < last - window) {
+        clear();
+        from = last - window;
+    }
+
+    // 從上次的時間桶開始查詢：同一秒內若有多筆取樣，最後一個時間桶的平均值可能已改變
+    const QVector<HistoryPoint> points = history->query(m_seriesKey, from, last);
+    for (const HistoryPoint &point : points) {
+        if (point.timestampMs < m_lastSyncedMs) continue;
+        if (point.timestampMs == m_lastSyncedMs) {
+            updateLastSample(point.avg);
+        } else {
+            appendSample(point.avg);
+        }
+        m_lastSyncedMs = point.timestampMs;
+    }
+}
+
+void SparklineGraph::appendSample(float value) {
+    m_samples.push_back(value);
+    ++m_total;
+
+    // 超過兩倍所需時才整批捨棄舊資料，攤提後每筆 O(1)
+    const size_t keep = static_cast<size_t>(m_capacity + m_samplesPerColumn);
+    if (m_samples.size() > keep * 2) {
+        m_samples.erase(m_samples.begin(), m_samples.end() - static_cast<std::ptrdiff_t>(keep));
+    }
+
+    if (m_autoScale && value > m_rangeMax) m_cacheDirty = true;
+    if (m_cacheDirty || !isVisible()) {
+        m_cacheDirty = true;
+        update();
+        return;
+    }
+
+    // 新的一欄開始：快取左移一欄
+    const bool scrolled = m_total > 1 && (m_total - 1) % m_samplesPerColumn == 0;
+    if (scrolled && m_autoScale && ++m_columnsSinceRebuild >= m_columns) {
+        // 自動縮放時，整個視窗捲過一輪後重畫一次，讓縱軸能隨舊的高峰離開而縮小
+        m_cacheDirty = true;
+        update();
+        return;
+    }
+    redrawCurrentColumn(scrolled);
+}
+
+void SparklineGraph::updateLastSample(float value) {
+    if (m_samples.empty()) {
+        appendSample(value);
+        return;
+    }
+    m_samples.back() = value;
+
+    if (m_autoScale && value > m_rangeMax) m_cacheDirty = true;
+    if (m_cacheDirty || !isVisible()) {
+        m_cacheDirty = true;
+        update();
+        return;
+    }
+    redrawCurrentColumn(false);
+}
+
+void SparklineGraph::clear() {
+    m_samples.clear();
+    m_total = 0;
+    m_cacheDirty = true;
+    update();
+}
+
+/** --- 繪製 --- **/
+
+void SparklineGraph::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    m_cacheDirty = true;
+}
+
+void SparklineGraph::paintEvent(QPaintEvent *event) {
+    Q_UNUSED(event);
+    if (m_cacheDirty || m_cache.isNull()) {
+        rebuildCache();
+    }
+    QPainter painter(this);
+    painter.drawPixmap(rect(), m_cache);
+}
+
+void SparklineGraph::layoutColumns() {
+    const qreal dpr = devicePixelRatioF();
+    const int pixelWidth = qMax(1, qRound(width() * dpr));
+
+    // 取樣比像素少時每筆佔多個像素；否則每欄涵蓋多筆取樣
+    m_columnWidth = qMax(1, pixelWidth / m_capacity);
+    m_columns = qMax(1, pixelWidth / m_columnWidth);
+    m_samplesPerColumn = (m_capacity + m_columns - 1) / m_columns;
+}
+
+bool SparklineGraph::columnRange(qint64 column, const float *&values, int &count) const {
+    const qint64 bufferStart = m_total - static_cast<qint64>(m_samples.size());
+    const qint64 begin = qMax(column * m_samplesPerColumn, bufferStart);
+    const qint64 end = qMin((column + 1) * m_samplesPerColumn, m_total);
+    if (end <= begin) return false;
+
+    values = m_samples.data() + (begin - bufferStart);
+    count = static_cast<int>(end - begin);
+    return true;
+}
+
+float SparklineGraph::yFor(float value) const {
+    const int bottom = m_cache.height() - 1;
+    const float t = qBound(0.0f, (value - m_rangeMin) / (m_rangeMax - m_rangeMin), 1.0f);
+    return bottom - t * bottom;
+}
+
+void SparklineGraph::rebuildCache() {
+    layoutColumns();
+
+    const qreal dpr = devicePixelRatioF();
+    m_cache = QPixmap(qMax(1, qRound(width() * dpr)), qMax(1, qRound(height() * dpr)));
+    m_cache.fill(Qt::transparent);
+    m_cacheDirty = false;
+    m_columnsSinceRebuild = 0;
+    if (m_total == 0) return;
+
+    const qint64 current = (m_total - 1) / m_samplesPerColumn;
+    const qint64 first = qMax<qint64>(0, current - m_columns + 1);
+
+    if (m_autoScale) {
+        float peak = 0.0f;
+        for (qint64 column = first; column <= current; ++column) {
+            const float *values;
+            int count;
+            if (!columnRange(column, values, count)) continue;
+            float lo, hi;
+            MinMaxDecimator::minMax(values, count, lo, hi);
+            peak = qMax(peak, hi);
+        }
+        m_rangeMax = qMax(m_rangeMin + 1.0f, peak * 1.1f);
+    }
+
+    QPainter painter(&m_cache);
+    for (qint64 column = first; column <= current; ++column) {
+        drawColumn(painter, column);
+    }
+}
+
+void SparklineGraph::redrawCurrentColumn(bool scrolled) {
+    if (m_cache.isNull()) {
+        update();
+        return;
+    }
+
+    if (scrolled) {
+        m_cache.scroll(-m_columnWidth, 0, m_cache.rect());
+    }
+
+    const QRect columnRect(m_cache.width() - m_columnWidth, 0, m_columnWidth, m_cache.height());
+    QPainter painter(&m_cache);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    painter.fillRect(columnRect, Qt::transparent);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    drawColumn(painter, (m_total - 1) / m_samplesPerColumn);
+    painter.end();
+
+    update();
+}
+
+void SparklineGraph::drawColumn(QPainter &painter, qint64 column) {
+    const float *values;
+    int count;
+    if (!columnRange(column, values, count)) return;
+
+    float lo, hi;
+    MinMaxDecimator::minMax(values, count, lo, hi);
+    const float last = values[count - 1];
+
+    // 前一欄的最後一筆，用來畫出兩欄之間的轉折
+    float previous = values[0];
+    const float *prevValues;
+    int prevCount;
+    if (columnRange(column - 1, prevValues, prevCount)) previous = prevValues[prevCount - 1];
+
+    const qint64 current = (m_total - 1) / m_samplesPerColumn;
+    const int x = m_cache.width() - static_cast<int>(current - column + 1) * m_columnWidth;
+
+    // min~max 色帶
+    QColor band = m_color;
+    band.setAlpha(70);
+    const int top = qRound(yFor(hi));
+    const int bottom = qRound(yFor(lo));
+    painter.fillRect(QRect(x, top, m_columnWidth, bottom - top + 1), band);
+
+    // 折線只畫在本欄範圍內，重畫單欄時不會殘留到相鄰欄
+    painter.setPen(QPen(m_color, 1));
+    painter.drawLine(QPointF(x, yFor(previous)), QPointF(x + m_columnWidth - 1, yFor(last)));
+}
@@ -0,0 +1,81 @@
+#ifndef SPARKLINEGRAPH_H
+#define SPARKLINEGRAPH_H
+
+#include <QWidget>
+#include <QPixmap>
+#include <QColor>
+#include <vector>
+
+/**
+ * @brief 小型歷史曲線圖 (可重複使用的自繪元件)
+ * 每個像素欄只畫一條 min~max 色帶與一段連到該欄最後一筆的折線，
+ * 取樣數再多，繪製成本也只與寬度有關。
+ *
+ * 繪製結果快取在 QPixmap 中：新增取樣時只重畫最右側一欄，
+ * 進入新的一欄時先將快取左移一欄；縮放或縱軸範圍改變時才整張重畫。
+ */
+class SparklineGraph : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit SparklineGraph(QWidget *parent = nullptr);
+
+    /** @brief 視窗內保留的取樣數 */
+    void setCapacity(int samples);
+    /** @brief 固定縱軸範圍 (例如使用率 0~100) */
+    void setRange(float min, float max);
+    /** @brief 縱軸上限依視窗內的最大值自動調整 (例如網路速度) */
+    void setAutoScale(bool enabled);
+    void setColor(const QColor &color);
+
+    /**
+     * @brief 綁定 MetricHistory 的序列，之後呼叫 sync() 即可補上新資料
+     * 以 1 秒層級的平均值作為取樣；隱藏期間不需同步，重新顯示時自動補齊
+     */
+    void setSeries(quint32 seriesKey);
+    void sync();
+
+    void appendSample(float value);
+    void clear();
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    void updateLastSample(float value);
+    void layoutColumns();
+    void rebuildCache();
+    void redrawCurrentColumn(bool scrolled);
+    void drawColumn(QPainter &painter, qint64 column);
+    bool columnRange(qint64 column, const float *&values, int &count) const;
+    float yFor(float value) const;
+
+    // 取樣 (只保留視窗所需，舊資料整批捨棄)
+    std::vector<float> m_samples;
+    qint64 m_total = 0;          // 累計取樣數，用來對齊像素欄
+    int m_capacity = 300;
+
+    // 外觀
+    float m_rangeMin = 0.0f;
+    float m_rangeMax = 100.0f;
+    bool m_autoScale = false;
+    QColor m_color = QColor(120, 200, 255);
+
+    // 快取 (以裝置像素為單位，避免高 DPI 下捲動出現半像素)
+    QPixmap m_cache;
+    bool m_cacheDirty = true;
+    int m_columnWidth = 1;
+    int m_columns = 0;
+    int m_samplesPerColumn = 1;
+    int m_columnsSinceRebuild = 0;
+
+    // MetricHistory 同步狀態
+    quint32 m_seriesKey = 0;
+    bool m_hasSeries = false;
+    qint64 m_lastSyncedMs = -1;  // 最後一個已取得的 1 秒時間桶
+};
+
+#endif // SPARKLINEGRAPH_H
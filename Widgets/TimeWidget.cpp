@@ -23,21 +23,13 @@ TimeWidget::TimeWidget(QWidget *parent) : BaseComponent(parent) {
 
     mainLayout->addLayout(infoLayout);
 
-    // 定時器
-    m_updateTimer = new QTimer(this);
-    connect(m_updateTimer, &QTimer::timeout, this, &TimeWidget::updateData);
+    // 向全域排程器登記，實際觸發時間由 updateData 對齊到整分
+    startSampling(1000);
 
     initStyle();
     updateData();
 }
 
-void TimeWidget::setUpdateInterval(int ms) {
-    BaseComponent::setUpdateInterval(ms);
-    if (m_updateTimer) {
-        m_updateTimer->setInterval(ms);
-    }
-}
-
 void TimeWidget::initStyle() {
     BaseComponent::initStyle(); // 繼承半透明圓角背景
 
@@ -73,5 +65,5 @@ void TimeWidget::updateData() {
 
     // 計算到下一分鐘的秒數進行更新
     int msecToNextMinute = (60 - now.time().second()) * 1000;
-    m_updateTimer->start(msecToNextMinute);
+    SampleScheduler::instance()->rescheduleIn(m_sampleTaskId, msecToNextMinute);
 }
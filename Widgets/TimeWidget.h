@@ -3,7 +3,6 @@
 
 #include "Core/BaseComponent.h"
 #include <QLabel>
-#include <QTimer>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 
@@ -14,13 +13,11 @@ public:
 
     void initStyle() override;
     void updateData() override;
-    void setUpdateInterval(int ms) override; // 新增
 
 private:
     QLabel *m_timeLabel;
     QLabel *m_dayLabel;   // 顯示星期 (Thursday)
     QLabel *m_dateLabel;  // 顯示日期 (11.09.2025)
-    QTimer *m_updateTimer;
 };
 
 #endif // TIMEWIDGET_H